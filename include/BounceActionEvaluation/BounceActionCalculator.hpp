@@ -34,6 +34,13 @@ namespace VevaciousPlusPlus
                              PotentialMinimum const& trueVacuum,
                              double const tunnelingTemperature ) {}
 
+    // This should tell the BounceActionCalculator the bounce action which
+    // decides the outcome of the tunneling calculation for the vacua given to
+    // the last call of ResetVacua, so that it can save time on bounce actions
+    // which are clearly far from it, giving bounds on them through the
+    // returned BubbleProfile. By default it does nothing.
+    virtual void SetActionThreshold( double const actionThreshold ) {}
+
     // This should calculate the bubble profile and bounce action along the
     // path given by tunnelPath and return them in a new BubbleProfile object,
     // which must have its memory managed by the calling code (ideally a
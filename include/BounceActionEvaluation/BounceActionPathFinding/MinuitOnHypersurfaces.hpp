@@ -16,6 +16,7 @@
 #include "MinuitWrappersAndHelpers/MinuitHypersphereBoundAlternative.hpp"
 #include <cstddef>
 #include <cmath>
+#include <stdexcept>
 #include "Minuit2/MnMigrad.h"
 #include "Minuit2/FunctionMinimum.h"
 #include "Minuit2/MnUserParameters.h"
@@ -55,6 +56,15 @@ namespace VevaciousPlusPlus
     virtual double
     operator()( std::vector< double > const& nodeParameterization ) const;
 
+    // This implements Gradient for ROOT::Minuit2::FCNGradientBase, returning
+    // the exact gradient of operator() with respect to nodeParameterization:
+    // the gradient of the potential (corrected for the capping of the field
+    // configuration by PotentialValue) in field space, projected onto the
+    // hyperplane by hyperplaneBasis, plus the gradient of the penalty. It
+    // should only be used if exactGradientAvailable is true.
+    virtual std::vector< double >
+    Gradient( std::vector< double > const& nodeParameterization ) const;
+
     // This sets the potential function and vacua to be those given (also
     // noting the maximum allowed scale as the maximum Euclidean length for
     // field configurations, and also the number of fields which vary for the
@@ -88,6 +98,15 @@ namespace VevaciousPlusPlus
     // parameterization. It has to be set by TryToImprovePath before operator()
     // is called (unless operator() has been over-ridden appropriately).
     Eigen::MatrixXd reflectionMatrix;
+    // This is reflectionMatrix without its first column, so that it maps
+    // nodeParameterization directly to field space without the zero first
+    // element of the untransformed node, and its transpose projects
+    // field-space gradients onto the parameterization hyperplane.
+    Eigen::MatrixXd hyperplaneBasis;
+    // This is true if potentialFunction can provide its gradient exactly, in
+    // which case Minuit is given Gradient rather than having to evaluate the
+    // potential at extra points to estimate the gradient.
+    bool exactGradientAvailable;
     std::vector< double > minuitInitialSteps;
     std::vector< double > nodeZeroParameterization;
     Eigen::VectorXd minuitResultAsUntransformedVector;
@@ -103,9 +122,21 @@ namespace VevaciousPlusPlus
     // maximumFieldVectorLengthSquared.
     double PotentialValue( std::vector< double > fieldConfiguration ) const;
 
+    // This returns the gradient of PotentialValue in field space at
+    // fieldConfiguration, accounting for the scaling of a field configuration
+    // beyond the cap and for the penalty for being beyond it.
+    Eigen::VectorXd
+    PotentialValueGradient( std::vector< double > fieldConfiguration ) const;
+
+    // This puts reflectionMatrix times the untransformed node from
+    // nodeParameterization into transformedNode, and returns its Euclidean
+    // length squared.
+    double TransformedNode( std::vector< double > const& nodeParameterization,
+                            Eigen::VectorXd& transformedNode ) const;
+
     // This sets up reflectionMatrix to be the Householder reflection matrix
     // which reflects the axis of field 0 to be parallel to
-    // currentParallelComponent.
+    // currentParallelComponent, and hyperplaneBasis to match it.
     void SetUpHouseholderReflection();
 
     // This takes the numberOfFields-1-dimensional vector and prepends a 0 to
@@ -143,6 +174,13 @@ namespace VevaciousPlusPlus
     // times the Euclidean length of currentParallelComponent.
     virtual void SetCurrentMinuitSteps( double const fractionOfLength );
 
+    // This creates and runs a Minuit2 MnMigrad object starting from
+    // nodeZeroParameterization and returns its result. Minuit only uses
+    // Gradient if it is given this object as an FCNGradientBase, so if the
+    // potential cannot provide its gradient exactly, it is given this object
+    // as just an FCNBase.
+    ROOT::Minuit2::FunctionMinimum RunMigradOnNode();
+
     // This creates and runs a Minuit2 MnMigrad object and converts the result
     // into a node vector transformed by reflectionMatrix and puts that into
     // displacementVector.
@@ -203,23 +241,61 @@ namespace VevaciousPlusPlus
   inline double MinuitOnHypersurfaces::operator()(
                       std::vector< double > const& nodeParameterization ) const
   {
-    Eigen::VectorXd const transformedNode( reflectionMatrix
-                                 * UntransformedNode( nodeParameterization ) );
+    Eigen::VectorXd transformedNode;
+    double const
+    parameterizationLengthSquared( TransformedNode( nodeParameterization,
+                                                    transformedNode ) );
     std::vector< double > fieldConfiguration( numberOfFields );
-    double parameterizationLengthSquared( 0.0 );
     for( size_t fieldIndex( 0 );
          fieldIndex < numberOfFields;
          ++fieldIndex )
     {
       fieldConfiguration[ fieldIndex ] = ( transformedNode( fieldIndex )
                                      + currentHyperplaneOrigin( fieldIndex ) );
-      parameterizationLengthSquared
-      += ( transformedNode( fieldIndex ) * transformedNode( fieldIndex ) );
     }
     return ( ( parameterizationLengthSquared * parameterizationLengthSquared )
              + PotentialValue( fieldConfiguration ) );
   }
 
+  // This implements Gradient for ROOT::Minuit2::FCNGradientBase, returning the
+  // exact gradient of operator() with respect to nodeParameterization: the
+  // gradient of the potential (corrected for the capping of the field
+  // configuration by PotentialValue) in field space, projected onto the
+  // hyperplane by hyperplaneBasis, plus the gradient of the penalty. It should
+  // only be used if exactGradientAvailable is true.
+  inline std::vector< double > MinuitOnHypersurfaces::Gradient(
+                      std::vector< double > const& nodeParameterization ) const
+  {
+    Eigen::VectorXd transformedNode;
+    double const
+    parameterizationLengthSquared( TransformedNode( nodeParameterization,
+                                                    transformedNode ) );
+    std::vector< double > fieldConfiguration( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      fieldConfiguration[ fieldIndex ] = ( transformedNode( fieldIndex )
+                                     + currentHyperplaneOrigin( fieldIndex ) );
+    }
+    // The reflection preserves lengths, so the penalty is the fourth power of
+    // the length of nodeParameterization itself.
+    double const penaltyFactor( 4.0 * parameterizationLengthSquared );
+    Eigen::VectorXd const
+    projectedGradient( hyperplaneBasis.transpose()
+                       * PotentialValueGradient( fieldConfiguration ) );
+    std::vector< double > gradientVector( nodeParameterization.size() );
+    for( size_t variableIndex( 0 );
+         variableIndex < gradientVector.size();
+         ++variableIndex )
+    {
+      gradientVector[ variableIndex ]
+      = ( projectedGradient( variableIndex )
+          + ( penaltyFactor * nodeParameterization[ variableIndex ] ) );
+    }
+    return gradientVector;
+  }
+
   // This caps the field configuration so that the square of its Euclidean
   // length is not longer than maximumFieldVectorLengthSquared, then
   // evaluates the difference between potentialFunction->operator() on the
@@ -241,6 +317,69 @@ namespace VevaciousPlusPlus
              - potentialAtOrigin );
   }
 
+  // This returns the gradient of PotentialValue in field space at
+  // fieldConfiguration, accounting for the scaling of a field configuration
+  // beyond the cap and for the penalty for being beyond it.
+  inline Eigen::VectorXd MinuitOnHypersurfaces::PotentialValueGradient(
+                               std::vector< double > fieldConfiguration ) const
+  {
+    Eigen::VectorXd const uncappedConfiguration( Eigen::Map< Eigen::VectorXd >(
+                                                    fieldConfiguration.data(),
+                                                   numberOfFields ) );
+    double const squaredLengthBeyondCap(
+                          MinuitHypersphereBoundAlternative::CapVariableVector(
+                                                            fieldConfiguration,
+                                           maximumFieldVectorLengthSquared ) );
+    std::vector< double > gradientVector;
+    if( !(potentialFunction->SetAsExactGradientAt( gradientVector,
+                                                   fieldConfiguration,
+                                                   pathTemperature )) )
+    {
+      throw std::runtime_error( "MinuitOnHypersurfaces::Gradient(..) was"
+                       " called for a potential without an exact gradient." );
+    }
+    Eigen::VectorXd fieldGradient( Eigen::Map< Eigen::VectorXd >(
+                                                        gradientVector.data(),
+                                                         numberOfFields ) );
+    if( squaredLengthBeyondCap > 0.0 )
+    {
+      // The capped configuration is the uncapped configuration scaled to have
+      // length sqrt( maximumFieldVectorLengthSquared ), so only the part of
+      // the gradient perpendicular to the configuration survives, scaled down
+      // by the same factor. The penalty ( length^2 - cap^2 )^2 then
+      // contributes 4 ( length^2 - cap^2 ) times the uncapped configuration.
+      double const uncappedLengthSquared( squaredLengthBeyondCap
+                                          + maximumFieldVectorLengthSquared );
+      double const scaleFactor( sqrt( maximumFieldVectorLengthSquared
+                                      / uncappedLengthSquared ) );
+      fieldGradient
+      = ( ( scaleFactor * ( fieldGradient
+                            - ( ( uncappedConfiguration.dot( fieldGradient )
+                                  / uncappedLengthSquared )
+                                * uncappedConfiguration ) ) )
+          + ( ( 4.0 * squaredLengthBeyondCap ) * uncappedConfiguration ) );
+    }
+    return fieldGradient;
+  }
+
+  // This puts reflectionMatrix times the untransformed node from
+  // nodeParameterization into transformedNode, and returns its Euclidean
+  // length squared.
+  inline double MinuitOnHypersurfaces::TransformedNode(
+                          std::vector< double > const& nodeParameterization,
+                                       Eigen::VectorXd& transformedNode ) const
+  {
+    // The untransformed node always has 0 for its first element, so
+    // hyperplaneBasis skips the first column of reflectionMatrix, and since
+    // the reflection preserves lengths, the length squared is that of
+    // nodeParameterization itself.
+    Eigen::Map< Eigen::VectorXd const >
+    parameterizationVector( nodeParameterization.data(),
+                            nodeParameterization.size() );
+    transformedNode.noalias() = ( hyperplaneBasis * parameterizationVector );
+    return parameterizationVector.squaredNorm();
+  }
+
   // This takes the numberOfFields-1-dimensional vector and prepends a 0 to
   // make an numberOfFields-dimensional Eigen::VectorXd.
   inline Eigen::VectorXd MinuitOnHypersurfaces::UntransformedNode(
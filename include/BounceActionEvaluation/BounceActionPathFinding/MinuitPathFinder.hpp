@@ -10,20 +10,22 @@
 
 #include "BounceActionEvaluation/BouncePathFinder.hpp"
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/FCNGradientBase.h"
 #include <vector>
 #include <limits>
+#include <stdexcept>
 
 namespace VevaciousPlusPlus
 {
 
   class MinuitPathFinder : public BouncePathFinder,
-                           public ROOT::Minuit2::FCNBase
+                           public ROOT::Minuit2::FCNGradientBase
   {
   public:
     MinuitPathFinder( unsigned int const minuitStrategy = 1,
                       double const minuitToleranceFraction = 0.5 ) :
       BouncePathFinder(),
-      ROOT::Minuit2::FCNBase(),
+      ROOT::Minuit2::FCNGradientBase(),
       minuitStrategy( minuitStrategy ),
       minuitToleranceFraction( minuitToleranceFraction ),
       currentMinuitTolerance( -1.0 ) {}
@@ -34,12 +36,25 @@ namespace VevaciousPlusPlus
     // This class implements Up() inherited from ROOT::Minuit2::FCNBase, and
     // its derived classes should implement operator(). There is no deadly
     // diamond of doom because BouncePathFinder does not have an operator() or
-    // Up() at all.
+    // Up() at all. Derived classes which can differentiate their operator()
+    // exactly may also over-ride Gradient and pass themselves to
+    // ROOT::Minuit2::MnMigrad as an FCNGradientBase, otherwise they should be
+    // passed as an FCNBase so that Minuit works out the gradient itself.
 
     // This implements Up() for ROOT::Minuit2::FCNBase just to stick to a basic
     // value.
     virtual double Up() const { return 1.0; }
 
+    // This implements Gradient for ROOT::Minuit2::FCNGradientBase by throwing
+    // an exception, as by default there is no exact gradient.
+    virtual std::vector< double >
+    Gradient( std::vector< double > const& minuitParameterization ) const
+    { throw std::runtime_error( "MinuitPathFinder::Gradient(..) was called"
+                             " for a function without an exact gradient." ); }
+
+    // Minuit should not second-guess the gradient if it is given one.
+    virtual bool CheckGradient() const { return false; }
+
 
   protected:
     static double FunctionValueForNanInput()
@@ -17,7 +17,8 @@ namespace VevaciousPlusPlus
   class BubbleProfile
   {
   public:
-    BubbleProfile() : bounceAction( -1.0 ) {}
+    BubbleProfile() : bounceAction( -1.0 ),
+                      bounceActionUncertainty( 0.0 ) {}
 
     virtual ~BubbleProfile() {}
 
@@ -27,6 +28,16 @@ namespace VevaciousPlusPlus
     double BounceAction() const { return bounceAction; }
     double& BounceAction() { return bounceAction; }
 
+    // If the bounce action was only calculated roughly, because it was far
+    // enough from the threshold that its exact value would not change the
+    // outcome, the true bounce action is taken to lie between these bounds.
+    // Otherwise they are both just the bounce action.
+    double BounceActionLowerBound() const
+    { return ( bounceAction - bounceActionUncertainty ); }
+    double BounceActionUpperBound() const
+    { return ( bounceAction + bounceActionUncertainty ); }
+    double& BounceActionUncertainty() { return bounceActionUncertainty; }
+
 
     // This should set up the bubble profile in terms of the auxiliary variable
     // and its slope, at values of the radial variable.
@@ -50,6 +61,7 @@ namespace VevaciousPlusPlus
 
   protected:
     double bounceAction;
+    double bounceActionUncertainty;
   };
 
 } /* namespace VevaciousPlusPlus */
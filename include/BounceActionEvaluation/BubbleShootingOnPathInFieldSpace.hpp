@@ -18,6 +18,7 @@
 #include <string>
 #include "BubbleRadialValueDescription.hpp"
 #include <cmath>
+#include <algorithm>
 #include "UndershootOvershootBubble.hpp"
 #include <cstddef>
 #include "boost/math/special_functions/bessel.hpp"
@@ -30,7 +31,10 @@ namespace VevaciousPlusPlus
   {
   public:
     BubbleShootingOnPathInFieldSpace( double const lengthScaleResolution,
-                                      unsigned int const shootAttempts );
+                                      unsigned int const shootAttempts,
+                                  unsigned int const roughShootAttempts = 0,
+                               double const roughIntegrationTolerance = 1.0e-4,
+                                double const roughActionUncertainty = 0.05 );
     virtual ~BubbleShootingOnPathInFieldSpace();
 
 
@@ -47,13 +51,24 @@ namespace VevaciousPlusPlus
                              PotentialMinimum const& trueVacuum,
                              double const tunnelingTemperature );
 
-    // This sets up the bubble profile, numerically integrates the bounce
-    // action over it, and then returns the bubble profile with calculated
-    // bounce action along the path given by tunnelPath. Either S_4, the
-    // dimensionless quantum bounce action integrated over four dimensions, or
-    // S_3(T), the dimensionful (in GeV) thermal bounce action integrated over
-    // three dimensions at temperature T, is calculated: S_3(T) if the
-    // temperature T given by tunnelPath is greater than 0.0, S_4 otherwise.
+    // This records actionThreshold so that bounce actions which a rough shot
+    // shows to be far enough from it are not calculated precisely.
+    virtual void SetActionThreshold( double const actionThreshold )
+    { this->actionThreshold = actionThreshold;
+      hasActionThreshold = true; }
+
+    // If roughShootAttempts is not 0 and an action threshold has been set
+    // since the last call of ResetVacua, this first shoots with
+    // roughShootAttempts attempts and roughIntegrationTolerance. If the
+    // resulting bounce action is further from the threshold than twice its
+    // estimated uncertainty, the rough bubble is returned with that
+    // uncertainty. Otherwise, or if there is no threshold, this returns the
+    // bubble profile from shooting with shootAttempts attempts and the
+    // default integration tolerance. Either S_4, the dimensionless quantum
+    // bounce action integrated over four dimensions, or S_3(T), the
+    // dimensionful (in GeV) thermal bounce action integrated over three
+    // dimensions at temperature T, is calculated: S_3(T) if the temperature T
+    // given by tunnelPath is greater than 0.0, S_4 otherwise.
     virtual BubbleProfile* operator()( TunnelPath const& tunnelPath,
                  OneDimensionalPotentialAlongPath const& pathPotential ) const;
 
@@ -66,6 +81,25 @@ namespace VevaciousPlusPlus
     double estimatedRadialMaximum;
     unsigned int const shootAttempts;
     double const auxiliaryThreshold;
+    unsigned int const roughShootAttempts;
+    double const roughIntegrationTolerance;
+    double actionThreshold;
+    bool hasActionThreshold;
+    // This starts as the given rough action uncertainty, as a fraction of the
+    // bounce action, and is increased whenever a precise calculation shows
+    // that a rough bounce action was further off than that.
+    mutable double roughRelativeUncertainty;
+
+
+    // This sets up the bubble profile by shooting with the given number of
+    // attempts and integration tolerance, numerically integrates the bounce
+    // action over it, and then returns the bubble profile with calculated
+    // bounce action along the path given by tunnelPath.
+    UndershootOvershootBubble*
+    ShootBubble( TunnelPath const& tunnelPath,
+                 OneDimensionalPotentialAlongPath const& pathPotential,
+                 unsigned int const numberOfShootAttempts,
+                 double const integrationTolerance ) const;
 
 
     // This evaluates the bounce action density at the given point on the
@@ -99,6 +133,7 @@ namespace VevaciousPlusPlus
           sqrt( potentialFunction.ScaleSquaredRelevantToTunneling( falseVacuum,
                                                             trueVacuum ) ) ) );
     radialStepSize = ( lengthScaleResolution * 0.5 * estimatedRadialMaximum );
+    hasActionThreshold = false;
   }
 
   // This evaluates the bounce action density at the given point on the
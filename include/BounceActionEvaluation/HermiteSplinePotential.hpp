@@ -0,0 +1,247 @@
+/*
+ * HermiteSplinePotential.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef HERMITESPLINEPOTENTIAL_HPP_
+#define HERMITESPLINEPOTENTIAL_HPP_
+
+#include "SplinePotential.hpp"
+#include "PotentialEvaluation/PotentialFunction.hpp"
+#include "PathParameterization/TunnelPath.hpp"
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace VevaciousPlusPlus
+{
+  // This class finds the path false vacuum, the end of the energy barrier, and
+  // the path panic vacuum exactly as SplinePotential does, from the potential
+  // at the same evenly-spaced nodes along the path, but then interpolates
+  // between the nodes with cubic Hermite polynomials which match both the
+  // potential and its derivative along the path at each node, rather than
+  // with straight lines. The derivative at each node is taken from the exact
+  // gradient of the potential projected onto the direction of the path (or
+  // from a finite difference along the path if the potential has no exact
+  // gradient), and is then limited as by Fritsch and Carlson so that the
+  // interpolation is monotonic wherever the node values are, so that it does
+  // not introduce spurious extrema. The path potential and its first
+  // derivative are then continuous everywhere, so the adaptive stepper which
+  // integrates the bubble profile does not have to shrink its steps to cross
+  // kinks at every node, and the end vacua are still taken as having zero
+  // slope along the path.
+  class HermiteSplinePotential : public SplinePotential
+  {
+  public:
+    HermiteSplinePotential( PotentialFunction const& potentialFunction,
+                            TunnelPath const& tunnelPath,
+                            unsigned int const numberOfPotentialSegments,
+                          double const minimumSquareDistanceBetweenPathVacua );
+    virtual ~HermiteSplinePotential();
+
+
+    // This returns the value of the potential at auxiliaryValue from the
+    // cubic polynomial of the interval containing it.
+    virtual double operator()( double auxiliaryValue ) const;
+
+    // This returns the value of the first derivative of the potential at
+    // auxiliaryValue from the cubic polynomial of the interval containing it.
+    virtual double FirstDerivative( double auxiliaryValue ) const;
+
+    // This returns the value of the second derivative of the potential at
+    // the false vacuum end of the path.
+    virtual double SecondDerivativeAtFalseVacuum() const;
+
+    // This returns the value of the first derivative of the potential at
+    // (auxiliaryOfPathPanicVacuum + differenceFromMaximumAuxiliary).
+    virtual double FirstDerivativeNearPathPanic(
+                           double const differenceFromMaximumAuxiliary ) const;
+
+    // This returns the coefficient of the quadratic approximation of the
+    // potential around the path panic vacuum, as SplinePotential does, which
+    // is half of the second derivative of the cubic polynomial there. If that
+    // is not positive, the quadratic coefficient from SplinePotential is
+    // returned instead. It is treated as constant near the path panic vacuum,
+    // so differenceFromMaximumAuxiliary is ignored.
+    virtual double SecondDerivativeNearPathPanic(
+                            double const differenceFromMaximumAuxiliary) const;
+
+
+  protected:
+    // These are the auxiliary values of the nodes from the path false vacuum
+    // to the path panic vacuum, the potential at each relative to the path
+    // false vacuum, and the derivative of the potential along the path at
+    // each. If the energy barrier was not resolved, they are left empty and
+    // the linear interpolation of SplinePotential is used.
+    std::vector< double > nodeAuxiliaries;
+    std::vector< double > nodePotentials;
+    std::vector< double > nodeSlopes;
+
+    // This returns the derivative of the potential with respect to the path
+    // auxiliary at auxiliaryValue.
+    double PotentialSlopeAlongPath( double const auxiliaryValue ) const;
+
+    // This reduces the magnitudes of nodeSlopes where necessary so that the
+    // cubic polynomial of each interval is monotonic if the potential at its
+    // nodes is, by the criteria of Fritsch and Carlson.
+    void LimitSlopesForMonotonicity();
+
+    // This returns the derivative of order derivativeOrder (0 for the value
+    // itself, up to 2) of the cubic polynomial of the interval containing
+    // auxiliaryValue, evaluated at auxiliaryValue.
+    double HermiteDerivative( double const auxiliaryValue,
+                              unsigned int const derivativeOrder ) const;
+  };
+
+
+
+
+  // This returns the value of the potential at auxiliaryValue from the cubic
+  // polynomial of the interval containing it.
+  inline double
+  HermiteSplinePotential::operator()( double auxiliaryValue ) const
+  {
+    if( nodeAuxiliaries.empty() )
+    {
+      return SplinePotential::operator()( auxiliaryValue );
+    }
+    if( auxiliaryValue >= auxiliaryOfPathPanicVacuum )
+    {
+      return finalPotential;
+    }
+    if( auxiliaryValue <= auxiliaryOfPathFalseVacuum )
+    {
+      return 0.0;
+    }
+    return HermiteDerivative( auxiliaryValue,
+                              0 );
+  }
+
+  // This returns the value of the first derivative of the potential at
+  // auxiliaryValue from the cubic polynomial of the interval containing it.
+  inline double
+  HermiteSplinePotential::FirstDerivative( double auxiliaryValue ) const
+  {
+    if( nodeAuxiliaries.empty() )
+    {
+      return SplinePotential::FirstDerivative( auxiliaryValue );
+    }
+    if( ( auxiliaryValue <= auxiliaryOfPathFalseVacuum )
+        ||
+        ( auxiliaryValue >= auxiliaryOfPathPanicVacuum ) )
+    {
+      return 0.0;
+    }
+    return HermiteDerivative( auxiliaryValue,
+                              1 );
+  }
+
+  // This returns the value of the second derivative of the potential at the
+  // false vacuum end of the path.
+  inline double HermiteSplinePotential::SecondDerivativeAtFalseVacuum() const
+  {
+    if( nodeAuxiliaries.empty() )
+    {
+      return SplinePotential::SecondDerivativeAtFalseVacuum();
+    }
+    return HermiteDerivative( auxiliaryOfPathFalseVacuum,
+                              2 );
+  }
+
+  // This returns the value of the first derivative of the potential at
+  // (auxiliaryOfPathPanicVacuum + differenceFromMaximumAuxiliary).
+  inline double HermiteSplinePotential::FirstDerivativeNearPathPanic(
+                            double const differenceFromMaximumAuxiliary ) const
+  {
+    if( nodeAuxiliaries.empty() )
+    {
+      return SplinePotential::FirstDerivativeNearPathPanic(
+                                              differenceFromMaximumAuxiliary );
+    }
+    return HermiteDerivative( ( auxiliaryOfPathPanicVacuum
+                                + differenceFromMaximumAuxiliary ),
+                              1 );
+  }
+
+  // This returns the coefficient of the quadratic approximation of the
+  // potential around the path panic vacuum, as SplinePotential does, which is
+  // half of the second derivative of the cubic polynomial there. If that is
+  // not positive, the quadratic coefficient from SplinePotential is returned
+  // instead. It is treated as constant near the path panic vacuum, so
+  // differenceFromMaximumAuxiliary is ignored.
+  inline double HermiteSplinePotential::SecondDerivativeNearPathPanic(
+                             double const differenceFromMaximumAuxiliary) const
+  {
+    if( !(nodeAuxiliaries.empty()) )
+    {
+      double const quadraticCoefficient( 0.5 * HermiteDerivative(
+                                                    auxiliaryOfPathPanicVacuum,
+                                                                    2 ) );
+      if( quadraticCoefficient > 0.0 )
+      {
+        return quadraticCoefficient;
+      }
+    }
+    return SplinePotential::SecondDerivativeNearPathPanic(
+                                              differenceFromMaximumAuxiliary );
+  }
+
+  // This returns the derivative of order derivativeOrder (0 for the value
+  // itself, up to 2) of the cubic polynomial of the interval containing
+  // auxiliaryValue, evaluated at auxiliaryValue.
+  inline double
+  HermiteSplinePotential::HermiteDerivative( double const auxiliaryValue,
+                                     unsigned int const derivativeOrder ) const
+  {
+    size_t intervalIndex( std::upper_bound( nodeAuxiliaries.begin(),
+                                            nodeAuxiliaries.end(),
+                                            auxiliaryValue )
+                          - nodeAuxiliaries.begin() );
+    intervalIndex = std::min( std::max( intervalIndex,
+                                        size_t( 1 ) ),
+                              ( nodeAuxiliaries.size() - 1 ) ) - 1;
+    double const intervalWidth( nodeAuxiliaries[ intervalIndex + 1 ]
+                                - nodeAuxiliaries[ intervalIndex ] );
+    double const scaledPosition( ( auxiliaryValue
+                                   - nodeAuxiliaries[ intervalIndex ] )
+                                 / intervalWidth );
+    double const lowerPotential( nodePotentials[ intervalIndex ] );
+    double const upperPotential( nodePotentials[ intervalIndex + 1 ] );
+    double const lowerSlope( nodeSlopes[ intervalIndex ] );
+    double const upperSlope( nodeSlopes[ intervalIndex + 1 ] );
+    double const positionSquared( scaledPosition * scaledPosition );
+    if( derivativeOrder == 0 )
+    {
+      double const positionCubed( positionSquared * scaledPosition );
+      return ( ( ( ( 2.0 * positionCubed ) - ( 3.0 * positionSquared ) + 1.0 )
+                 * lowerPotential )
+               + ( ( positionCubed - ( 2.0 * positionSquared )
+                     + scaledPosition )
+                   * intervalWidth * lowerSlope )
+               + ( ( ( 3.0 * positionSquared ) - ( 2.0 * positionCubed ) )
+                   * upperPotential )
+               + ( ( positionCubed - positionSquared )
+                   * intervalWidth * upperSlope ) );
+    }
+    double const potentialDrop( lowerPotential - upperPotential );
+    if( derivativeOrder == 1 )
+    {
+      return ( ( ( 6.0 * ( positionSquared - scaledPosition ) * potentialDrop )
+                 / intervalWidth )
+               + ( ( ( 3.0 * positionSquared ) - ( 4.0 * scaledPosition )
+                     + 1.0 ) * lowerSlope )
+               + ( ( ( 3.0 * positionSquared ) - ( 2.0 * scaledPosition ) )
+                   * upperSlope ) );
+    }
+    return ( ( ( ( ( 12.0 * scaledPosition ) - 6.0 ) * potentialDrop )
+               / ( intervalWidth * intervalWidth ) )
+             + ( ( ( ( 6.0 * scaledPosition ) - 4.0 ) * lowerSlope
+                   + ( ( 6.0 * scaledPosition ) - 2.0 ) * upperSlope )
+                 / intervalWidth ) );
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* HERMITESPLINEPOTENTIAL_HPP_ */
@@ -17,7 +17,9 @@
 #include <cstddef>
 #include "OdeintBubbleDerivatives.hpp"
 #include "OdeintBubbleObserver.hpp"
-#include "boost/numeric/odeint/integrate/integrate.hpp"
+#include "boost/numeric/odeint/integrate/integrate_adaptive.hpp"
+#include "boost/numeric/odeint/stepper/runge_kutta_dopri5.hpp"
+#include "boost/numeric/odeint/stepper/generation.hpp"
 #include <cmath>
 #include "boost/math/special_functions/bessel.hpp"
 #include <algorithm>
@@ -31,7 +33,8 @@ namespace VevaciousPlusPlus
     UndershootOvershootBubble( double const initialIntegrationStepSize,
                                double const initialIntegrationEndRadius,
                                unsigned int const allowShootingAttempts,
-                               double const shootingThreshold );
+                               double const shootingThreshold,
+                               double const integrationTolerance = 1.0e-6 );
     virtual ~UndershootOvershootBubble();
 
 
@@ -77,6 +80,8 @@ namespace VevaciousPlusPlus
 
   protected:
     typedef std::pair< size_t, double > IndexAndRemainder;
+    typedef boost::numeric::odeint::runge_kutta_dopri5< std::vector< double > >
+    OdeintStepper;
     static double const auxiliaryPrecisionResolution;
 
     std::vector< BubbleRadialValueDescription > auxiliaryProfile;
@@ -92,6 +97,9 @@ namespace VevaciousPlusPlus
     std::vector< double > initialConditions;
     double shootingThresholdSquared;
     unsigned int const allowShootingAttempts;
+    // This is used as both the absolute and the relative error tolerance of
+    // the adaptive Runge-Kutta stepper.
+    double const integrationTolerance;
     bool worthIntegratingFurther;
     bool currentShotGoodEnough;
     bool badInitialConditions;
@@ -236,12 +244,17 @@ namespace VevaciousPlusPlus
     OdeintBubbleDerivatives bubbleDerivatives( pathPotential,
                                                tunnelPath );
     OdeintBubbleObserver bubbleObserver( odeintProfile );
-    boost::numeric::odeint::integrate( bubbleDerivatives,
-                                       initialConditions,
-                                       integrationStartRadius,
-                                       integrationEndRadius,
-                                       integrationStepSize,
-                                       bubbleObserver );
+    boost::numeric::odeint::integrate_adaptive(
+                          boost::numeric::odeint::make_controlled(
+                                                          integrationTolerance,
+                                                          integrationTolerance,
+                                                           OdeintStepper() ),
+                                                bubbleDerivatives,
+                                                initialConditions,
+                                                integrationStartRadius,
+                                                integrationEndRadius,
+                                                integrationStepSize,
+                                                bubbleObserver );
     RecordFromOdeintProfile( tunnelPath );
     if(badInitialConditions)
     {
@@ -249,12 +262,17 @@ namespace VevaciousPlusPlus
       OdeintBubbleDerivatives bubbleDerivatives( pathPotential,
                                                  tunnelPath );
       OdeintBubbleObserver bubbleObserver( odeintProfile );
-      boost::numeric::odeint::integrate( bubbleDerivatives,
-                                         initialConditions,
-                                         integrationStartRadius*0.99 ,
-                                         integrationEndRadius,
-                                         integrationStepSize,
-                                         bubbleObserver );
+      boost::numeric::odeint::integrate_adaptive(
+                          boost::numeric::odeint::make_controlled(
+                                                          integrationTolerance,
+                                                          integrationTolerance,
+                                                           OdeintStepper() ),
+                                                  bubbleDerivatives,
+                                                  initialConditions,
+                                                  integrationStartRadius*0.99 ,
+                                                  integrationEndRadius,
+                                                  integrationStepSize,
+                                                  bubbleObserver );
       RecordFromOdeintProfile( tunnelPath );
     }
   }
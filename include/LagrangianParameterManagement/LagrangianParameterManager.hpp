@@ -62,6 +62,19 @@ namespace VevaciousPlusPlus
     virtual void ParameterValues( double logarithmOfScale,
                           std::vector< double >& destinationVector ) const = 0;
 
+    // This should fill valuesDestination with the values of the Lagrangian
+    // parameters evaluated at the given scale, as ParameterValues does, and
+    // derivativesDestination with their derivatives with respect to the
+    // logarithm of the scale, and return true. By default it returns false,
+    // to indicate that the derivatives are not available, in which case
+    // anything which depends on the parameters running with the scale can
+    // only be differentiated numerically.
+    virtual bool
+    ParameterValuesAndScaleDerivatives( double const logarithmOfScale,
+                                    std::vector< double >& valuesDestination,
+                          std::vector< double >& derivativesDestination ) const
+    { return false; }
+
     // This should return the minimum scale which is appropriate for evaluating
     // the Lagrangian parameters at the current parameter point.
     virtual double MinimumEvaluationScale() const = 0;
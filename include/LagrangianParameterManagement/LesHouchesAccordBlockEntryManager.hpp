@@ -83,6 +83,16 @@ namespace VevaciousPlusPlus
     virtual void ParameterValues( double const logarithmOfScale,
                               std::vector< double >& destinationVector ) const;
 
+    // This fills valuesDestination with the values of the Lagrangian
+    // parameters in activeInterpolatedParameters evaluated at the given scale,
+    // as ParameterValues does, and derivativesDestination with their
+    // derivatives with respect to the logarithm of the scale, which are exact
+    // for the interpolation used, and returns true.
+    virtual bool
+    ParameterValuesAndScaleDerivatives( double const logarithmOfScale,
+                                      std::vector< double >& valuesDestination,
+                         std::vector< double >& derivativesDestination ) const;
+
     // This should return the minimum scale which is appropriate for evaluating
     // the Lagrangian parameters at the current parameter point.
     virtual double MinimumEvaluationScale() const
@@ -286,6 +296,32 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This fills valuesDestination with the values of the Lagrangian parameters
+  // in activeInterpolatedParameters evaluated at the given scale, as
+  // ParameterValues does, and derivativesDestination with their derivatives
+  // with respect to the logarithm of the scale, which are exact for the
+  // interpolation used, and returns true.
+  inline bool
+  LesHouchesAccordBlockEntryManager::ParameterValuesAndScaleDerivatives(
+                                                 double const logarithmOfScale,
+                                      std::vector< double >& valuesDestination,
+                          std::vector< double >& derivativesDestination ) const
+  {
+    LesHouchesAccordBlockEntryManager::ParameterValues( logarithmOfScale,
+                                                        valuesDestination );
+    derivativesDestination.assign( numberOfDistinctActiveParameters,
+                                   0.0 );
+    for( std::vector< LhaBlockEntryInterpolator >::const_iterator
+         parameterInterpolator( referenceUnsafeActiveParameters.begin() );
+         parameterInterpolator != referenceUnsafeActiveParameters.end();
+         ++parameterInterpolator )
+    {
+      derivativesDestination[ parameterInterpolator->IndexInValuesVector() ]
+      = parameterInterpolator->ScaleDerivative( logarithmOfScale );
+    }
+    return true;
+  }
+
   // This writes a function in the form
   // def LagrangianParameters( lnQ ): return ...
   // to return an array of the values of the Lagrangian parameters evaluated
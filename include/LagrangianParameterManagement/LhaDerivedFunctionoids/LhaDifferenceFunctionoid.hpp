@@ -43,6 +43,15 @@ namespace VevaciousPlusPlus
                        double const subtractedValue ) const
     { return ( subtractorValue - subtractedValue ); }
 
+    // This returns the difference of the derivatives with respect to the
+    // logarithm of the scale of the parameters at subtractorIndex and
+    // subtractedIndex.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ( interpolatedDerivatives[ subtractorIndex ]
+               - interpolatedDerivatives[ subtractedIndex ] ); }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
@@ -45,6 +45,16 @@ namespace VevaciousPlusPlus
     { return
       ( ( firstChoiceValue != 0.0 ) ? firstChoiceValue : secondChoiceValue ); }
 
+    // This returns the derivative with respect to the logarithm of the scale
+    // of the parameter at firstChoiceIndex if its value is non-zero, otherwise
+    // that of the parameter at secondChoiceIndex.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ( ( interpolatedValues[ firstChoiceIndex ] != 0.0 ) ?
+               interpolatedDerivatives[ firstChoiceIndex ] :
+               interpolatedDerivatives[ secondChoiceIndex ] ); }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
@@ -54,6 +54,13 @@ namespace VevaciousPlusPlus
       ( ( sinNotCos ? ( vevEuclideanLength * tanBeta ) : vevEuclideanLength )
         / sqrt( 1.0 + ( tanBeta * tanBeta ) ) ); }
 
+    // This returns the derivative of the DSB VEV with respect to the logarithm
+    // of the scale, from the derivatives of HMIX[3] and of tan(beta) by the
+    // chain rule.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const;
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
@@ -72,6 +79,32 @@ namespace VevaciousPlusPlus
 
 
 
+  // This returns the derivative of the DSB VEV with respect to the logarithm
+  // of the scale, from the derivatives of HMIX[3] and of tan(beta) by the
+  // chain rule.
+  inline double SlhaDsbHiggsVevFunctionoid::ScaleDerivative(
+                                                 double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                   std::vector< double > const& interpolatedDerivatives ) const
+  {
+    double const vevEuclideanLength( interpolatedValues[ vevIndex ] );
+    double const tanBeta( interpolatedValues[ tanBetaIndex ] );
+    double const tanBetaDerivative( interpolatedDerivatives[ tanBetaIndex ] );
+    double const secantBetaSquared( 1.0 + ( tanBeta * tanBeta ) );
+    double const cosBeta( 1.0 / sqrt( secantBetaSquared ) );
+    // d(cos(beta))/d(tan(beta)) is -tan(beta) cos^3(beta) and
+    // d(sin(beta))/d(tan(beta)) is cos^3(beta).
+    double const cosBetaCubed( cosBeta * cosBeta * cosBeta );
+    if( sinNotCos )
+    {
+      return ( ( interpolatedDerivatives[ vevIndex ] * tanBeta * cosBeta )
+               + ( vevEuclideanLength * cosBetaCubed * tanBetaDerivative ) );
+    }
+    return ( ( interpolatedDerivatives[ vevIndex ] * cosBeta )
+             - ( vevEuclideanLength * tanBeta * cosBetaCubed
+                 * tanBetaDerivative ) );
+  }
+
   // This is for creating a Python version of the potential.
   inline std::string SlhaDsbHiggsVevFunctionoid::PythonParameterEvaluation(
                                             int const indentationSpaces ) const
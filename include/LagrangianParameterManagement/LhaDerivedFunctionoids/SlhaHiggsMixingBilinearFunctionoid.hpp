@@ -44,6 +44,18 @@ namespace VevaciousPlusPlus
                        double const treePseudoscalarMassSquared ) const
     { return ( SinBetaCosBeta( tanBeta ) * treePseudoscalarMassSquared ); }
 
+    // This returns the derivative of sin(beta) * cos(beta) * mA^2 with respect
+    // to the logarithm of the scale, from the derivatives of tan(beta) and of
+    // mA^2 by the chain rule.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ( ( SinBetaCosBetaSlope( interpolatedValues[ tanBetaIndex ] )
+                 * interpolatedDerivatives[ tanBetaIndex ]
+                 * interpolatedValues[ treePseudoscalarMassSquaredIndex ] )
+               + ( SinBetaCosBeta( interpolatedValues[ tanBetaIndex ] )
+           * interpolatedDerivatives[ treePseudoscalarMassSquaredIndex ] ) ); }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
@@ -58,6 +70,12 @@ namespace VevaciousPlusPlus
     static double SinBetaCosBeta( double const tanBeta )
     { return ( tanBeta / ( 1.0 + ( tanBeta * tanBeta ) ) ); }
 
+    // This returns the derivative of SinBetaCosBeta with respect to tanBeta.
+    static double SinBetaCosBetaSlope( double const tanBeta )
+    { return ( ( 1.0 - ( tanBeta * tanBeta ) )
+               / ( ( 1.0 + ( tanBeta * tanBeta ) )
+                   * ( 1.0 + ( tanBeta * tanBeta ) ) ) ); }
+
     size_t const treePseudoscalarMassSquaredIndex;
     size_t const tanBetaIndex;
   };
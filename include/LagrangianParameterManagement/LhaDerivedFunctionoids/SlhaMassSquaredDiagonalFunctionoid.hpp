@@ -49,6 +49,19 @@ namespace VevaciousPlusPlus
     { return
       ( ( squareMass != 0.0 ) ? squareMass : ( linearMass * linearMass ) ); }
 
+    // This returns the derivative of the mass-squared parameter with respect
+    // to the logarithm of the scale, either directly from the derivative of
+    // its value in the MSL2, MSE2, MSQ2, MSD2, or MSU2 blocks, or from the
+    // derivative of the appropriate value from the MSOFT block by the chain
+    // rule.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ( ( interpolatedValues[ squareMassIndex ] != 0.0 ) ?
+               interpolatedDerivatives[ squareMassIndex ] :
+               ( 2.0 * interpolatedValues[ linearMassIndex ]
+                 * interpolatedDerivatives[ linearMassIndex ] ) ); }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
@@ -54,6 +54,20 @@ namespace VevaciousPlusPlus
                directTrilinear :
                ( trilinearOverYukawa * appropriateYukawa ) ); }
 
+    // This returns the derivative of the trilinear coupling with respect to
+    // the logarithm of the scale, either directly from the derivative of its
+    // value in the TL, TE, TQ, TD, or TU blocks, or from the derivatives of the
+    // A-value and the appropriate Yukawa coupling by the product rule.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ( ( interpolatedValues[ directTrilinearIndex ] != 0.0 ) ?
+               interpolatedDerivatives[ directTrilinearIndex ] :
+               ( ( interpolatedDerivatives[ trilinearOverYukawaIndex ]
+                   * interpolatedValues[ appropriateYukawaIndex ] )
+                 + ( interpolatedValues[ trilinearOverYukawaIndex ]
+                     * interpolatedDerivatives[ appropriateYukawaIndex ] ) ) ); }
+
     // This is for creating a Python version of the potential.
     virtual std::string
     PythonParameterEvaluation( int const indentationSpaces ) const;
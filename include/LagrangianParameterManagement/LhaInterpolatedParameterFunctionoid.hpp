@@ -46,6 +46,17 @@ namespace VevaciousPlusPlus
     virtual double operator()( double const logarithmOfScale,
                    std::vector< double > const& interpolatedValues ) const = 0;
 
+    // This should return the derivative of the functionoid with respect to the
+    // logarithm of the scale, for the given logarithm of the scale.
+    virtual double ScaleDerivative( double const logarithmOfScale ) const = 0;
+
+    // This should return the derivative of the functionoid with respect to the
+    // logarithm of the scale, for the given logarithm of the scale. It should
+    // ignore the values and derivatives of the other parameters.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+              std::vector< double > const& interpolatedDerivatives ) const = 0;
+
     // This should re-calculate the coefficients of the polynomial of the
     // logarithm of the scale used in evaluating the functionoid.
     virtual void UpdateForNewLhaParameters() = 0;
@@ -51,6 +51,23 @@ namespace VevaciousPlusPlus
                        std::vector< double > const& interpolatedValues ) const
     { return InterpolateOrExtrapolate( logarithmOfScale ); }
 
+    // This returns the slope of the straight line used for interpolating (or
+    // extrapolating) the value for the given logarithm of the scale, which is
+    // exactly the derivative of the functionoid with respect to the logarithm
+    // of the scale, away from the logarithms of the scales of the blocks,
+    // where the derivative is discontinuous and the slope of the line used for
+    // the value is returned.
+    virtual double ScaleDerivative( double const logarithmOfScale ) const
+    { return InterpolationSlope( IndexOfGreaterLog( logarithmOfScale ) ); }
+
+    // This returns the derivative of the functionoid with respect to the
+    // logarithm of the scale for the given logarithm of the scale. It ignores
+    // the values and derivatives of the other parameters.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return ScaleDerivative( logarithmOfScale ); }
+
     // This re-assigns the vector of values paired with logarithms of the
     // block's scale according to the current status of the block.
     virtual void UpdateForNewLhaParameters();
@@ -73,7 +90,23 @@ namespace VevaciousPlusPlus
     // extrapolation) based on the logarithm-value pairs at the found index and
     // the index just before it. It starts with index 1 so that there is always
     // an index just before.
-    double InterpolateOrExtrapolate( double const logarithmOfScale ) const;
+    double InterpolateOrExtrapolate( double const logarithmOfScale ) const
+    { return InterpolateOrExtrapolate( IndexOfGreaterLog( logarithmOfScale ),
+                                       logarithmOfScale ); }
+
+    // This returns the index of the smallest logarithm of the scale which is
+    // larger than logarithmOfScale, starting with index 1 so that there is
+    // always an index just before, or lastIndex if there is no larger
+    // logarithm, so that the value is extrapolated from the last 2 points.
+    size_t IndexOfGreaterLog( double const logarithmOfScale ) const;
+
+    // This returns the slope of the straight line through the points in
+    // logScalesWithValues at indexOfGreaterLog and one before it.
+    double InterpolationSlope( size_t const indexOfGreaterLog ) const
+    { return ( ( logScalesWithValues[ indexOfGreaterLog ].second
+                 - logScalesWithValues[ indexOfGreaterLog - 1 ].second )
+               / ( logScalesWithValues[ indexOfGreaterLog ].first
+                   - logScalesWithValues[ indexOfGreaterLog - 1 ].first ) ); }
 
     // This takes the points in logScalesWithValues at indexOfGreaterLog and
     // one before it, and interpolates (or possibly extrapolates) the value
@@ -117,12 +150,11 @@ namespace VevaciousPlusPlus
     return stringBuilder.str();
   }
 
-  // This finds the index of the smallest logarithm of the scale which is
-  // larger than logarithmOfScale and returns the interpolation (or possibly
-  // extrapolation) based on the logarithm-value pairs at the found index and
-  // the index just before it. It starts with index 1 so that there is always
-  // an index just before.
-  inline double LhaLinearlyInterpolatedBlockEntry::InterpolateOrExtrapolate(
+  // This returns the index of the smallest logarithm of the scale which is
+  // larger than logarithmOfScale, starting with index 1 so that there is
+  // always an index just before, or lastIndex if there is no larger
+  // logarithm, so that the value is extrapolated from the last 2 points.
+  inline size_t LhaLinearlyInterpolatedBlockEntry::IndexOfGreaterLog(
                                           double const logarithmOfScale ) const
   {
     for( size_t whichIndex( 1 );
@@ -131,15 +163,13 @@ namespace VevaciousPlusPlus
     {
       if( logarithmOfScale < logScalesWithValues[ whichIndex ].first )
       {
-        return InterpolateOrExtrapolate( whichIndex,
-                                         logarithmOfScale );
+        return whichIndex;
       }
     }
 
-    // If the loop ends without returning a value, then we extrapolate from
+    // If the loop ends without returning an index, then we extrapolate from
     // the last 2 points.
-    return InterpolateOrExtrapolate( lastIndex,
-                                     logarithmOfScale );
+    return lastIndex;
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -45,8 +45,22 @@ namespace VevaciousPlusPlus
                         std::vector< double > const& interpolatedValues ) const
     { return scaleLogarithmPowerCoefficients( logarithmOfScale ); }
 
+    // This returns the derivative of the functionoid with respect to the
+    // logarithm of the scale for the given logarithm of the scale, which is
+    // exact as the functionoid is a polynomial in the logarithm of the scale.
+    virtual double ScaleDerivative( double const logarithmOfScale ) const
+    { return scaleLogarithmDerivativeCoefficients( logarithmOfScale ); }
+
+    // This returns the derivative of the functionoid with respect to the
+    // logarithm of the scale for the given logarithm of the scale. It ignores
+    // the values and derivatives of the other parameters.
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+                  std::vector< double > const& interpolatedDerivatives ) const
+    { return scaleLogarithmDerivativeCoefficients( logarithmOfScale ); }
+
     // This re-calculates the coefficients of the polynomial of the logarithm
-    // of the scale used in evaluating the functionoid.
+    // of the scale used in evaluating the functionoid, and of its derivative.
     virtual void UpdateForNewLhaParameters();
 
     // This is for creating a Python version of the potential.
@@ -59,6 +73,7 @@ namespace VevaciousPlusPlus
 
   protected:
     SimplePolynomial scaleLogarithmPowerCoefficients;
+    SimplePolynomial scaleLogarithmDerivativeCoefficients;
   };
 
 
@@ -34,6 +34,17 @@ namespace VevaciousPlusPlus
     virtual double operator()( double const logarithmOfScale,
                    std::vector< double > const& interpolatedValues ) const = 0;
 
+    // This should return the derivative of the functionoid with respect to
+    // the logarithm of the scale, using the values of the parameters directly
+    // interpolated from the values explicitly given in the SLHA file, given by
+    // interpolatedValues, and their derivatives with respect to the logarithm
+    // of the scale, given by interpolatedDerivatives (both of which should
+    // have correct values in the elements with index lower than
+    // indexInValuesVector).
+    virtual double ScaleDerivative( double const logarithmOfScale,
+                               std::vector< double > const& interpolatedValues,
+              std::vector< double > const& interpolatedDerivatives ) const = 0;
+
     // This should return a string for creating a Python version of the
     // potential, indented by indentationSpaces spaces.
     virtual std::string
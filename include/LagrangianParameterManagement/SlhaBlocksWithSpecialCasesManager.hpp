@@ -76,6 +76,17 @@ namespace VevaciousPlusPlus
     virtual void ParameterValues( double const logarithmOfScale,
                               std::vector< double >& destinationVector ) const;
 
+    // This fills valuesDestination and derivativesDestination with the values
+    // of the Lagrangian parameters and their derivatives with respect to the
+    // logarithm of the scale, first from the base version from
+    // LesHouchesAccordBlockEntryManager and then from the functionoids in
+    // activeDerivedParameters in order, just as for ParameterValues, and
+    // returns true.
+    virtual bool
+    ParameterValuesAndScaleDerivatives( double const logarithmOfScale,
+                                      std::vector< double >& valuesDestination,
+                         std::vector< double >& derivativesDestination ) const;
+
     // This first writes a function used by some derived parameters, and then
     // writes a function in the form
     // def LagrangianParameters( lnQ ): return ...
@@ -248,6 +259,39 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This fills valuesDestination and derivativesDestination with the values
+  // of the Lagrangian parameters and their derivatives with respect to the
+  // logarithm of the scale, first from the base version from
+  // LesHouchesAccordBlockEntryManager and then from the functionoids in
+  // activeDerivedParameters in order, just as for ParameterValues, and returns
+  // true.
+  inline bool SlhaBlocksWithSpecialCasesManager::ParameterValuesAndScaleDerivatives(
+                                                 double const logarithmOfScale,
+                                      std::vector< double >& valuesDestination,
+                          std::vector< double >& derivativesDestination ) const
+  {
+    LesHouchesAccordBlockEntryManager::ParameterValuesAndScaleDerivatives(
+                                                              logarithmOfScale,
+                                                             valuesDestination,
+                                                      derivativesDestination );
+    for( std::vector< LhaSourcedParameterFunctionoid* >::const_iterator
+         parameterInterpolator( activeDerivedParameters.begin() );
+         parameterInterpolator < activeDerivedParameters.end();
+         ++parameterInterpolator )
+    {
+      size_t const
+      parameterIndex( (*parameterInterpolator)->IndexInValuesVector() );
+      valuesDestination[ parameterIndex ]
+      = (*(*parameterInterpolator))( logarithmOfScale,
+                                     valuesDestination );
+      derivativesDestination[ parameterIndex ]
+      = (*parameterInterpolator)->ScaleDerivative( logarithmOfScale,
+                                                   valuesDestination,
+                                                   derivativesDestination );
+    }
+    return true;
+  }
+
   // This first writes a function used by some derived parameters, and then
   // writes a function in the form
   // def LagrangianParameters( lnQ ): return ...
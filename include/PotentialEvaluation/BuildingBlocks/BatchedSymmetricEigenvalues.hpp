@@ -0,0 +1,382 @@
+/*
+ * BatchedSymmetricEigenvalues.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef BATCHEDSYMMETRICEIGENVALUES_HPP_
+#define BATCHEDSYMMETRICEIGENVALUES_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+namespace VevaciousPlusPlus
+{
+  // This class finds the eigenvalues of many real symmetric or complex
+  // Hermitian matrices of the same size together, by cyclic Jacobi rotations
+  // applied in lock-step to every matrix of the batch. The matrices are stored
+  // in structure-of-arrays form, so that element ( r, c ) of matrix l of a
+  // batch of b matrices with n rows is at [ ( ( r * n ) + c ) * b + l ], which
+  // keeps the loops over the batch contiguous so that the compiler can
+  // vectorize them. Each matrix gets its own rotation angles, so only the
+  // sequence of operations is shared across the batch.
+  class BatchedSymmetricEigenvalues
+  {
+  public:
+    // This fills eigenvaluesByLane[ l ] with the eigenvalues, in ascending
+    // order, of matrix l of the batch of real symmetric matrices given by
+    // elementsByLane, which is overwritten in the process. Both triangles of
+    // each matrix must be filled.
+    static void RealSymmetricEigenvalues( size_t const numberOfRows,
+                                          size_t const batchSize,
+                                         std::vector< double >& elementsByLane,
+                      std::vector< std::vector< double > >& eigenvaluesByLane );
+
+    // This fills eigenvaluesByLane[ l ] with the eigenvalues, in ascending
+    // order, of matrix l of the batch of Hermitian matrices with real parts
+    // given by realPartsByLane and imaginary parts given by
+    // imaginaryPartsByLane. Only the lower triangle (column index <= row
+    // index) is read, as for Eigen::SelfAdjointEigenSolver. Each Hermitian
+    // matrix A + i B is diagonalized through the real symmetric matrix
+    // ( ( A, -B ), ( B, A ) ) which has each eigenvalue of A + i B twice.
+    static void HermitianEigenvalues( size_t const numberOfRows,
+                                      size_t const batchSize,
+                                 std::vector< double > const& realPartsByLane,
+                            std::vector< double > const& imaginaryPartsByLane,
+                      std::vector< std::vector< double > >& eigenvaluesByLane );
+
+
+  protected:
+    // This is the maximum number of sweeps over all the off-diagonal
+    // elements. Cyclic Jacobi converges quadratically, so for matrices of the
+    // sizes used for mass matrices this is never reached in practice.
+    static size_t const maximumNumberOfSweeps = 50;
+
+    // This returns true if the sum of squares of the off-diagonal elements of
+    // every matrix of the batch is negligible compared to the sum of squares
+    // of its diagonal elements.
+    static bool AllLanesConverged( size_t const numberOfRows,
+                                   size_t const batchSize,
+                                 std::vector< double > const& elementsByLane );
+
+    // This applies the Jacobi rotation which zeroes element ( p, q ) to every
+    // matrix of the batch, using rotationTangents, rotationCosines and
+    // rotationSines as workspace.
+    static void RotateAllLanes( size_t const numberOfRows,
+                                size_t const batchSize,
+                                size_t const pIndex,
+                                size_t const qIndex,
+                                std::vector< double >& elementsByLane,
+                                std::vector< double >& rotationTangents,
+                                std::vector< double >& rotationCosines,
+                                std::vector< double >& rotationSines );
+  };
+
+
+
+
+
+  // This fills eigenvaluesByLane[ l ] with the eigenvalues, in ascending
+  // order, of matrix l of the batch of real symmetric matrices given by
+  // elementsByLane, which is overwritten in the process. Both triangles of
+  // each matrix must be filled.
+  inline void BatchedSymmetricEigenvalues::RealSymmetricEigenvalues(
+                                                     size_t const numberOfRows,
+                                                        size_t const batchSize,
+                                          std::vector< double >& elementsByLane,
+                       std::vector< std::vector< double > >& eigenvaluesByLane )
+  {
+    std::vector< double > rotationTangents( batchSize );
+    std::vector< double > rotationCosines( batchSize );
+    std::vector< double > rotationSines( batchSize );
+    for( size_t sweepCount( 0 );
+         sweepCount < maximumNumberOfSweeps;
+         ++sweepCount )
+    {
+      if( AllLanesConverged( numberOfRows,
+                             batchSize,
+                             elementsByLane ) )
+      {
+        break;
+      }
+      for( size_t pIndex( 0 );
+           pIndex < numberOfRows;
+           ++pIndex )
+      {
+        for( size_t qIndex( pIndex + 1 );
+             qIndex < numberOfRows;
+             ++qIndex )
+        {
+          RotateAllLanes( numberOfRows,
+                          batchSize,
+                          pIndex,
+                          qIndex,
+                          elementsByLane,
+                          rotationTangents,
+                          rotationCosines,
+                          rotationSines );
+        }
+      }
+    }
+    eigenvaluesByLane.resize( batchSize );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      std::vector< double >& eigenvalues( eigenvaluesByLane[ laneIndex ] );
+      eigenvalues.resize( numberOfRows );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        eigenvalues[ rowIndex ]
+        = elementsByLane[ ( ( rowIndex * numberOfRows ) + rowIndex )
+                          * batchSize + laneIndex ];
+      }
+      std::sort( eigenvalues.begin(),
+                 eigenvalues.end() );
+    }
+  }
+
+  // This fills eigenvaluesByLane[ l ] with the eigenvalues, in ascending
+  // order, of matrix l of the batch of Hermitian matrices with real parts
+  // given by realPartsByLane and imaginary parts given by
+  // imaginaryPartsByLane. Only the lower triangle (column index <= row index)
+  // is read, as for Eigen::SelfAdjointEigenSolver. Each Hermitian matrix
+  // A + i B is diagonalized through the real symmetric matrix
+  // ( ( A, -B ), ( B, A ) ) which has each eigenvalue of A + i B twice.
+  inline void BatchedSymmetricEigenvalues::HermitianEigenvalues(
+                                                     size_t const numberOfRows,
+                                                        size_t const batchSize,
+                                  std::vector< double > const& realPartsByLane,
+                             std::vector< double > const& imaginaryPartsByLane,
+                       std::vector< std::vector< double > >& eigenvaluesByLane )
+  {
+    size_t const doubledRows( 2 * numberOfRows );
+    std::vector< double >
+    embeddedByLane( ( doubledRows * doubledRows * batchSize ) );
+    for( size_t rowIndex( 0 );
+         rowIndex < numberOfRows;
+         ++rowIndex )
+    {
+      for( size_t columnIndex( 0 );
+           columnIndex <= rowIndex;
+           ++columnIndex )
+      {
+        double const* const realPart( &(realPartsByLane[ ( ( rowIndex
+                                                             * numberOfRows )
+                                                           + columnIndex )
+                                                         * batchSize ]) );
+        double const* const
+        imaginaryPart( &(imaginaryPartsByLane[ ( ( rowIndex * numberOfRows )
+                                                 + columnIndex )
+                                               * batchSize ]) );
+        // A is symmetric and B is antisymmetric, so element ( r, c ) and
+        // element ( c, r ) of each block can be set together.
+        size_t const upperLeft( ( ( rowIndex * doubledRows ) + columnIndex )
+                                * batchSize );
+        size_t const upperLeftTransposed( ( ( columnIndex * doubledRows )
+                                            + rowIndex ) * batchSize );
+        size_t const lowerRight( ( ( ( rowIndex + numberOfRows )
+                                     * doubledRows )
+                                   + columnIndex + numberOfRows )
+                                 * batchSize );
+        size_t const lowerRightTransposed( ( ( ( columnIndex + numberOfRows )
+                                               * doubledRows )
+                                             + rowIndex + numberOfRows )
+                                           * batchSize );
+        size_t const lowerLeft( ( ( ( rowIndex + numberOfRows )
+                                    * doubledRows )
+                                  + columnIndex ) * batchSize );
+        size_t const lowerLeftTransposed( ( ( ( columnIndex + numberOfRows )
+                                              * doubledRows )
+                                            + rowIndex ) * batchSize );
+        size_t const upperRight( ( ( rowIndex * doubledRows )
+                                   + columnIndex + numberOfRows )
+                                 * batchSize );
+        size_t const upperRightTransposed( ( ( columnIndex * doubledRows )
+                                             + rowIndex + numberOfRows )
+                                           * batchSize );
+        // The imaginary parts of the diagonal are ignored, as Eigen does.
+        double const
+        imaginaryFactor( ( columnIndex == rowIndex ) ? 0.0 : 1.0 );
+        for( size_t laneIndex( 0 );
+             laneIndex < batchSize;
+             ++laneIndex )
+        {
+          double const realValue( realPart[ laneIndex ] );
+          double const imaginaryValue( imaginaryFactor
+                                       * imaginaryPart[ laneIndex ] );
+          embeddedByLane[ upperLeft + laneIndex ] = realValue;
+          embeddedByLane[ upperLeftTransposed + laneIndex ] = realValue;
+          embeddedByLane[ lowerRight + laneIndex ] = realValue;
+          embeddedByLane[ lowerRightTransposed + laneIndex ] = realValue;
+          embeddedByLane[ lowerLeft + laneIndex ] = imaginaryValue;
+          embeddedByLane[ lowerLeftTransposed + laneIndex ] = -imaginaryValue;
+          embeddedByLane[ upperRight + laneIndex ] = -imaginaryValue;
+          embeddedByLane[ upperRightTransposed + laneIndex ] = imaginaryValue;
+        }
+      }
+    }
+    std::vector< std::vector< double > > doubledEigenvalues;
+    RealSymmetricEigenvalues( doubledRows,
+                              batchSize,
+                              embeddedByLane,
+                              doubledEigenvalues );
+    eigenvaluesByLane.resize( batchSize );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      eigenvaluesByLane[ laneIndex ].resize( numberOfRows );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        eigenvaluesByLane[ laneIndex ][ rowIndex ]
+        = doubledEigenvalues[ laneIndex ][ 2 * rowIndex ];
+      }
+    }
+  }
+
+  // This returns true if the sum of squares of the off-diagonal elements of
+  // every matrix of the batch is negligible compared to the sum of squares of
+  // its diagonal elements.
+  inline bool BatchedSymmetricEigenvalues::AllLanesConverged(
+                                                     size_t const numberOfRows,
+                                                        size_t const batchSize,
+                                  std::vector< double > const& elementsByLane )
+  {
+    std::vector< double > offDiagonalSquares( batchSize,
+                                              0.0 );
+    std::vector< double > diagonalSquares( batchSize,
+                                           0.0 );
+    for( size_t rowIndex( 0 );
+         rowIndex < numberOfRows;
+         ++rowIndex )
+    {
+      for( size_t columnIndex( rowIndex );
+           columnIndex < numberOfRows;
+           ++columnIndex )
+      {
+        double const* const
+        elementValues( &(elementsByLane[ ( ( rowIndex * numberOfRows )
+                                           + columnIndex ) * batchSize ]) );
+        std::vector< double >& sumToIncrease( ( columnIndex == rowIndex ) ?
+                                              diagonalSquares :
+                                              offDiagonalSquares );
+        for( size_t laneIndex( 0 );
+             laneIndex < batchSize;
+             ++laneIndex )
+        {
+          sumToIncrease[ laneIndex ]
+          += ( elementValues[ laneIndex ] * elementValues[ laneIndex ] );
+        }
+      }
+    }
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      // The factor of 10^(-28) is (10^(-14))^2, as the comparison is of sums
+      // of squares. A relative tolerance of 10^(-15) would be at the level of
+      // the rounding errors of the sums themselves, so might never be met.
+      if( offDiagonalSquares[ laneIndex ]
+          > ( 1.0e-28 * diagonalSquares[ laneIndex ] ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // This applies the Jacobi rotation which zeroes element ( p, q ) to every
+  // matrix of the batch, using rotationTangents, rotationCosines and
+  // rotationSines as workspace.
+  inline void BatchedSymmetricEigenvalues::RotateAllLanes(
+                                                     size_t const numberOfRows,
+                                                        size_t const batchSize,
+                                                           size_t const pIndex,
+                                                           size_t const qIndex,
+                                          std::vector< double >& elementsByLane,
+                                        std::vector< double >& rotationTangents,
+                                         std::vector< double >& rotationCosines,
+                                          std::vector< double >& rotationSines )
+  {
+    double* const ppValues( &(elementsByLane[ ( ( pIndex * numberOfRows )
+                                                + pIndex ) * batchSize ]) );
+    double* const qqValues( &(elementsByLane[ ( ( qIndex * numberOfRows )
+                                                + qIndex ) * batchSize ]) );
+    double* const pqValues( &(elementsByLane[ ( ( pIndex * numberOfRows )
+                                                + qIndex ) * batchSize ]) );
+    double* const qpValues( &(elementsByLane[ ( ( qIndex * numberOfRows )
+                                                + pIndex ) * batchSize ]) );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      double const pqValue( pqValues[ laneIndex ] );
+      // theta = cot( 2 phi ) for rotation angle phi, and the tangent of phi
+      // is taken as the smaller root of t^2 + 2 theta t - 1 = 0 for
+      // stability. Lanes where the element is already zero get the identity
+      // rotation.
+      double const nonZeroPq( ( pqValue == 0.0 ) ? 1.0 : pqValue );
+      double const thetaValue( ( qqValues[ laneIndex ] - ppValues[ laneIndex ] )
+                               / ( 2.0 * nonZeroPq ) );
+      double const tangentValue( ( ( pqValue == 0.0 ) ? 0.0 : 1.0 )
+                                 / ( thetaValue
+                                     + ( ( thetaValue < 0.0 ) ? -1.0 : 1.0 )
+                                       * sqrt( ( thetaValue * thetaValue )
+                                               + 1.0 ) ) );
+      double const cosineValue( 1.0 / sqrt( ( tangentValue * tangentValue )
+                                            + 1.0 ) );
+      rotationTangents[ laneIndex ] = tangentValue;
+      rotationCosines[ laneIndex ] = cosineValue;
+      rotationSines[ laneIndex ] = ( tangentValue * cosineValue );
+      ppValues[ laneIndex ] -= ( tangentValue * pqValue );
+      qqValues[ laneIndex ] += ( tangentValue * pqValue );
+      pqValues[ laneIndex ] = 0.0;
+      qpValues[ laneIndex ] = 0.0;
+    }
+    for( size_t kIndex( 0 );
+         kIndex < numberOfRows;
+         ++kIndex )
+    {
+      if( ( kIndex == pIndex )
+          ||
+          ( kIndex == qIndex ) )
+      {
+        continue;
+      }
+      double* const kpValues( &(elementsByLane[ ( ( kIndex * numberOfRows )
+                                                  + pIndex ) * batchSize ]) );
+      double* const kqValues( &(elementsByLane[ ( ( kIndex * numberOfRows )
+                                                  + qIndex ) * batchSize ]) );
+      double* const pkValues( &(elementsByLane[ ( ( pIndex * numberOfRows )
+                                                  + kIndex ) * batchSize ]) );
+      double* const qkValues( &(elementsByLane[ ( ( qIndex * numberOfRows )
+                                                  + kIndex ) * batchSize ]) );
+      for( size_t laneIndex( 0 );
+           laneIndex < batchSize;
+           ++laneIndex )
+      {
+        double const kpValue( kpValues[ laneIndex ] );
+        double const kqValue( kqValues[ laneIndex ] );
+        double const newKp( ( rotationCosines[ laneIndex ] * kpValue )
+                            - ( rotationSines[ laneIndex ] * kqValue ) );
+        double const newKq( ( rotationSines[ laneIndex ] * kpValue )
+                            + ( rotationCosines[ laneIndex ] * kqValue ) );
+        kpValues[ laneIndex ] = newKp;
+        pkValues[ laneIndex ] = newKp;
+        kqValues[ laneIndex ] = newKq;
+        qkValues[ laneIndex ] = newKq;
+      }
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* BATCHEDSYMMETRICEIGENVALUES_HPP_ */
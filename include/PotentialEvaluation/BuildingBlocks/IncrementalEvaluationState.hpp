@@ -0,0 +1,430 @@
+/*
+ * IncrementalEvaluationState.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef INCREMENTALEVALUATIONSTATE_HPP_
+#define INCREMENTALEVALUATIONSTATE_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <string>
+#include <sstream>
+#include "ParametersAndFieldsProductSum.hpp"
+#include "PotentialEvaluation/MassesSquaredCalculator.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace VevaciousPlusPlus
+{
+  // This class keeps the values of the terms of polynomial sums and the
+  // masses-squared of MassesSquaredCalculators for the last field
+  // configuration at which a potential was evaluated, so that the next
+  // evaluation only has to re-evaluate the terms and re-diagonalize the
+  // matrices which depend on fields whose values have changed. This suits
+  // the sequences of evaluations made by numerical derivatives and by
+  // coordinate-wise searches, where each configuration differs from the
+  // previous one in only one or two fields. The coefficients of the terms are
+  // already fixed for the parameter point by UpdateForFixedScale, so only the
+  // field products are re-evaluated. The results are exactly those of a full
+  // evaluation, as each term and each matrix is evaluated in the same way,
+  // and the terms are summed in the same order. As for
+  // PotentialEvaluationCache, the stored values are not safe to share between
+  // threads, so the state is bypassed inside OpenMP parallel regions.
+  class IncrementalEvaluationState
+  {
+  public:
+    typedef std::pair< std::vector< double >, double > DoubleVectorWithDouble;
+
+    IncrementalEvaluationState() :
+      isEnabled( false ),
+      hasPreviousConfiguration( false ),
+      previousConfiguration(),
+      changedFields(),
+      termValuesBySum(),
+      termIndicesByFieldBySum(),
+      massesSquaredByGroup(),
+      fieldDependenceByGroup(),
+      numberOfEvaluatedMatrices( 0 ),
+      numberOfReusedMatrices( 0 ) {}
+
+    // A copy is enabled if copySource is, but starts empty, as the copy may
+    // belong to a different potential (such as a tree-level copy of a
+    // loop-corrected potential) with different terms and masses-squared, so
+    // its first evaluation has to be a full one.
+    IncrementalEvaluationState(
+                               IncrementalEvaluationState const& copySource ) :
+      isEnabled( copySource.isEnabled ),
+      hasPreviousConfiguration( false ),
+      previousConfiguration(),
+      changedFields(),
+      termValuesBySum(),
+      termIndicesByFieldBySum(),
+      massesSquaredByGroup(),
+      fieldDependenceByGroup(),
+      numberOfEvaluatedMatrices( 0 ),
+      numberOfReusedMatrices( 0 ) {}
+
+    virtual ~IncrementalEvaluationState() {}
+
+
+    // This enables or disables incremental evaluation, and forgets the
+    // previous field configuration either way.
+    void SetEnabled( bool const enableIncrementalEvaluation )
+    { isEnabled = enableIncrementalEvaluation;
+      Clear(); }
+
+    bool IsEnabled() const { return isEnabled; }
+
+    // This forgets the previous field configuration, so that the next
+    // evaluation is a full one, and resets the statistics. It should be
+    // called whenever the potential changes, for example for a new parameter
+    // point.
+    void Clear();
+
+    // If incremental evaluation is enabled and this is not being called from
+    // within an OpenMP parallel region, this notes which fields have
+    // different values in fieldConfiguration from the previous configuration
+    // (all of them if there is none), makes fieldConfiguration the previous
+    // configuration, and returns true. Otherwise it returns false, and
+    // PolynomialValue and AddMassesSquaredWithMultiplicity must not be called
+    // for this configuration.
+    bool BeginConfiguration( std::vector< double > const& fieldConfiguration );
+
+    // This returns the value of polynomialSum for fieldConfiguration, which
+    // must be the configuration given to the last call of BeginConfiguration,
+    // re-evaluating only the terms with a non-zero power of a field which
+    // changed. Each polynomial sum must always be given with the same
+    // sumIndex, and different sums with different indices, and it must be
+    // given for every configuration given to BeginConfiguration.
+    double PolynomialValue( ParametersAndFieldsProductSum const& polynomialSum,
+                            size_t const sumIndex,
+                            std::vector< double > const& fieldConfiguration );
+
+    // This appends the masses-squared and multiplicity from each element of
+    // massesSquaredCalculators to massesSquaredWithFactors for
+    // fieldConfiguration, which must be the configuration given to the last
+    // call of BeginConfiguration, re-evaluating only the masses-squared of
+    // the calculators which depend on a field which changed. Each vector of
+    // calculators must always be given with the same groupIndex, and
+    // different vectors with different indices, and it must be given for
+    // every configuration given to BeginConfiguration.
+    void AddMassesSquaredWithMultiplicity(
+       std::vector< MassesSquaredCalculator* > const& massesSquaredCalculators,
+                                           size_t const groupIndex,
+                               std::vector< double > const& fieldConfiguration,
+              std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors );
+
+    size_t NumberOfEvaluatedMatrices() const
+    { return numberOfEvaluatedMatrices; }
+
+    size_t NumberOfReusedMatrices() const { return numberOfReusedMatrices; }
+
+    // This returns a human-readable summary of the numbers of matrices which
+    // were re-evaluated and re-used since the last call of Clear.
+    std::string StatisticsAsString() const;
+
+
+  protected:
+    bool isEnabled;
+    bool hasPreviousConfiguration;
+    std::vector< double > previousConfiguration;
+    // This has the indices of the fields which changed between the previous
+    // configuration and the one before it.
+    std::vector< size_t > changedFields;
+    // termValuesBySum[ s ][ t ] is the value of term t of the sum with index
+    // s for the previous configuration, and termIndicesByFieldBySum[ s ][ f ]
+    // lists the terms of that sum with a non-zero power of the field with
+    // index f.
+    std::vector< std::vector< double > > termValuesBySum;
+    std::vector< std::vector< std::vector< size_t > > >
+    termIndicesByFieldBySum;
+    // massesSquaredByGroup[ g ][ c ] holds the masses-squared of calculator c
+    // of the group with index g for the previous configuration, and
+    // fieldDependenceByGroup[ g ][ c ][ f ] is whether that calculator
+    // depends on the field with index f.
+    std::vector< std::vector< std::vector< double > > > massesSquaredByGroup;
+    std::vector< std::vector< std::vector< bool > > > fieldDependenceByGroup;
+    size_t numberOfEvaluatedMatrices;
+    size_t numberOfReusedMatrices;
+
+    // This returns true if incremental evaluation is enabled and this is not
+    // being called from within an OpenMP parallel region.
+    bool IsUsableHere() const
+    {
+#ifdef _OPENMP
+      return ( isEnabled && !(omp_in_parallel()) );
+#else
+      return isEnabled;
+#endif
+    }
+
+    // This returns true if fieldDependence is true for any field in
+    // changedFields.
+    bool
+    DependsOnChangedField( std::vector< bool > const& fieldDependence ) const;
+  };
+
+
+
+
+
+  // This forgets the previous field configuration, so that the next
+  // evaluation is a full one, and resets the statistics. It should be called
+  // whenever the potential changes, for example for a new parameter point.
+  inline void IncrementalEvaluationState::Clear()
+  {
+    // The values stored for the previous configuration are over-written by
+    // the next full evaluation, and which terms and calculators depend on
+    // which fields does not change with the parameter point, so only the
+    // previous configuration needs to be forgotten.
+    hasPreviousConfiguration = false;
+    previousConfiguration.clear();
+    changedFields.clear();
+    numberOfEvaluatedMatrices = 0;
+    numberOfReusedMatrices = 0;
+  }
+
+  // If incremental evaluation is enabled and this is not being called from
+  // within an OpenMP parallel region, this notes which fields have different
+  // values in fieldConfiguration from the previous configuration (all of them
+  // if there is none), makes fieldConfiguration the previous configuration,
+  // and returns true. Otherwise it returns false, and PolynomialValue and
+  // AddMassesSquaredWithMultiplicity must not be called for this
+  // configuration.
+  inline bool IncrementalEvaluationState::BeginConfiguration(
+                              std::vector< double > const& fieldConfiguration )
+  {
+    if( !(IsUsableHere()) )
+    {
+      return false;
+    }
+    changedFields.clear();
+    bool const isComparable( hasPreviousConfiguration
+                             &&
+                             ( previousConfiguration.size()
+                               == fieldConfiguration.size() ) );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldConfiguration.size();
+         ++fieldIndex )
+    {
+      if( !isComparable
+          ||
+          ( fieldConfiguration[ fieldIndex ]
+            != previousConfiguration[ fieldIndex ] ) )
+      {
+        changedFields.push_back( fieldIndex );
+      }
+    }
+    if( !isComparable )
+    {
+      // Nothing stored so far can be trusted, so the stored values are
+      // dropped and re-filled by full evaluations.
+      termValuesBySum.clear();
+      massesSquaredByGroup.clear();
+    }
+    previousConfiguration = fieldConfiguration;
+    hasPreviousConfiguration = true;
+    return true;
+  }
+
+  // This returns the value of polynomialSum for fieldConfiguration, which must
+  // be the configuration given to the last call of BeginConfiguration,
+  // re-evaluating only the terms with a non-zero power of a field which
+  // changed. Each polynomial sum must always be given with the same sumIndex,
+  // and different sums with different indices, and it must be given for every
+  // configuration given to BeginConfiguration.
+  inline double IncrementalEvaluationState::PolynomialValue(
+                            ParametersAndFieldsProductSum const& polynomialSum,
+                                                        size_t const sumIndex,
+                              std::vector< double > const& fieldConfiguration )
+  {
+    std::vector< ParametersAndFieldsProductTerm > const&
+    polynomialTerms( polynomialSum.ParametersAndFieldsProducts() );
+    size_t const numberOfFields( fieldConfiguration.size() );
+    if( termIndicesByFieldBySum.size() <= sumIndex )
+    {
+      termIndicesByFieldBySum.resize( sumIndex + 1 );
+    }
+    std::vector< std::vector< size_t > >&
+    termIndicesByField( termIndicesByFieldBySum[ sumIndex ] );
+    if( termIndicesByField.size() != numberOfFields )
+    {
+      termIndicesByField.assign( numberOfFields,
+                                 std::vector< size_t >() );
+      for( size_t termIndex( 0 );
+           termIndex < polynomialTerms.size();
+           ++termIndex )
+      {
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          if( polynomialTerms[ termIndex ].NonZeroDerivative( fieldIndex ) )
+          {
+            termIndicesByField[ fieldIndex ].push_back( termIndex );
+          }
+        }
+      }
+    }
+    if( termValuesBySum.size() <= sumIndex )
+    {
+      termValuesBySum.resize( sumIndex + 1 );
+    }
+    std::vector< double >& termValues( termValuesBySum[ sumIndex ] );
+    if( termValues.size() != polynomialTerms.size() )
+    {
+      termValues.resize( polynomialTerms.size() );
+      for( size_t termIndex( 0 );
+           termIndex < polynomialTerms.size();
+           ++termIndex )
+      {
+        termValues[ termIndex ]
+        = polynomialTerms[ termIndex ]( fieldConfiguration );
+      }
+    }
+    else
+    {
+      // A term with more than one changed field is just evaluated more than
+      // once.
+      for( std::vector< size_t >::const_iterator
+           changedField( changedFields.begin() );
+           changedField < changedFields.end();
+           ++changedField )
+      {
+        std::vector< size_t > const&
+        termIndices( termIndicesByField[ *changedField ] );
+        for( std::vector< size_t >::const_iterator
+             termIndex( termIndices.begin() );
+             termIndex < termIndices.end();
+             ++termIndex )
+        {
+          termValues[ *termIndex ]
+          = polynomialTerms[ *termIndex ]( fieldConfiguration );
+        }
+      }
+    }
+    double returnSum( 0.0 );
+    for( std::vector< double >::const_iterator
+         termValue( termValues.begin() );
+         termValue < termValues.end();
+         ++termValue )
+    {
+      returnSum += *termValue;
+    }
+    return returnSum;
+  }
+
+  // This appends the masses-squared and multiplicity from each element of
+  // massesSquaredCalculators to massesSquaredWithFactors for
+  // fieldConfiguration, which must be the configuration given to the last
+  // call of BeginConfiguration, re-evaluating only the masses-squared of the
+  // calculators which depend on a field which changed. Each vector of
+  // calculators must always be given with the same groupIndex, and different
+  // vectors with different indices, and it must be given for every
+  // configuration given to BeginConfiguration.
+  inline void IncrementalEvaluationState::AddMassesSquaredWithMultiplicity(
+       std::vector< MassesSquaredCalculator* > const& massesSquaredCalculators,
+                                                       size_t const groupIndex,
+                               std::vector< double > const& fieldConfiguration,
+               std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors )
+  {
+    size_t const numberOfCalculators( massesSquaredCalculators.size() );
+    size_t const numberOfFields( fieldConfiguration.size() );
+    if( fieldDependenceByGroup.size() <= groupIndex )
+    {
+      fieldDependenceByGroup.resize( groupIndex + 1 );
+    }
+    std::vector< std::vector< bool > >&
+    fieldDependence( fieldDependenceByGroup[ groupIndex ] );
+    if( ( fieldDependence.size() != numberOfCalculators )
+        ||
+        ( !(fieldDependence.empty())
+          &&
+          ( fieldDependence.front().size() != numberOfFields ) ) )
+    {
+      fieldDependence.assign( numberOfCalculators,
+                              std::vector< bool >( numberOfFields ) );
+      for( size_t calculatorIndex( 0 );
+           calculatorIndex < numberOfCalculators;
+           ++calculatorIndex )
+      {
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          fieldDependence[ calculatorIndex ][ fieldIndex ]
+          = massesSquaredCalculators[ calculatorIndex ]->DependsOnField(
+                                                                  fieldIndex );
+        }
+      }
+    }
+    if( massesSquaredByGroup.size() <= groupIndex )
+    {
+      massesSquaredByGroup.resize( groupIndex + 1 );
+    }
+    std::vector< std::vector< double > >&
+    massesSquared( massesSquaredByGroup[ groupIndex ] );
+    bool const evaluateAll( massesSquared.size() != numberOfCalculators );
+    massesSquared.resize( numberOfCalculators );
+    for( size_t calculatorIndex( 0 );
+         calculatorIndex < numberOfCalculators;
+         ++calculatorIndex )
+    {
+      MassesSquaredCalculator const&
+      massesSquaredCalculator( *(massesSquaredCalculators[ calculatorIndex ]) );
+      if( evaluateAll
+          ||
+          DependsOnChangedField( fieldDependence[ calculatorIndex ] ) )
+      {
+        massesSquared[ calculatorIndex ]
+        = massesSquaredCalculator.MassesSquared( fieldConfiguration );
+        ++numberOfEvaluatedMatrices;
+      }
+      else
+      {
+        ++numberOfReusedMatrices;
+      }
+      massesSquaredWithFactors.push_back(
+                          std::make_pair( massesSquared[ calculatorIndex ],
+                               massesSquaredCalculator.MultiplicityFactor() ) );
+    }
+  }
+
+  // This returns a human-readable summary of the numbers of matrices which
+  // were re-evaluated and re-used since the last call of Clear.
+  inline std::string IncrementalEvaluationState::StatisticsAsString() const
+  {
+    std::stringstream stringBuilder;
+    stringBuilder
+    << "Incremental evaluation: " << numberOfEvaluatedMatrices
+    << " mass-squared matrices evaluated, " << numberOfReusedMatrices
+    << " re-used.";
+    return stringBuilder.str();
+  }
+
+  // This returns true if fieldDependence is true for any field in
+  // changedFields.
+  inline bool IncrementalEvaluationState::DependsOnChangedField(
+                          std::vector< bool > const& fieldDependence ) const
+  {
+    for( std::vector< size_t >::const_iterator
+         changedField( changedFields.begin() );
+         changedField < changedFields.end();
+         ++changedField )
+    {
+      if( fieldDependence[ *changedField ] )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* INCREMENTALEVALUATIONSTATE_HPP_ */
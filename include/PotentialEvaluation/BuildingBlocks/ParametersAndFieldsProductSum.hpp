@@ -12,6 +12,8 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <cmath>
+#include <limits>
 
 namespace VevaciousPlusPlus
 {
@@ -41,6 +43,52 @@ namespace VevaciousPlusPlus
     // parametersAndFieldsProducts.
     double operator()( std::vector< double > const& fieldConfiguration ) const;
 
+    // This adds the sum of the terms for each of a batch of field
+    // configurations to the corresponding element of batchSums, using the
+    // values of the Lagrangian parameters from the last call of
+    // UpdateForFixedScale. The configurations are given in
+    // structure-of-arrays form, so fieldValuesByIndex[ f ][ c ] is the value
+    // of the field with index f in configuration c. Each term is traversed
+    // once for the whole batch rather than once per configuration.
+    void AddToBatch(
+               std::vector< std::vector< double > > const& fieldValuesByIndex,
+                     std::vector< double >& batchSums ) const;
+
+    // This calls AddFixedScaleDerivatives on each element of
+    // parametersAndFieldsProducts, so adding the gradient and the Hessian of
+    // the sum with respect to the fields at fieldConfiguration to
+    // gradientVector and hessianMatrix (just the gradient if hessianMatrix is
+    // empty).
+    void AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                   std::vector< double >& gradientVector,
+                    std::vector< std::vector< double > >& hessianMatrix ) const;
+
+    // This calls AddRunningScaleGradient on each element of
+    // parametersAndFieldsProducts, so adding the gradient of the sum with
+    // respect to the fields at fieldConfiguration, with the Lagrangian
+    // parameters given by parameterValues, to the first elements of
+    // gradientVector, and its derivative with respect to the logarithm of the
+    // scale through the parameters, given their derivatives in
+    // parameterScaleDerivatives, to the last element.
+    void AddRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                           std::vector< double >& gradientVector ) const;
+
+    // This sets lowerBound and upperBound to bounds on the value of the sum
+    // over the box of field configurations where each field with index f lies
+    // between lowerFieldBounds[ f ] and upperFieldBounds[ f ], using the
+    // values of the Lagrangian parameters in parameterValues, by adding the
+    // interval bounds of each element of parametersAndFieldsProducts, with
+    // each sum rounded outwards.
+    void IntervalBounds( std::vector< double > const& parameterValues,
+                         std::vector< double > const& lowerFieldBounds,
+                         std::vector< double > const& upperFieldBounds,
+                         double& lowerBound,
+                         double& upperBound ) const;
+
     std::vector< ParametersAndFieldsProductTerm > const&
     ParametersAndFieldsProducts() const
     { return parametersAndFieldsProducts; }
@@ -52,6 +100,20 @@ namespace VevaciousPlusPlus
     // parametersAndFieldsProducts.
     unsigned int HighestFieldPower() const;
 
+    // This returns true if every term in parametersAndFieldsProducts is
+    // identically zero, including when there are no terms at all.
+    bool IsZero() const;
+
+    // This returns true if otherSum has the same number of terms as this sum
+    // and each of its terms has the same structure as the term in the same
+    // position in this sum, as is the case for sums read from identical
+    // strings, so that the two sums always have the same value.
+    bool HasSameTermsAs( ParametersAndFieldsProductSum const& otherSum ) const;
+
+    // This returns true if any term in parametersAndFieldsProducts has a
+    // non-zero power of the field with index fieldIndex.
+    bool DependsOnField( size_t const fieldIndex ) const;
+
     // This returns a string that should be valid Python assuming that the
     // field configuration is given as an array called "fv" and that the
     // Lagrangian parameters are in an array called "lp".
@@ -117,6 +179,168 @@ namespace VevaciousPlusPlus
     return returnSum;
   }
 
+  // This adds the sum of the terms for each of a batch of field
+  // configurations to the corresponding element of batchSums, using the
+  // values of the Lagrangian parameters from the last call of
+  // UpdateForFixedScale. The configurations are given in structure-of-arrays
+  // form, so fieldValuesByIndex[ f ][ c ] is the value of the field with index
+  // f in configuration c. Each term is traversed once for the whole batch
+  // rather than once per configuration.
+  inline void ParametersAndFieldsProductSum::AddToBatch(
+               std::vector< std::vector< double > > const& fieldValuesByIndex,
+                                      std::vector< double >& batchSums ) const
+  {
+    std::vector< double > laneProducts( batchSums.size() );
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      parametersAndFieldsProduct->AddToBatch( fieldValuesByIndex,
+                                              laneProducts,
+                                              batchSums );
+    }
+  }
+
+  // This calls AddFixedScaleDerivatives on each element of
+  // parametersAndFieldsProducts, so adding the gradient and the Hessian of the
+  // sum with respect to the fields at fieldConfiguration to gradientVector and
+  // hessianMatrix (just the gradient if hessianMatrix is empty).
+  inline void ParametersAndFieldsProductSum::AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                         std::vector< double >& gradientVector,
+                     std::vector< std::vector< double > >& hessianMatrix ) const
+  {
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      parametersAndFieldsProduct->AddFixedScaleDerivatives( fieldConfiguration,
+                                                            gradientVector,
+                                                            hessianMatrix );
+    }
+  }
+
+  // This calls AddRunningScaleGradient on each element of
+  // parametersAndFieldsProducts, so adding the gradient of the sum with respect
+  // to the fields at fieldConfiguration, with the Lagrangian parameters given
+  // by parameterValues, to the first elements of gradientVector, and its
+  // derivative with respect to the logarithm of the scale through the
+  // parameters, given their derivatives in parameterScaleDerivatives, to the
+  // last element.
+  inline void ParametersAndFieldsProductSum::AddRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                  std::vector< double >& gradientVector ) const
+  {
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      parametersAndFieldsProduct->AddRunningScaleGradient( parameterValues,
+                                                     parameterScaleDerivatives,
+                                                          fieldConfiguration,
+                                                          gradientVector );
+    }
+  }
+
+  // This sets lowerBound and upperBound to bounds on the value of the sum over
+  // the box of field configurations where each field with index f lies
+  // between lowerFieldBounds[ f ] and upperFieldBounds[ f ], using the values
+  // of the Lagrangian parameters in parameterValues, by adding the interval
+  // bounds of each element of parametersAndFieldsProducts, with each sum
+  // rounded outwards.
+  inline void ParametersAndFieldsProductSum::IntervalBounds(
+                                  std::vector< double > const& parameterValues,
+                                 std::vector< double > const& lowerFieldBounds,
+                                 std::vector< double > const& upperFieldBounds,
+                                                           double& lowerBound,
+                                                double& upperBound ) const
+  {
+    lowerBound = 0.0;
+    upperBound = 0.0;
+    double termLower( 0.0 );
+    double termUpper( 0.0 );
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      parametersAndFieldsProduct->IntervalBounds( parameterValues,
+                                                  lowerFieldBounds,
+                                                  upperFieldBounds,
+                                                  termLower,
+                                                  termUpper );
+      lowerBound = std::nextafter( ( lowerBound + termLower ),
+                                 -std::numeric_limits< double >::infinity() );
+      upperBound = std::nextafter( ( upperBound + termUpper ),
+                                   std::numeric_limits< double >::infinity() );
+    }
+  }
+
+  // This returns true if every term in parametersAndFieldsProducts is
+  // identically zero, including when there are no terms at all.
+  inline bool ParametersAndFieldsProductSum::IsZero() const
+  {
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      if( !(parametersAndFieldsProduct->IsZero()) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // This returns true if otherSum has the same number of terms as this sum and
+  // each of its terms has the same structure as the term in the same position
+  // in this sum, as is the case for sums read from identical strings, so that
+  // the two sums always have the same value.
+  inline bool ParametersAndFieldsProductSum::HasSameTermsAs(
+                          ParametersAndFieldsProductSum const& otherSum ) const
+  {
+    if( otherSum.parametersAndFieldsProducts.size()
+        != parametersAndFieldsProducts.size() )
+    {
+      return false;
+    }
+    for( size_t termIndex( 0 );
+         termIndex < parametersAndFieldsProducts.size();
+         ++termIndex )
+    {
+      if( !(parametersAndFieldsProducts[ termIndex ].HasSameStructureAs(
+                       otherSum.parametersAndFieldsProducts[ termIndex ] )) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // This returns true if any term in parametersAndFieldsProducts has a
+  // non-zero power of the field with index fieldIndex.
+  inline bool
+  ParametersAndFieldsProductSum::DependsOnField( size_t const fieldIndex ) const
+  {
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         parametersAndFieldsProduct( parametersAndFieldsProducts.begin() );
+         parametersAndFieldsProduct < parametersAndFieldsProducts.end();
+         ++parametersAndFieldsProduct )
+    {
+      if( parametersAndFieldsProduct->NonZeroDerivative( fieldIndex ) )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
   // This returns the highest sum of field powers of all the terms in
   // parametersAndFieldsProducts.
   inline unsigned int ParametersAndFieldsProductSum::HighestFieldPower() const
@@ -13,6 +13,9 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace VevaciousPlusPlus
 {
@@ -64,6 +67,59 @@ namespace VevaciousPlusPlus
                              fieldConfiguration,
                              fieldProductByIndex ); }
 
+    // This adds the value of this term for each of a batch of field
+    // configurations to the corresponding element of batchSums, using the
+    // values of the Lagrangian parameters from the last call of
+    // UpdateForFixedScale. The configurations are given in
+    // structure-of-arrays form, so fieldValuesByIndex[ f ][ c ] is the value
+    // of the field with index f in configuration c, which keeps the inner
+    // loops contiguous so that the compiler can vectorize them over the
+    // configurations. laneProducts is used as workspace and must have the
+    // same size as batchSums.
+    void AddToBatch(
+         std::vector< std::vector< double > > const& fieldValuesByIndex,
+                     std::vector< double >& laneProducts,
+                     std::vector< double >& batchSums ) const;
+
+    // This adds the partial derivatives of this term with respect to each of
+    // the fields at fieldConfiguration to gradientVector and the second
+    // partial derivatives to hessianMatrix, using the values of the
+    // Lagrangian parameters from the last call of UpdateForFixedScale.
+    // gradientVector must already have the size of fieldConfiguration, as must
+    // hessianMatrix unless it is empty, in which case only the gradient is
+    // added.
+    void AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                   std::vector< double >& gradientVector,
+                    std::vector< std::vector< double > >& hessianMatrix ) const;
+
+    // This adds the partial derivatives of this term with respect to each of
+    // the fields at fieldConfiguration to the first elements of
+    // gradientVector, using the values of the Lagrangian parameters in
+    // parameterValues, and adds the derivative of the term with respect to the
+    // logarithm of the scale, which comes only through the Lagrangian
+    // parameters, using their derivatives in parameterScaleDerivatives, to the
+    // last element of gradientVector, which must already have one more element
+    // than fieldConfiguration.
+    void AddRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                           std::vector< double >& gradientVector ) const;
+
+    // This sets lowerBound and upperBound to bounds on the value of this term
+    // over the box of field configurations where each field with index f lies
+    // between lowerFieldBounds[ f ] and upperFieldBounds[ f ], using the
+    // values of the Lagrangian parameters in parameterValues. The bounds come
+    // from interval arithmetic with every product rounded outwards, so they
+    // always enclose the true range of the term over the box, even allowing
+    // for floating-point rounding, though they may be wider than it.
+    void IntervalBounds( std::vector< double > const& parameterValues,
+                         std::vector< double > const& lowerFieldBounds,
+                         std::vector< double > const& upperFieldBounds,
+                         double& lowerBound,
+                         double& upperBound ) const;
+
     // This raises the power of the field given by fieldIndex by the number
     // given by powerInt.
     void RaiseFieldPower( size_t const fieldIndex,
@@ -93,6 +149,18 @@ namespace VevaciousPlusPlus
     // constructed.
     void ResetValues();
 
+    // This returns true if the term is identically zero, which is the case
+    // when its constant coefficient is zero (such as for a matrix element
+    // written as "0" in the model file).
+    bool IsZero() const { return ( coefficientConstant == 0.0 ); }
+
+    // This returns true if otherTerm has the same constant coefficient, the
+    // same powers of the same fields and the same Lagrangian parameters
+    // (possibly multiplied in a different order) as this term, so that the
+    // two always have the same value.
+    bool HasSameStructureAs(
+                       ParametersAndFieldsProductTerm const& otherTerm ) const;
+
     // This returns true if the field with index fieldIndex has a non-zero
     // power.
     bool NonZeroDerivative( size_t const fieldIndex ) const
@@ -136,6 +204,23 @@ namespace VevaciousPlusPlus
                                   std::vector< double > const& valueVector,
                                   std::vector< size_t > const& indexVector );
 
+    // This sets lowerBound and upperBound to the smallest and largest of the
+    // products of an end of the interval they define with an end of the
+    // interval from otherLower to otherUpper, each moved outwards by one unit
+    // in the last place so that the rounding of the products cannot make the
+    // new interval too narrow.
+    static void MultiplyIntervals( double& lowerBound,
+                                   double& upperBound,
+                                   double const otherLower,
+                                   double const otherUpper );
+
+    // This sets lowerBound and upperBound to bounds on baseValue raised to
+    // the power given by powerInt, from repeated calls of MultiplyIntervals.
+    static void PowerBounds( double const baseValue,
+                             unsigned int const powerInt,
+                             double& lowerBound,
+                             double& upperBound );
+
     bool isValid;
     double coefficientConstant;
     std::vector< size_t > fieldProductByIndex;
@@ -149,6 +234,296 @@ namespace VevaciousPlusPlus
 
 
 
+  // This adds the value of this term for each of a batch of field
+  // configurations to the corresponding element of batchSums, using the
+  // values of the Lagrangian parameters from the last call of
+  // UpdateForFixedScale. The configurations are given in structure-of-arrays
+  // form, so fieldValuesByIndex[ f ][ c ] is the value of the field with
+  // index f in configuration c, which keeps the inner loops contiguous so that
+  // the compiler can vectorize them over the configurations. laneProducts is
+  // used as workspace and must have the same size as batchSums.
+  inline void ParametersAndFieldsProductTerm::AddToBatch(
+               std::vector< std::vector< double > > const& fieldValuesByIndex,
+                                           std::vector< double >& laneProducts,
+                                      std::vector< double >& batchSums ) const
+  {
+    size_t const batchSize( batchSums.size() );
+    double* const laneProduct( laneProducts.data() );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      laneProduct[ laneIndex ] = totalCoefficientForFixedScale;
+    }
+    for( std::vector< size_t >::const_iterator
+         fieldIndex( fieldProductByIndex.begin() );
+         fieldIndex < fieldProductByIndex.end();
+         ++fieldIndex )
+    {
+      double const* const
+      fieldValues( fieldValuesByIndex[ *fieldIndex ].data() );
+      for( size_t laneIndex( 0 );
+           laneIndex < batchSize;
+           ++laneIndex )
+      {
+        laneProduct[ laneIndex ] *= fieldValues[ laneIndex ];
+      }
+    }
+    double* const batchSum( batchSums.data() );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      batchSum[ laneIndex ] += laneProduct[ laneIndex ];
+    }
+  }
+
+  // This adds the partial derivatives of this term with respect to each of the
+  // fields at fieldConfiguration to gradientVector and the second partial
+  // derivatives to hessianMatrix, using the values of the Lagrangian
+  // parameters from the last call of UpdateForFixedScale. gradientVector must
+  // already have the size of fieldConfiguration, as must hessianMatrix unless
+  // it is empty, in which case only the gradient is added. Each factor in
+  // fieldProductByIndex is differentiated in turn (and each ordered pair of
+  // different factors for the second derivatives), which takes care of the
+  // powers without dividing by field values which might be zero.
+  inline void ParametersAndFieldsProductTerm::AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                         std::vector< double >& gradientVector,
+                     std::vector< std::vector< double > >& hessianMatrix ) const
+  {
+    size_t const numberOfFactors( fieldProductByIndex.size() );
+    bool const addSecondDerivatives( !(hessianMatrix.empty()) );
+    for( size_t firstFactor( 0 );
+         firstFactor < numberOfFactors;
+         ++firstFactor )
+    {
+      double firstDerivative( totalCoefficientForFixedScale );
+      for( size_t otherFactor( 0 );
+           otherFactor < numberOfFactors;
+           ++otherFactor )
+      {
+        if( otherFactor != firstFactor )
+        {
+          firstDerivative
+          *= fieldConfiguration[ fieldProductByIndex[ otherFactor ] ];
+        }
+      }
+      gradientVector[ fieldProductByIndex[ firstFactor ] ] += firstDerivative;
+      for( size_t secondFactor( 0 );
+           addSecondDerivatives && ( secondFactor < numberOfFactors );
+           ++secondFactor )
+      {
+        if( secondFactor == firstFactor )
+        {
+          continue;
+        }
+        double secondDerivative( totalCoefficientForFixedScale );
+        for( size_t otherFactor( 0 );
+             otherFactor < numberOfFactors;
+             ++otherFactor )
+        {
+          if( ( otherFactor != firstFactor )
+              &&
+              ( otherFactor != secondFactor ) )
+          {
+            secondDerivative
+            *= fieldConfiguration[ fieldProductByIndex[ otherFactor ] ];
+          }
+        }
+        hessianMatrix[ fieldProductByIndex[ firstFactor ] ][
+                       fieldProductByIndex[ secondFactor ] ] += secondDerivative;
+      }
+    }
+  }
+
+  // This adds the partial derivatives of this term with respect to each of the
+  // fields at fieldConfiguration to the first elements of gradientVector,
+  // using the values of the Lagrangian parameters in parameterValues, and adds
+  // the derivative of the term with respect to the logarithm of the scale,
+  // which comes only through the Lagrangian parameters, using their
+  // derivatives in parameterScaleDerivatives, to the last element of
+  // gradientVector, which must already have one more element than
+  // fieldConfiguration. As for the fields, each parameter factor is
+  // differentiated in turn, so no parameter values are divided by.
+  inline void ParametersAndFieldsProductTerm::AddRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                  std::vector< double >& gradientVector ) const
+  {
+    double const coefficientFactor( CoefficientFactor( parameterValues ) );
+    size_t const numberOfFactors( fieldProductByIndex.size() );
+    for( size_t firstFactor( 0 );
+         firstFactor < numberOfFactors;
+         ++firstFactor )
+    {
+      double firstDerivative( coefficientFactor );
+      for( size_t otherFactor( 0 );
+           otherFactor < numberOfFactors;
+           ++otherFactor )
+      {
+        if( otherFactor != firstFactor )
+        {
+          firstDerivative
+          *= fieldConfiguration[ fieldProductByIndex[ otherFactor ] ];
+        }
+      }
+      gradientVector[ fieldProductByIndex[ firstFactor ] ] += firstDerivative;
+    }
+    size_t const numberOfParameters( parameterIndices.size() );
+    double coefficientScaleDerivative( 0.0 );
+    for( size_t scaleFactor( 0 );
+         scaleFactor < numberOfParameters;
+         ++scaleFactor )
+    {
+      size_t const scaleIndex( parameterIndices[ scaleFactor ] );
+      double scaleDerivative( coefficientConstant
+                              * parameterScaleDerivatives[ scaleIndex ] );
+      for( size_t otherFactor( 0 );
+           otherFactor < numberOfParameters;
+           ++otherFactor )
+      {
+        if( otherFactor != scaleFactor )
+        {
+          scaleDerivative *= parameterValues[ parameterIndices[ otherFactor ] ];
+        }
+      }
+      coefficientScaleDerivative += scaleDerivative;
+    }
+    gradientVector[ fieldConfiguration.size() ]
+    += ElementProduct( coefficientScaleDerivative,
+                       fieldConfiguration,
+                       fieldProductByIndex );
+  }
+
+  // This sets lowerBound and upperBound to bounds on the value of this term
+  // over the box of field configurations where each field with index f lies
+  // between lowerFieldBounds[ f ] and upperFieldBounds[ f ], using the values
+  // of the Lagrangian parameters in parameterValues. The bounds come from
+  // interval arithmetic with every product rounded outwards, so they always
+  // enclose the true range of the term over the box, even allowing for
+  // floating-point rounding, though they may be wider than it.
+  inline void ParametersAndFieldsProductTerm::IntervalBounds(
+                                  std::vector< double > const& parameterValues,
+                                 std::vector< double > const& lowerFieldBounds,
+                                 std::vector< double > const& upperFieldBounds,
+                                                           double& lowerBound,
+                                                double& upperBound ) const
+  {
+    lowerBound = coefficientConstant;
+    upperBound = coefficientConstant;
+    for( std::vector< size_t >::const_iterator
+         parameterIndex( parameterIndices.begin() );
+         parameterIndex < parameterIndices.end();
+         ++parameterIndex )
+    {
+      MultiplyIntervals( lowerBound,
+                         upperBound,
+                         parameterValues[ *parameterIndex ],
+                         parameterValues[ *parameterIndex ] );
+    }
+    for( size_t fieldIndex( 0 );
+         fieldIndex < fieldPowersByIndex.size();
+         ++fieldIndex )
+    {
+      unsigned int const fieldPower( fieldPowersByIndex[ fieldIndex ] );
+      if( fieldPower == 0 )
+      {
+        continue;
+      }
+      double lowerEndLower( 1.0 );
+      double lowerEndUpper( 1.0 );
+      PowerBounds( lowerFieldBounds[ fieldIndex ],
+                   fieldPower,
+                   lowerEndLower,
+                   lowerEndUpper );
+      double upperEndLower( 1.0 );
+      double upperEndUpper( 1.0 );
+      PowerBounds( upperFieldBounds[ fieldIndex ],
+                   fieldPower,
+                   upperEndLower,
+                   upperEndUpper );
+      // A power of the field is monotonic on either side of zero, so its
+      // range over the interval is covered by the bounds on the powers of
+      // the ends, except that an even power of an interval which straddles
+      // zero has zero as its minimum.
+      double lowerPower( std::min( lowerEndLower,
+                                   upperEndLower ) );
+      double const upperPower( std::max( lowerEndUpper,
+                                         upperEndUpper ) );
+      if( ( ( fieldPower % 2 ) == 0 )
+          &&
+          ( lowerFieldBounds[ fieldIndex ] < 0.0 )
+          &&
+          ( upperFieldBounds[ fieldIndex ] > 0.0 ) )
+      {
+        lowerPower = 0.0;
+      }
+      MultiplyIntervals( lowerBound,
+                         upperBound,
+                         lowerPower,
+                         upperPower );
+    }
+  }
+
+  // This sets lowerBound and upperBound to the smallest and largest of the
+  // products of an end of the interval they define with an end of the
+  // interval from otherLower to otherUpper, each moved outwards by one unit in
+  // the last place so that the rounding of the products cannot make the new
+  // interval too narrow.
+  inline void
+  ParametersAndFieldsProductTerm::MultiplyIntervals( double& lowerBound,
+                                                     double& upperBound,
+                                                     double const otherLower,
+                                                     double const otherUpper )
+  {
+    double const endProducts[ 4 ] = { ( lowerBound * otherLower ),
+                                      ( lowerBound * otherUpper ),
+                                      ( upperBound * otherLower ),
+                                      ( upperBound * otherUpper ) };
+    lowerBound = endProducts[ 0 ];
+    upperBound = endProducts[ 0 ];
+    for( size_t productIndex( 1 );
+         productIndex < 4;
+         ++productIndex )
+    {
+      if( endProducts[ productIndex ] < lowerBound )
+      {
+        lowerBound = endProducts[ productIndex ];
+      }
+      else if( endProducts[ productIndex ] > upperBound )
+      {
+        upperBound = endProducts[ productIndex ];
+      }
+    }
+    lowerBound = std::nextafter( lowerBound,
+                                 -std::numeric_limits< double >::infinity() );
+    upperBound = std::nextafter( upperBound,
+                                 std::numeric_limits< double >::infinity() );
+  }
+
+  // This sets lowerBound and upperBound to bounds on baseValue raised to the
+  // power given by powerInt, from repeated calls of MultiplyIntervals.
+  inline void
+  ParametersAndFieldsProductTerm::PowerBounds( double const baseValue,
+                                               unsigned int const powerInt,
+                                               double& lowerBound,
+                                               double& upperBound )
+  {
+    lowerBound = 1.0;
+    upperBound = 1.0;
+    for( unsigned int powerCount( 0 );
+         powerCount < powerInt;
+         ++powerCount )
+    {
+      MultiplyIntervals( lowerBound,
+                         upperBound,
+                         baseValue,
+                         baseValue );
+    }
+  }
+
   // This raises the power of the field given by fieldIndex by the number
   // given by powerInt.
   inline void
@@ -179,6 +554,27 @@ namespace VevaciousPlusPlus
   }
 
 
+  // This returns true if otherTerm has the same constant coefficient, the
+  // same powers of the same fields and the same Lagrangian parameters
+  // (possibly multiplied in a different order) as this term, so that the two
+  // always have the same value.
+  inline bool ParametersAndFieldsProductTerm::HasSameStructureAs(
+                        ParametersAndFieldsProductTerm const& otherTerm ) const
+  {
+    return ( ( isValid == otherTerm.isValid )
+             &&
+             ( coefficientConstant == otherTerm.coefficientConstant )
+             &&
+             ( fieldPowersByIndex == otherTerm.fieldPowersByIndex )
+             &&
+             ( parameterIndices.size() == otherTerm.parameterIndices.size() )
+             &&
+             std::is_permutation( parameterIndices.begin(),
+                                  parameterIndices.end(),
+                                  otherTerm.parameterIndices.begin() ) );
+  }
+
+
   // This returns doubleToMultiply multiplied by the field product using the
   // values in fieldConfiguration.
   inline double
@@ -0,0 +1,272 @@
+/*
+ * PotentialEvaluationCache.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef POTENTIALEVALUATIONCACHE_HPP_
+#define POTENTIALEVALUATIONCACHE_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <sstream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace VevaciousPlusPlus
+{
+  // This class stores a bounded number of values of a potential keyed by the
+  // exact field configuration and temperature at which they were evaluated,
+  // so that repeated evaluations at identical points (such as vacuum
+  // positions and path end-points) do not pay the full cost again. It is
+  // direct-mapped: each key hashes to a single slot, and storing a new value
+  // overwrites whatever was in that slot, so the memory used never grows
+  // beyond the number of slots given to SetNumberOfSlots. A cache with no
+  // slots is disabled, and does not count look-ups. The slots are not safe to
+  // share between threads, so the cache is also bypassed inside OpenMP
+  // parallel regions.
+  class PotentialEvaluationCache
+  {
+  public:
+    PotentialEvaluationCache() :
+      cacheSlots(),
+      numberOfLookUps( 0 ),
+      numberOfHits( 0 ) {}
+
+    // A copy gets the same number of slots but starts empty, as the copy
+    // may belong to a different potential (such as a tree-level copy of a
+    // loop-corrected potential) which would give different values for the
+    // same keys.
+    PotentialEvaluationCache( PotentialEvaluationCache const& copySource ) :
+      cacheSlots( copySource.cacheSlots.size() ),
+      numberOfLookUps( 0 ),
+      numberOfHits( 0 ) {}
+
+    virtual ~PotentialEvaluationCache() {}
+
+
+    // This empties the cache and sets it to have numberOfSlots slots. Setting
+    // the number of slots to 0 disables the cache.
+    void SetNumberOfSlots( size_t const numberOfSlots );
+
+    bool IsEnabled() const { return !(cacheSlots.empty()); }
+
+    // This empties all the slots and resets the look-up statistics, and
+    // should be called whenever the potential changes, for example for a new
+    // parameter point.
+    void Clear();
+
+    // This returns true and puts the stored value into potentialValue if the
+    // cache has a value for exactly the given fieldConfiguration and
+    // temperatureValue, and returns false otherwise.
+    bool LookUp( std::vector< double > const& fieldConfiguration,
+                 double const temperatureValue,
+                 double& potentialValue );
+
+    // This stores potentialValue for fieldConfiguration and
+    // temperatureValue, over-writing whatever was in the slot for that key.
+    void Store( std::vector< double > const& fieldConfiguration,
+                double const temperatureValue,
+                double const potentialValue );
+
+    size_t NumberOfLookUps() const { return numberOfLookUps; }
+
+    size_t NumberOfHits() const { return numberOfHits; }
+
+    // This returns the fraction of look-ups since the last call of Clear
+    // which found a stored value, or 0 if there have been no look-ups.
+    double HitRate() const
+    { return ( ( numberOfLookUps > 0 ) ?
+               ( static_cast< double >( numberOfHits )
+                 / static_cast< double >( numberOfLookUps ) ) :
+               0.0 ); }
+
+    // This returns a human-readable summary of the look-up statistics.
+    std::string StatisticsAsString() const;
+
+
+  protected:
+    struct CacheSlot
+    {
+      CacheSlot() :
+        isFilled( false ),
+        fieldConfiguration(),
+        temperatureValue( 0.0 ),
+        potentialValue( 0.0 ) {}
+
+      bool isFilled;
+      std::vector< double > fieldConfiguration;
+      double temperatureValue;
+      double potentialValue;
+    };
+
+    std::vector< CacheSlot > cacheSlots;
+    size_t numberOfLookUps;
+    size_t numberOfHits;
+
+    // This returns a hash of the bit patterns of the field values and the
+    // temperature, so that only exactly equal keys are ever treated as the
+    // same.
+    static uint64_t HashOf( std::vector< double > const& fieldConfiguration,
+                            double const temperatureValue );
+
+    // This mixes the bit pattern of doubleValue into hashValue.
+    static uint64_t MixIn( uint64_t hashValue,
+                           double const doubleValue );
+
+    // This returns true if the cache has slots and is not being used from
+    // within an OpenMP parallel region.
+    bool IsUsableHere() const
+    {
+#ifdef _OPENMP
+      return ( !(cacheSlots.empty()) && !(omp_in_parallel()) );
+#else
+      return !(cacheSlots.empty());
+#endif
+    }
+
+    // This returns the slot for the given key.
+    CacheSlot& SlotFor( std::vector< double > const& fieldConfiguration,
+                        double const temperatureValue )
+    { return cacheSlots[ HashOf( fieldConfiguration,
+                                 temperatureValue ) % cacheSlots.size() ]; }
+  };
+
+
+
+
+
+  // This empties the cache and sets it to have numberOfSlots slots. Setting
+  // the number of slots to 0 disables the cache.
+  inline void
+  PotentialEvaluationCache::SetNumberOfSlots( size_t const numberOfSlots )
+  {
+    cacheSlots.assign( numberOfSlots,
+                       CacheSlot() );
+    numberOfLookUps = 0;
+    numberOfHits = 0;
+  }
+
+  // This empties all the slots and resets the look-up statistics, and should
+  // be called whenever the potential changes, for example for a new parameter
+  // point.
+  inline void PotentialEvaluationCache::Clear()
+  {
+    for( std::vector< CacheSlot >::iterator
+         cacheSlot( cacheSlots.begin() );
+         cacheSlot < cacheSlots.end();
+         ++cacheSlot )
+    {
+      cacheSlot->isFilled = false;
+    }
+    numberOfLookUps = 0;
+    numberOfHits = 0;
+  }
+
+  // This returns true and puts the stored value into potentialValue if the
+  // cache has a value for exactly the given fieldConfiguration and
+  // temperatureValue, and returns false otherwise.
+  inline bool PotentialEvaluationCache::LookUp(
+                               std::vector< double > const& fieldConfiguration,
+                                                double const temperatureValue,
+                                                double& potentialValue )
+  {
+    if( !(IsUsableHere()) )
+    {
+      return false;
+    }
+    ++numberOfLookUps;
+    CacheSlot const& cacheSlot( SlotFor( fieldConfiguration,
+                                         temperatureValue ) );
+    if( cacheSlot.isFilled
+        &&
+        ( cacheSlot.temperatureValue == temperatureValue )
+        &&
+        ( cacheSlot.fieldConfiguration == fieldConfiguration ) )
+    {
+      ++numberOfHits;
+      potentialValue = cacheSlot.potentialValue;
+      return true;
+    }
+    return false;
+  }
+
+  // This stores potentialValue for fieldConfiguration and temperatureValue,
+  // over-writing whatever was in the slot for that key.
+  inline void PotentialEvaluationCache::Store(
+                               std::vector< double > const& fieldConfiguration,
+                                                 double const temperatureValue,
+                                                 double const potentialValue )
+  {
+    if( !(IsUsableHere()) )
+    {
+      return;
+    }
+    CacheSlot& cacheSlot( SlotFor( fieldConfiguration,
+                                   temperatureValue ) );
+    cacheSlot.isFilled = true;
+    cacheSlot.fieldConfiguration = fieldConfiguration;
+    cacheSlot.temperatureValue = temperatureValue;
+    cacheSlot.potentialValue = potentialValue;
+  }
+
+  // This returns a human-readable summary of the look-up statistics.
+  inline std::string PotentialEvaluationCache::StatisticsAsString() const
+  {
+    std::stringstream stringBuilder;
+    stringBuilder
+    << "Potential evaluation cache (" << cacheSlots.size() << " slots): "
+    << numberOfHits << " hits from " << numberOfLookUps << " look-ups ("
+    << ( 100.0 * HitRate() ) << "%).";
+    return stringBuilder.str();
+  }
+
+  // This returns a hash of the bit patterns of the field values and the
+  // temperature, so that only exactly equal keys are ever treated as the
+  // same.
+  inline uint64_t PotentialEvaluationCache::HashOf(
+                               std::vector< double > const& fieldConfiguration,
+                                                double const temperatureValue )
+  {
+    // The starting value is the FNV-1a 64-bit offset basis.
+    uint64_t hashValue( MixIn( 14695981039346656037ULL,
+                               temperatureValue ) );
+    for( std::vector< double >::const_iterator
+         fieldValue( fieldConfiguration.begin() );
+         fieldValue < fieldConfiguration.end();
+         ++fieldValue )
+    {
+      hashValue = MixIn( hashValue,
+                         *fieldValue );
+    }
+    return hashValue;
+  }
+
+  // This mixes the bit pattern of doubleValue into hashValue.
+  inline uint64_t PotentialEvaluationCache::MixIn( uint64_t hashValue,
+                                                   double const doubleValue )
+  {
+    uint64_t bitPattern;
+    std::memcpy( &bitPattern,
+                 &doubleValue,
+                 sizeof( bitPattern ) );
+    // This is the finalizer of MurmurHash3, applied to the combination so
+    // that the low bits used for the slot index depend on all the bits of
+    // every value.
+    hashValue ^= bitPattern;
+    hashValue ^= ( hashValue >> 33 );
+    hashValue *= 0xff51afd7ed558ccdULL;
+    hashValue ^= ( hashValue >> 33 );
+    hashValue *= 0xc4ceb9fe1a85ec53ULL;
+    hashValue ^= ( hashValue >> 33 );
+    return hashValue;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* POTENTIALEVALUATIONCACHE_HPP_ */
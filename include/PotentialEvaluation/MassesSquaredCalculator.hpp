@@ -13,6 +13,8 @@
 #include <vector>
 #include "LHPC/Utilities/ParsingUtilities.hpp"
 #include <stdexcept>
+#include <cstddef>
+#include <cmath>
 
 namespace VevaciousPlusPlus
 {
@@ -55,12 +57,91 @@ namespace VevaciousPlusPlus
     virtual std::vector< double >
     MassesSquared( std::vector< double > const& fieldConfiguration ) const = 0;
 
+    // This puts the masses-squared for each of the field configurations in
+    // fieldConfigurations into the corresponding element of
+    // massesSquaredByConfiguration, using the values for the Lagrangian
+    // parameters from the last call of UpdateForFixedScale. By default it just
+    // calls MassesSquared for each configuration in turn, but derived classes
+    // which can share work across the configurations can over-write this
+    // function.
+    virtual void MassesSquaredForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+   std::vector< std::vector< double > >& massesSquaredByConfiguration ) const;
+
+    // This should add weightFactor times the gradient and the Hessian with
+    // respect to the fields at fieldConfiguration of the sum over the
+    // masses-squared m of m^2 ( ln( |m| * inverseScaleSquared )
+    // - subtractFromLogarithm ) to gradientVector and hessianMatrix, using
+    // the values for the Lagrangian parameters from the last call of
+    // UpdateForFixedScale, and return true. By default it adds nothing and
+    // returns false, to indicate that the derivatives are not available
+    // analytically.
+    virtual bool AddLoopSumDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                        double const inverseScaleSquared,
+                                        double const subtractFromLogarithm,
+                                        double const weightFactor,
+                                        std::vector< double >& gradientVector,
+              std::vector< std::vector< double > >& hessianMatrix ) const
+    { return false; }
+
+    // This should put the masses-squared for the field configuration given by
+    // fieldConfiguration into massesSquared and their partial derivatives with
+    // respect to the fields into massSquaredGradients, so that
+    // massSquaredGradients[ m ][ a ] is the derivative of mass-squared m with
+    // respect to the field with index a, using the values for the Lagrangian
+    // parameters from the last call of UpdateForFixedScale, and return true.
+    // This is the forward-mode propagation of the field derivatives through
+    // the masses-squared, so that any function of them can be differentiated
+    // by the chain rule. By default it returns false, to indicate that the
+    // derivatives are not available analytically.
+    virtual bool MassesSquaredWithGradients(
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+    std::vector< std::vector< double > >& massSquaredGradients ) const
+    { return false; }
+
+    // This should put the masses-squared for the field configuration given by
+    // fieldConfiguration into massesSquared and their partial derivatives into
+    // massSquaredGradients, using the values for the Lagrangian parameters
+    // found in parameterValues, and return true. Each massSquaredGradients[ m ]
+    // should have one more element than fieldConfiguration: the last element
+    // is the derivative of mass-squared m with respect to the logarithm of the
+    // renormalization scale through the running of the Lagrangian parameters,
+    // given their derivatives in parameterScaleDerivatives. By default it
+    // returns false, to indicate that the derivatives are not available
+    // analytically.
+    virtual bool MassesSquaredWithGradients(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+    std::vector< std::vector< double > >& massSquaredGradients ) const
+    { return false; }
+
+    // This sets firstDerivative and secondDerivative to the first and second
+    // derivatives with respect to massSquared of massSquared^2
+    // ( ln( |massSquared| * inverseScaleSquared ) - subtractFromLogarithm ).
+    // The second derivative diverges logarithmically at massSquared = 0, so
+    // it is taken to be 0 there.
+    static void LoopSummandDerivatives( double const massSquared,
+                                        double const inverseScaleSquared,
+                                        double const subtractFromLogarithm,
+                                        double& firstDerivative,
+                                        double& secondDerivative );
+
     // This returns the number of identical copies of this mass-squared matrix
     // that the model has.
     double MultiplicityFactor() const{ return multiplicityFactor; }
 
     SpinType GetSpinType() const{ return spinType; }
 
+    // This should return false only if the masses-squared are certain not to
+    // change when the field with index fieldIndex changes. By default it
+    // returns true.
+    virtual bool DependsOnField( size_t const fieldIndex ) const
+    { return true; }
+
     // This should update all objects which contribute to the masses with the
     // values for the Lagrangian parameters given in parameterValues.
     virtual void
@@ -102,6 +183,53 @@ namespace VevaciousPlusPlus
     SetSpinType( attributeFinder->second );
   }
 
+  // This puts the masses-squared for each of the field configurations in
+  // fieldConfigurations into the corresponding element of
+  // massesSquaredByConfiguration, using the values for the Lagrangian
+  // parameters from the last call of UpdateForFixedScale. By default it just
+  // calls MassesSquared for each configuration in turn, but derived classes
+  // which can share work across the configurations can over-write this
+  // function.
+  inline void MassesSquaredCalculator::MassesSquaredForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+    std::vector< std::vector< double > >& massesSquaredByConfiguration ) const
+  {
+    massesSquaredByConfiguration.resize( fieldConfigurations.size() );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      massesSquaredByConfiguration[ configurationIndex ]
+      = MassesSquared( fieldConfigurations[ configurationIndex ] );
+    }
+  }
+
+  // This sets firstDerivative and secondDerivative to the first and second
+  // derivatives with respect to massSquared of massSquared^2
+  // ( ln( |massSquared| * inverseScaleSquared ) - subtractFromLogarithm ).
+  // The second derivative diverges logarithmically at massSquared = 0, so it
+  // is taken to be 0 there.
+  inline void MassesSquaredCalculator::LoopSummandDerivatives(
+                                                      double const massSquared,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                       double& firstDerivative,
+                                                     double& secondDerivative )
+  {
+    if( massSquared == 0.0 )
+    {
+      firstDerivative = 0.0;
+      secondDerivative = 0.0;
+      return;
+    }
+    double const
+    twiceLogarithm( 2.0 * ( std::log( std::abs( massSquared )
+                                      * inverseScaleSquared )
+                            - subtractFromLogarithm ) );
+    firstDerivative = ( massSquared * ( twiceLogarithm + 1.0 ) );
+    secondDerivative = ( twiceLogarithm + 3.0 );
+  }
+
   // This sets the spin type based on the string found for the attribute. It
   // throws an exception if it is not a valid spin type.
   inline void
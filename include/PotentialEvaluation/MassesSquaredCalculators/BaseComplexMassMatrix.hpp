@@ -32,7 +32,8 @@ namespace VevaciousPlusPlus
     BaseComplexMassMatrix( size_t const numberOfRows,
                    std::map< std::string, std::string > const& attributeMap ) :
       MassesSquaredFromMatrix< std::complex< double > >( numberOfRows,
-                                                         attributeMap ),
+                                                         attributeMap,
+                                                         false ),
       matrixElements( ( numberOfRows * numberOfRows ),
          ComplexParametersAndFieldsProductSum( ParametersAndFieldsProductSum(),
                                          ParametersAndFieldsProductSum() ) ) {}
@@ -48,7 +49,9 @@ namespace VevaciousPlusPlus
     virtual ~BaseComplexMassMatrix() {}
 
 
-    // This calls UpdateForFixedScale on each element of matrixElements.
+    // This calls UpdateForFixedScale on each element of matrixElements which
+    // is in the fill pattern, and then finds the eigenvalues if the matrix is
+    // field independent.
     virtual void
     UpdateForFixedScale( std::vector< double > const& parameterValues );
 
@@ -66,24 +69,283 @@ namespace VevaciousPlusPlus
 
   protected:
     std::vector< ComplexParametersAndFieldsProductSum > matrixElements;
+
+    // This sets valuesMatrix to the matrix of the elements in the fill
+    // pattern for a field configuration given by fieldConfiguration, using
+    // the values for the Lagrangian parameters from the last call of
+    // UpdateForFixedScale, and firstDerivatives and secondDerivatives to its
+    // first and second partial derivatives with respect to the fields, as
+    // for SetMatrixAndDerivatives. The upper triangle is filled with the
+    // transpose of the lower triangle if isSymmetric is true, and with its
+    // conjugate otherwise, in which case the imaginary parts of the diagonal
+    // are left as zero.
+    void SetElementsAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                    bool const isSymmetric,
+                                    Eigen::MatrixXcd& valuesMatrix,
+                             std::vector< Eigen::MatrixXcd >& firstDerivatives,
+                std::vector< Eigen::MatrixXcd >& secondDerivatives ) const;
+
+    // This sets valuesMatrix to the matrix of the elements in the fill
+    // pattern for a field configuration given by fieldConfiguration, using
+    // the values for the Lagrangian parameters found in parameterValues, and
+    // firstDerivatives to its first partial derivatives with respect to the
+    // fields followed by its derivative with respect to the logarithm of the
+    // scale, as for SetRunningMatrixAndDerivatives, given the derivatives of
+    // the parameters in parameterScaleDerivatives. The upper triangle is
+    // filled as for SetElementsAndDerivatives.
+    void SetRunningElementsAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                           bool const isSymmetric,
+                                           Eigen::MatrixXcd& valuesMatrix,
+                    std::vector< Eigen::MatrixXcd >& firstDerivatives ) const;
+
+    // This returns true if both the real and imaginary parts of the element
+    // with index elementIndex are identically zero.
+    virtual bool ElementIsZero( size_t const elementIndex ) const
+    { return ( matrixElements[ elementIndex ].first.IsZero()
+               &&
+               matrixElements[ elementIndex ].second.IsZero() ); }
+
+    // This returns true if both the real and imaginary parts of the elements
+    // with indices firstIndex and secondIndex are made of the same terms.
+    virtual bool ElementsAreIdentical( size_t const firstIndex,
+                                       size_t const secondIndex ) const
+    { return ( matrixElements[ firstIndex ].first.HasSameTermsAs(
+                                         matrixElements[ secondIndex ].first )
+               &&
+               matrixElements[ firstIndex ].second.HasSameTermsAs(
+                                    matrixElements[ secondIndex ].second ) ); }
+
+    // This returns true if either the real or the imaginary part of the
+    // element with index elementIndex has any term with a non-zero power of
+    // any field.
+    virtual bool ElementDependsOnFields( size_t const elementIndex ) const
+    { return ( ( matrixElements[ elementIndex ].first.HighestFieldPower() > 0 )
+               ||
+               ( matrixElements[ elementIndex ].second.HighestFieldPower()
+                 > 0 ) ); }
+
+    // This returns true if either the real or the imaginary part of the
+    // element with index elementIndex has any term with a non-zero power of
+    // the field with index fieldIndex.
+    virtual bool ElementDependsOnField( size_t const elementIndex,
+                                        size_t const fieldIndex ) const
+    { return ( matrixElements[ elementIndex ].first.DependsOnField(
+                                                                  fieldIndex )
+               ||
+               matrixElements[ elementIndex ].second.DependsOnField(
+                                                               fieldIndex ) ); }
   };
 
 
 
 
 
-  // This calls UpdateForFixedScale on each element of matrixElements.
+  // This calls UpdateForFixedScale on each element of matrixElements which
+  // is in the fill pattern, and then finds the eigenvalues if the matrix is
+  // field independent.
   inline void BaseComplexMassMatrix::UpdateForFixedScale(
                                  std::vector< double > const& parameterValues )
   {
-    for( std::vector< ComplexParametersAndFieldsProductSum >::iterator
-         complexPair( matrixElements.begin() );
-         complexPair < matrixElements.end();
-         ++complexPair )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
+    {
+      ComplexParametersAndFieldsProductSum&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      complexPair.first.UpdateForFixedScale( parameterValues );
+      complexPair.second.UpdateForFixedScale( parameterValues );
+    }
+    UpdateFieldIndependentMasses();
+  }
+
+  // This sets valuesMatrix to the matrix of the elements in the fill pattern
+  // for a field configuration given by fieldConfiguration, using the values
+  // for the Lagrangian parameters from the last call of UpdateForFixedScale,
+  // and firstDerivatives and secondDerivatives to its first and second partial
+  // derivatives with respect to the fields, as for SetMatrixAndDerivatives.
+  // The upper triangle is filled with the transpose of the lower triangle if
+  // isSymmetric is true, and with its conjugate otherwise, in which case the
+  // imaginary parts of the diagonal are left as zero.
+  inline void BaseComplexMassMatrix::SetElementsAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                                        bool const isSymmetric,
+                                                Eigen::MatrixXcd& valuesMatrix,
+                             std::vector< Eigen::MatrixXcd >& firstDerivatives,
+                   std::vector< Eigen::MatrixXcd >& secondDerivatives ) const
+  {
+    size_t const numberOfFields( fieldConfiguration.size() );
+    bool const setSecondDerivatives( !(secondDerivatives.empty()) );
+    std::vector< double > realGradient( numberOfFields );
+    std::vector< double > imaginaryGradient( numberOfFields );
+    std::vector< std::vector< double > >
+    realHessian( ( setSecondDerivatives ? numberOfFields : 0 ),
+                 std::vector< double >( numberOfFields ) );
+    std::vector< std::vector< double > > imaginaryHessian( realHessian );
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
+    {
+      size_t const rowIndex( filledElement->rowIndex );
+      size_t const columnIndex( filledElement->columnIndex );
+      bool const includeImaginaryPart( isSymmetric
+                                       ||
+                                       ( columnIndex < rowIndex ) );
+      // The upper triangle gets the conjugate of the lower triangle for a
+      // Hermitian matrix.
+      double const mirrorSign( isSymmetric ? 1.0 : -1.0 );
+      ComplexParametersAndFieldsProductSum const&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      realGradient.assign( numberOfFields,
+                           0.0 );
+      imaginaryGradient.assign( numberOfFields,
+                                0.0 );
+      for( size_t firstField( 0 );
+           firstField < realHessian.size();
+           ++firstField )
+      {
+        realHessian[ firstField ].assign( numberOfFields,
+                                          0.0 );
+        imaginaryHessian[ firstField ].assign( numberOfFields,
+                                               0.0 );
+      }
+      complexPair.first.AddFixedScaleDerivatives( fieldConfiguration,
+                                                  realGradient,
+                                                  realHessian );
+      double imaginaryValue( 0.0 );
+      if( includeImaginaryPart )
+      {
+        imaginaryValue = complexPair.second( fieldConfiguration );
+        complexPair.second.AddFixedScaleDerivatives( fieldConfiguration,
+                                                     imaginaryGradient,
+                                                     imaginaryHessian );
+      }
+      valuesMatrix.coeffRef( rowIndex,
+                             columnIndex )
+      = std::complex< double >( complexPair.first( fieldConfiguration ),
+                                imaginaryValue );
+      valuesMatrix.coeffRef( columnIndex,
+                             rowIndex )
+      = std::complex< double >( valuesMatrix.coeff( rowIndex,
+                                                    columnIndex ).real(),
+                                ( mirrorSign * imaginaryValue ) );
+      for( size_t firstField( 0 );
+           firstField < numberOfFields;
+           ++firstField )
+      {
+        firstDerivatives[ firstField ].coeffRef( rowIndex,
+                                                 columnIndex )
+        = std::complex< double >( realGradient[ firstField ],
+                                  imaginaryGradient[ firstField ] );
+        firstDerivatives[ firstField ].coeffRef( columnIndex,
+                                                 rowIndex )
+        = std::complex< double >( realGradient[ firstField ],
+                      ( mirrorSign * imaginaryGradient[ firstField ] ) );
+        for( size_t secondField( firstField );
+             setSecondDerivatives && ( secondField < numberOfFields );
+             ++secondField )
+        {
+          Eigen::MatrixXcd&
+          secondDerivative( secondDerivatives[ ( firstField * numberOfFields )
+                                               + secondField ] );
+          secondDerivative.coeffRef( rowIndex,
+                                     columnIndex )
+          = std::complex< double >( realHessian[ firstField ][ secondField ],
+                               imaginaryHessian[ firstField ][ secondField ] );
+          secondDerivative.coeffRef( columnIndex,
+                                     rowIndex )
+          = std::complex< double >( realHessian[ firstField ][ secondField ],
+                                    ( mirrorSign
+                            * imaginaryHessian[ firstField ][ secondField ] ) );
+        }
+      }
+    }
+    CopyDuplicateElements( valuesMatrix );
+    CopyDuplicateElements( firstDerivatives );
+    CopyDuplicateElements( secondDerivatives );
+  }
+
+  // This sets valuesMatrix to the matrix of the elements in the fill pattern
+  // for a field configuration given by fieldConfiguration, using the values
+  // for the Lagrangian parameters found in parameterValues, and
+  // firstDerivatives to its first partial derivatives with respect to the
+  // fields followed by its derivative with respect to the logarithm of the
+  // scale, as for SetRunningMatrixAndDerivatives, given the derivatives of the
+  // parameters in parameterScaleDerivatives. The upper triangle is filled as
+  // for SetElementsAndDerivatives.
+  inline void BaseComplexMassMatrix::SetRunningElementsAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                                        bool const isSymmetric,
+                                                Eigen::MatrixXcd& valuesMatrix,
+                      std::vector< Eigen::MatrixXcd >& firstDerivatives ) const
+  {
+    size_t const numberOfDerivatives( firstDerivatives.size() );
+    std::vector< double > realGradient( numberOfDerivatives );
+    std::vector< double > imaginaryGradient( numberOfDerivatives );
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
-      complexPair->first.UpdateForFixedScale( parameterValues );
-      complexPair->second.UpdateForFixedScale( parameterValues );
+      size_t const rowIndex( filledElement->rowIndex );
+      size_t const columnIndex( filledElement->columnIndex );
+      bool const includeImaginaryPart( isSymmetric
+                                       ||
+                                       ( columnIndex < rowIndex ) );
+      double const mirrorSign( isSymmetric ? 1.0 : -1.0 );
+      ComplexParametersAndFieldsProductSum const&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      realGradient.assign( numberOfDerivatives,
+                           0.0 );
+      imaginaryGradient.assign( numberOfDerivatives,
+                                0.0 );
+      complexPair.first.AddRunningScaleGradient( parameterValues,
+                                                 parameterScaleDerivatives,
+                                                 fieldConfiguration,
+                                                 realGradient );
+      double imaginaryValue( 0.0 );
+      if( includeImaginaryPart )
+      {
+        imaginaryValue = complexPair.second( parameterValues,
+                                             fieldConfiguration );
+        complexPair.second.AddRunningScaleGradient( parameterValues,
+                                                    parameterScaleDerivatives,
+                                                    fieldConfiguration,
+                                                    imaginaryGradient );
+      }
+      double const realValue( complexPair.first( parameterValues,
+                                                 fieldConfiguration ) );
+      valuesMatrix.coeffRef( rowIndex,
+                             columnIndex )
+      = std::complex< double >( realValue,
+                                imaginaryValue );
+      valuesMatrix.coeffRef( columnIndex,
+                             rowIndex )
+      = std::complex< double >( realValue,
+                                ( mirrorSign * imaginaryValue ) );
+      for( size_t derivativeIndex( 0 );
+           derivativeIndex < numberOfDerivatives;
+           ++derivativeIndex )
+      {
+        firstDerivatives[ derivativeIndex ].coeffRef( rowIndex,
+                                                      columnIndex )
+        = std::complex< double >( realGradient[ derivativeIndex ],
+                                  imaginaryGradient[ derivativeIndex ] );
+        firstDerivatives[ derivativeIndex ].coeffRef( columnIndex,
+                                                      rowIndex )
+        = std::complex< double >( realGradient[ derivativeIndex ],
+                      ( mirrorSign * imaginaryGradient[ derivativeIndex ] ) );
+      }
     }
+    CopyDuplicateElements( valuesMatrix );
+    CopyDuplicateElements( firstDerivatives );
   }
 
   // This is mainly for debugging:
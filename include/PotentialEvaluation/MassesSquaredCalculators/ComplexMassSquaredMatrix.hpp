@@ -29,18 +29,57 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    // This returns a matrix of the values of the elements for a field
+    // This writes the values of the elements in the fill pattern for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const;
+    // Lagrangian parameters found in parameterValues, into the lower triangle
+    // of valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& parameterValues,
+                    std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const;
 
-    // This returns a matrix of the values of the elements for a field
+    // This writes the values of the elements in the fill pattern for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const;
+    // Lagrangian parameters from the last call of UpdateForFixedScale, into
+    // the lower triangle of valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const;
+
+    // This sets valuesMatrix to the full Hermitian matrix for a field
+    // configuration given by fieldConfiguration, using the values for the
+    // Lagrangian parameters from the last call of UpdateForFixedScale, and
+    // firstDerivatives and secondDerivatives to its first and second partial
+    // derivatives with respect to the fields.
+    virtual void SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXcd& valuesMatrix,
+                             std::vector< Eigen::MatrixXcd >& firstDerivatives,
+                  std::vector< Eigen::MatrixXcd >& secondDerivatives ) const
+    { SetElementsAndDerivatives( fieldConfiguration,
+                                 false,
+                                 valuesMatrix,
+                                 firstDerivatives,
+                                 secondDerivatives ); }
+
+    // This sets valuesMatrix to the full Hermitian matrix for a field
+    // configuration given by fieldConfiguration, using the values for the
+    // Lagrangian parameters found in parameterValues, and firstDerivatives to
+    // its first partial derivatives with respect to the fields followed by its
+    // derivative with respect to the logarithm of the scale, given the
+    // derivatives of the parameters in parameterScaleDerivatives.
+    virtual void SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXcd& valuesMatrix,
+                     std::vector< Eigen::MatrixXcd >& firstDerivatives ) const
+    { SetRunningElementsAndDerivatives( parameterValues,
+                                        parameterScaleDerivatives,
+                                        fieldConfiguration,
+                                        false,
+                                        valuesMatrix,
+                                        firstDerivatives ); }
   };
 
 } /* namespace VevaciousPlusPlus */
@@ -10,6 +10,9 @@
 
 #include "PotentialEvaluation/MassesSquaredCalculator.hpp"
 #include "Eigen/Dense"
+#include "PotentialEvaluation/BuildingBlocks/BatchedSymmetricEigenvalues.hpp"
+#include <complex>
+#include <cmath>
 #include <cstddef>
 #include <map>
 #include <string>
@@ -23,9 +26,14 @@ namespace VevaciousPlusPlus
   public:
     typedef typename
     Eigen::Matrix< ElementType, Eigen::Dynamic, Eigen::Dynamic > EigenMatrix;
+    // The elements are assembled through a map so that they can be written
+    // straight into matrices with compile-time dimensions as well as into
+    // EigenMatrix instances.
+    typedef typename Eigen::Map< EigenMatrix > MatrixMap;
 
     MassesSquaredFromMatrix( size_t numberOfRows,
-                    std::map< std::string, std::string > const& attributeMap );
+                    std::map< std::string, std::string > const& attributeMap,
+                             bool const readsUpperTriangle );
     MassesSquaredFromMatrix( MassesSquaredFromMatrix const& copySource );
     MassesSquaredFromMatrix();
     virtual ~MassesSquaredFromMatrix();
@@ -44,24 +52,342 @@ namespace VevaciousPlusPlus
     virtual std::vector< double >
     MassesSquared( std::vector< double > const& fieldConfiguration ) const;
 
+    // This puts the eigenvalues of the matrix for each of the field
+    // configurations in fieldConfigurations into the corresponding element of
+    // massesSquaredByConfiguration, using the values for the Lagrangian
+    // parameters from the last call of UpdateForFixedScale. If the batch is
+    // large enough and the matrix small enough, all the matrices are
+    // diagonalized together by BatchedSymmetricEigenvalues, and otherwise
+    // they are diagonalized one by one.
+    virtual void MassesSquaredForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+   std::vector< std::vector< double > >& massesSquaredByConfiguration ) const;
+
+    // This adds weightFactor times the gradient and the Hessian with respect
+    // to the fields at fieldConfiguration of the sum over the eigenvalues m of
+    // m^2 ( ln( |m| * inverseScaleSquared ) - subtractFromLogarithm ) to
+    // gradientVector and hessianMatrix, using the values for the Lagrangian
+    // parameters from the last call of UpdateForFixedScale, and returns true.
+    // The derivatives of the eigenvalues come from first- and second-order
+    // perturbation theory using the exact derivatives of the polynomial
+    // matrix elements, with the second-order terms for pairs of eigenvalues
+    // written as divided differences so that degenerate eigenvalues are
+    // handled smoothly.
+    virtual bool AddLoopSumDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                        double const inverseScaleSquared,
+                                        double const subtractFromLogarithm,
+                                        double const weightFactor,
+                                        std::vector< double >& gradientVector,
+              std::vector< std::vector< double > >& hessianMatrix ) const;
+
+    // This puts the eigenvalues of the matrix for the field configuration
+    // given by fieldConfiguration into massesSquared and their partial
+    // derivatives with respect to the fields into massSquaredGradients, using
+    // the values for the Lagrangian parameters from the last call of
+    // UpdateForFixedScale, and returns true. The derivatives of the
+    // eigenvalues are the diagonal elements of the derivatives of the matrix
+    // in its eigenbasis, from first-order perturbation theory. For degenerate
+    // eigenvalues the split between them depends on the eigenbasis chosen,
+    // but their sum, and so any symmetric function of the masses-squared such
+    // as the potential, is still differentiated correctly.
+    virtual bool MassesSquaredWithGradients(
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+       std::vector< std::vector< double > >& massSquaredGradients ) const;
+
+    // This puts the eigenvalues of the matrix for the field configuration
+    // given by fieldConfiguration into massesSquared and their partial
+    // derivatives into massSquaredGradients, using the values for the
+    // Lagrangian parameters found in parameterValues, and returns true. The
+    // last element of each massSquaredGradients[ m ] is the derivative with
+    // respect to the logarithm of the scale through the running of the
+    // parameters, given their derivatives in parameterScaleDerivatives, which
+    // comes from first-order perturbation theory just as the field
+    // derivatives do.
+    virtual bool MassesSquaredWithGradients(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+       std::vector< std::vector< double > >& massSquaredGradients ) const;
+
     size_t NumberOfRows() const { return numberOfRows; }
 
+    // This restricts the fill pattern to the elements which are not
+    // identically zero, so that assembling the matrix for a field
+    // configuration only visits elements which can contribute, and which are
+    // not identical to an element earlier in the fill pattern, as the values
+    // of such duplicates are just copied from the earlier element. It also
+    // notes whether any element depends on the fields. It should be called
+    // once all the elements have been set, and called again if any element is
+    // changed through ElementAt afterwards.
+    void PrepareFillPattern() { SetFillPattern( true ); }
+
+    // This returns true if PrepareFillPattern found that none of the elements
+    // depend on the fields, in which case the eigenvalues are only found once
+    // for each call of UpdateForFixedScale, rather than for every field
+    // configuration, by the functions which use the values for the Lagrangian
+    // parameters from the last call of UpdateForFixedScale.
+    bool IsFieldIndependent() const { return isFieldIndependent; }
+
+    // This returns true if any element in the fill pattern depends on the
+    // field with index fieldIndex.
+    virtual bool DependsOnField( size_t const fieldIndex ) const;
+
+    size_t NumberOfFilledElements() const { return filledElements.size(); }
+
+    size_t NumberOfDuplicateElements() const
+    { return duplicateElements.size(); }
+
 
   protected:
+    // This holds the position of an element which is assembled into the
+    // matrix: its row and column, and its index in the row-major vector of
+    // elements held by the derived class.
+    struct FilledElement
+    {
+      FilledElement( size_t const rowIndex,
+                     size_t const columnIndex,
+                     size_t const elementIndex ) :
+        rowIndex( rowIndex ),
+        columnIndex( columnIndex ),
+        elementIndex( elementIndex ) {}
+
+      size_t rowIndex;
+      size_t columnIndex;
+      size_t elementIndex;
+    };
+
+    // This holds the position of an element which is identical to an element
+    // which is assembled into the matrix, and the position of that element,
+    // from which its value is copied.
+    struct DuplicateElement
+    {
+      DuplicateElement( size_t const rowIndex,
+                        size_t const columnIndex,
+                        size_t const sourceRowIndex,
+                        size_t const sourceColumnIndex ) :
+        rowIndex( rowIndex ),
+        columnIndex( columnIndex ),
+        sourceRowIndex( sourceRowIndex ),
+        sourceColumnIndex( sourceColumnIndex ) {}
+
+      size_t rowIndex;
+      size_t columnIndex;
+      size_t sourceRowIndex;
+      size_t sourceColumnIndex;
+    };
+
+    // This is the signature of the functions which assemble the matrix for
+    // the field configuration given by fieldConfiguration, using the values
+    // for the Lagrangian parameters found in parameterValues, or those from
+    // the last call of UpdateForFixedScale if parameterValues is NULL, and
+    // fill massesSquared with its eigenvalues.
+    typedef void (MassesSquaredFromMatrix::*EigenvalueFinder)(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                            std::vector< double >& massesSquared ) const;
+
+    // Below this number of field configurations, the set-up of the batched
+    // eigenvalue finder costs more than it saves.
+    static size_t const minimumBatchSizeForBatchedEigenvalues = 4;
+
+    // Above this number of rows of the real symmetric matrix which is actually
+    // diagonalized (which is double the number of rows for complex matrices),
+    // the Jacobi sweeps of the batched eigenvalue finder are no faster than
+    // the fixed-size Eigen solvers.
+    static size_t const maximumRealRowsForBatchedEigenvalues = 6;
+
     size_t numberOfRows;
+    EigenvalueFinder eigenvalueFinder;
+    // The derived classes read either the upper triangle (column index >= row
+    // index) or the lower triangle (column index <= row index) of their
+    // elements, and filledElements lists the elements of that triangle which
+    // are assembled, in row-major order.
+    bool readsUpperTriangle;
+    std::vector< FilledElement > filledElements;
+    // The elements of the triangle which are identical to an element in
+    // filledElements are not evaluated at all, and are instead copied from
+    // their sources in both triangles once the elements in filledElements
+    // have been written.
+    std::vector< DuplicateElement > duplicateElements;
+    bool isFieldIndependent;
+    // If isFieldIndependent is true, fieldIndependentMassesSquared holds the
+    // eigenvalues of the matrix from the last call of UpdateForFixedScale,
+    // once there has been one.
+    std::vector< double > fieldIndependentMassesSquared;
+    bool fieldIndependentMassesAreCurrent;
+
+    // This should write the values of the elements in filledElements for a
+    // field configuration given by fieldConfiguration, using the values for
+    // the Lagrangian parameters found in parameterValues, into valuesMatrix,
+    // which must already have numberOfRows rows and columns and be zero in
+    // every element which is not written, and then copy the elements in
+    // duplicateElements with CopyDuplicateElements.
+    virtual void
+    AssembleValues( std::vector< double > const& parameterValues,
+                    std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const = 0;
+
+    // This should write the values of the elements in filledElements for a
+    // field configuration given by fieldConfiguration, using the values for
+    // the Lagrangian parameters from the last call of UpdateForFixedScale,
+    // into valuesMatrix, which must already have numberOfRows rows and
+    // columns and be zero in every element which is not written, and then
+    // copy the elements in duplicateElements with CopyDuplicateElements.
+    virtual void
+    AssembleValues( std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const = 0;
 
-    // This should return a matrix of the values of the elements for a field
+    // This calls AssembleValues with parameterValues if it is not NULL, and
+    // otherwise with the values for the Lagrangian parameters from the last
+    // call of UpdateForFixedScale.
+    void AssembleValues( std::vector< double > const* parameterValues,
+                         std::vector< double > const& fieldConfiguration,
+                         MatrixMap valuesMatrix ) const;
+
+    // This should set valuesMatrix to the matrix (both triangles) for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual EigenMatrix
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const = 0;
+    // Lagrangian parameters from the last call of UpdateForFixedScale,
+    // firstDerivatives[ a ] to its partial derivative with respect to the
+    // field with index a, and secondDerivatives[ ( a * numberOfFields ) + b ]
+    // to its second partial derivative with respect to the fields with
+    // indices a and b, for b >= a. All the matrices must already have
+    // numberOfRows rows and columns and be zero in every element. If
+    // secondDerivatives is empty, only the first derivatives are set.
+    virtual void SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                          EigenMatrix& valuesMatrix,
+                                std::vector< EigenMatrix >& firstDerivatives,
+                     std::vector< EigenMatrix >& secondDerivatives ) const = 0;
 
-    // This should return a matrix of the values of the elements for a field
+    // This should set valuesMatrix to the matrix (both triangles) for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual EigenMatrix
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const = 0;
+    // Lagrangian parameters found in parameterValues, firstDerivatives[ a ] to
+    // its partial derivative with respect to the field with index a, and the
+    // last element of firstDerivatives, which has one more element than
+    // fieldConfiguration, to its derivative with respect to the logarithm of
+    // the scale through the parameters, given their derivatives in
+    // parameterScaleDerivatives. All the matrices must already have
+    // numberOfRows rows and columns and be zero in every element.
+    virtual void SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          EigenMatrix& valuesMatrix,
+                       std::vector< EigenMatrix >& firstDerivatives ) const = 0;
+
+    // This puts the eigenvalues of valuesMatrix into massesSquared and, for
+    // each element of firstDerivatives, the derivatives of the eigenvalues
+    // from first-order perturbation theory into massSquaredGradients, so that
+    // massSquaredGradients[ m ][ a ] is the diagonal element for eigenvalue m
+    // of firstDerivatives[ a ] in the eigenbasis of valuesMatrix.
+    void EigenvaluesAndDerivatives( EigenMatrix const& valuesMatrix,
+                           std::vector< EigenMatrix > const& firstDerivatives,
+                                    std::vector< double >& massesSquared,
+       std::vector< std::vector< double > >& massSquaredGradients ) const;
+
+    // This should return true if the element with index elementIndex in the
+    // row-major vector of elements held by the derived class is identically
+    // zero.
+    virtual bool ElementIsZero( size_t const elementIndex ) const = 0;
+
+    // This should return true if the elements with indices firstIndex and
+    // secondIndex in the row-major vector of elements held by the derived
+    // class are made of the same terms, so always have the same value.
+    virtual bool ElementsAreIdentical( size_t const firstIndex,
+                                       size_t const secondIndex ) const = 0;
+
+    // This should return true if the element with index elementIndex in the
+    // row-major vector of elements held by the derived class has any term
+    // with a non-zero power of any field.
+    virtual bool
+    ElementDependsOnFields( size_t const elementIndex ) const = 0;
+
+    // This should return true if the element with index elementIndex in the
+    // row-major vector of elements held by the derived class has any term
+    // with a non-zero power of the field with index fieldIndex.
+    virtual bool ElementDependsOnField( size_t const elementIndex,
+                                        size_t const fieldIndex ) const = 0;
+
+    // This should be called by UpdateForFixedScale of the derived classes
+    // once they have updated their elements. If the matrix is field
+    // independent, it puts the eigenvalues of the matrix with the updated
+    // values of the Lagrangian parameters into fieldIndependentMassesSquared.
+    void UpdateFieldIndependentMasses();
+
+    // This fills filledElements with the positions of the elements of the
+    // triangle read by the derived class, and duplicateElements with those
+    // of the elements which are identical to an earlier element in
+    // filledElements, if skipZeroElements is true, in which case the elements
+    // for which ElementIsZero returns true are left out of both, and
+    // isFieldIndependent is set to whether none of the remaining elements
+    // depend on the fields. Diagonal elements are only matched with diagonal
+    // elements, and off-diagonal elements with off-diagonal elements, as the
+    // derived classes may treat the diagonal differently (such as leaving out
+    // the imaginary parts for Hermitian matrices).
+    void SetFillPattern( bool const skipZeroElements );
+
+    // This copies the value of each element in duplicateElements from its
+    // source, and the value of its mirror element in the other triangle from
+    // the mirror element of its source, so that it works whether the derived
+    // class writes both triangles or only one. MatrixType can be EigenMatrix
+    // or MatrixMap.
+    template< typename MatrixType >
+    void CopyDuplicateElements( MatrixType& valuesMatrix ) const;
+
+    // This calls CopyDuplicateElements on each of valuesMatrices.
+    void
+    CopyDuplicateElements( std::vector< EigenMatrix >& valuesMatrices ) const;
+
+    // This returns the eigenvalue finder for fixed-size matrices with
+    // numberOfRows rows if numberOfRows is between 2 and 8 inclusive, and
+    // the eigenvalue finder for dynamic-size matrices otherwise. It is
+    // called once when the matrix is constructed so that the choice is not
+    // re-made for every field configuration.
+    static EigenvalueFinder ChooseEigenvalueFinder( size_t const numberOfRows );
+
+    // This assembles the matrix directly into a matrix with compile-time
+    // dimensions, so that nothing is allocated on the heap and Eigen can
+    // unroll its loops, and fills massesSquared with its eigenvalues.
+    template< int FixedRows > void
+    FixedSizeEigenvalues( std::vector< double > const* parameterValues,
+                          std::vector< double > const& fieldConfiguration,
+                          std::vector< double >& massesSquared ) const;
+
+    // This assembles the matrix into an EigenMatrix and fills massesSquared
+    // with its eigenvalues, for matrices too large to have a fixed-size
+    // instantiation.
+    void
+    DynamicSizeEigenvalues( std::vector< double > const* parameterValues,
+                            std::vector< double > const& fieldConfiguration,
+                            std::vector< double >& massesSquared ) const;
+
+    // This returns the number of rows of the real symmetric matrix which
+    // BatchedSymmetricEigenvalues has to diagonalize for a matrix of
+    // ElementType with numberOfRows rows.
+    static size_t RealRowsForBatch( double const*,
+                                    size_t const numberOfRows )
+    { return numberOfRows; }
+    static size_t RealRowsForBatch( std::complex< double > const*,
+                                    size_t const numberOfRows )
+    { return ( 2 * numberOfRows ); }
+
+    // This fills massesSquaredByConfiguration with the eigenvalues of each of
+    // the real symmetric matrices in matrixValues, all found together.
+    static void
+    BatchedEigenvalues( std::vector< Eigen::MatrixXd > const& matrixValues,
+                        size_t const numberOfRows,
+   std::vector< std::vector< double > >& massesSquaredByConfiguration );
+
+    // This fills massesSquaredByConfiguration with the eigenvalues of each of
+    // the Hermitian matrices in matrixValues, all found together, reading
+    // only the lower triangles as Eigen::SelfAdjointEigenSolver does.
+    static void
+    BatchedEigenvalues( std::vector< Eigen::MatrixXcd > const& matrixValues,
+                        size_t const numberOfRows,
+   std::vector< std::vector< double > >& massesSquaredByConfiguration );
   };
 
 
@@ -69,18 +395,36 @@ namespace VevaciousPlusPlus
   template< typename ElementType > inline
   MassesSquaredFromMatrix< ElementType >::MassesSquaredFromMatrix(
                                                            size_t numberOfRows,
-                   std::map< std::string, std::string > const& attributeMap ) :
+                     std::map< std::string, std::string > const& attributeMap,
+                                             bool const readsUpperTriangle ) :
     MassesSquaredCalculator( attributeMap ),
-    numberOfRows( numberOfRows )
+    numberOfRows( numberOfRows ),
+    eigenvalueFinder( ChooseEigenvalueFinder( numberOfRows ) ),
+    readsUpperTriangle( readsUpperTriangle ),
+    filledElements(),
+    duplicateElements(),
+    isFieldIndependent( false ),
+    fieldIndependentMassesSquared(),
+    fieldIndependentMassesAreCurrent( false )
   {
-    // This constructor is just an initialization list.
+    // Until PrepareFillPattern is called, every element of the triangle is
+    // assembled.
+    SetFillPattern( false );
   }
 
   template< typename ElementType > inline
   MassesSquaredFromMatrix< ElementType >::MassesSquaredFromMatrix(
                    MassesSquaredFromMatrix< ElementType > const& copySource ) :
     MassesSquaredCalculator( copySource ),
-    numberOfRows( copySource.numberOfRows )
+    numberOfRows( copySource.numberOfRows ),
+    eigenvalueFinder( copySource.eigenvalueFinder ),
+    readsUpperTriangle( copySource.readsUpperTriangle ),
+    filledElements( copySource.filledElements ),
+    duplicateElements( copySource.duplicateElements ),
+    isFieldIndependent( copySource.isFieldIndependent ),
+    fieldIndependentMassesSquared( copySource.fieldIndependentMassesSquared ),
+    fieldIndependentMassesAreCurrent(
+                                 copySource.fieldIndependentMassesAreCurrent )
   {
     // This constructor is just an initialization list.
   }
@@ -88,7 +432,15 @@ namespace VevaciousPlusPlus
   template< typename ElementType > inline
   MassesSquaredFromMatrix< ElementType >::MassesSquaredFromMatrix() :
     MassesSquaredCalculator(),
-    numberOfRows( 0 )
+    numberOfRows( 0 ),
+    eigenvalueFinder(
+              &MassesSquaredFromMatrix< ElementType >::DynamicSizeEigenvalues ),
+    readsUpperTriangle( true ),
+    filledElements(),
+    duplicateElements(),
+    isFieldIndependent( false ),
+    fieldIndependentMassesSquared(),
+    fieldIndependentMassesAreCurrent( false )
   {
     // This constructor is just an initialization list.
   }
@@ -107,17 +459,10 @@ namespace VevaciousPlusPlus
                                   std::vector< double > const& parameterValues,
                         std::vector< double > const& fieldConfiguration ) const
   {
-    Eigen::SelfAdjointEigenSolver< EigenMatrix >
-    eigenvalueFinder( CurrentValues( parameterValues,
-                                     fieldConfiguration ),
-                      Eigen::EigenvaluesOnly );
     std::vector< double > massesSquared( numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
-    {
-      massesSquared[ rowIndex ] = eigenvalueFinder.eigenvalues()( rowIndex );
-    }
+    (this->*eigenvalueFinder)( &parameterValues,
+                               fieldConfiguration,
+                               massesSquared );
     return massesSquared;
   }
 
@@ -128,17 +473,719 @@ namespace VevaciousPlusPlus
   MassesSquaredFromMatrix< ElementType >::MassesSquared(
                         std::vector< double > const& fieldConfiguration ) const
   {
-    Eigen::SelfAdjointEigenSolver< EigenMatrix >
-    eigenvalueFinder( CurrentValues( fieldConfiguration ),
-                      Eigen::EigenvaluesOnly );
+    if( fieldIndependentMassesAreCurrent )
+    {
+      return fieldIndependentMassesSquared;
+    }
     std::vector< double > massesSquared( numberOfRows );
+    (this->*eigenvalueFinder)( NULL,
+                               fieldConfiguration,
+                               massesSquared );
+    return massesSquared;
+  }
+
+  // This puts the eigenvalues of the matrix for each of the field
+  // configurations in fieldConfigurations into the corresponding element of
+  // massesSquaredByConfiguration, using the values for the Lagrangian
+  // parameters from the last call of UpdateForFixedScale. If the batch is
+  // large enough and the matrix small enough, all the matrices are
+  // diagonalized together by BatchedSymmetricEigenvalues, and otherwise they
+  // are diagonalized one by one.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::MassesSquaredForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+    std::vector< std::vector< double > >& massesSquaredByConfiguration ) const
+  {
+    if( fieldIndependentMassesAreCurrent )
+    {
+      massesSquaredByConfiguration.assign( fieldConfigurations.size(),
+                                           fieldIndependentMassesSquared );
+      return;
+    }
+    if( ( fieldConfigurations.size() < minimumBatchSizeForBatchedEigenvalues )
+        ||
+        ( RealRowsForBatch( static_cast< ElementType const* >( 0 ),
+                            numberOfRows )
+          > maximumRealRowsForBatchedEigenvalues ) )
+    {
+      MassesSquaredCalculator::MassesSquaredForBatch( fieldConfigurations,
+                                                massesSquaredByConfiguration );
+      return;
+    }
+    // The matrices are allocated and zeroed once, and then only the filled
+    // elements are written for each configuration.
+    std::vector< EigenMatrix > matrixValues( fieldConfigurations.size(),
+                                             EigenMatrix::Zero( numberOfRows,
+                                                            numberOfRows ) );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      AssembleValues( fieldConfigurations[ configurationIndex ],
+                      MatrixMap( matrixValues[ configurationIndex ].data(),
+                                 numberOfRows,
+                                 numberOfRows ) );
+    }
+    BatchedEigenvalues( matrixValues,
+                        numberOfRows,
+                        massesSquaredByConfiguration );
+  }
+
+  // This calls AssembleValues with parameterValues if it is not NULL, and
+  // otherwise with the values for the Lagrangian parameters from the last
+  // call of UpdateForFixedScale.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::AssembleValues(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                           MatrixMap valuesMatrix ) const
+  {
+    if( parameterValues == NULL )
+    {
+      AssembleValues( fieldConfiguration,
+                      valuesMatrix );
+    }
+    else
+    {
+      AssembleValues( *parameterValues,
+                      fieldConfiguration,
+                      valuesMatrix );
+    }
+  }
+
+  // This adds weightFactor times the gradient and the Hessian with respect to
+  // the fields at fieldConfiguration of the sum over the eigenvalues m of
+  // m^2 ( ln( |m| * inverseScaleSquared ) - subtractFromLogarithm ) to
+  // gradientVector and hessianMatrix, using the values for the Lagrangian
+  // parameters from the last call of UpdateForFixedScale, and returns true.
+  // The derivatives of the eigenvalues come from first- and second-order
+  // perturbation theory using the exact derivatives of the polynomial matrix
+  // elements, with the second-order terms for pairs of eigenvalues written as
+  // divided differences so that degenerate eigenvalues are handled smoothly.
+  template< typename ElementType > inline bool
+  MassesSquaredFromMatrix< ElementType >::AddLoopSumDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                     double const weightFactor,
+                                         std::vector< double >& gradientVector,
+                     std::vector< std::vector< double > >& hessianMatrix ) const
+  {
+    // A field-independent matrix contributes nothing to the derivatives.
+    if( fieldIndependentMassesAreCurrent )
+    {
+      return true;
+    }
+    size_t const numberOfFields( fieldConfiguration.size() );
+    EigenMatrix valuesMatrix( EigenMatrix::Zero( numberOfRows,
+                                                 numberOfRows ) );
+    std::vector< EigenMatrix > firstDerivatives( numberOfFields,
+                                                 valuesMatrix );
+    std::vector< EigenMatrix >
+    secondDerivatives( ( numberOfFields * numberOfFields ),
+                       valuesMatrix );
+    SetMatrixAndDerivatives( fieldConfiguration,
+                             valuesMatrix,
+                             firstDerivatives,
+                             secondDerivatives );
+    Eigen::SelfAdjointEigenSolver< EigenMatrix >
+    eigensystemSolver( valuesMatrix,
+                       Eigen::ComputeEigenvectors );
+    EigenMatrix const& eigenvectors( eigensystemSolver.eigenvectors() );
+    std::vector< double > summandFirstDerivatives( numberOfRows );
+    std::vector< double > summandSecondDerivatives( numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
     {
-      massesSquared[ rowIndex ] = eigenvalueFinder.eigenvalues()( rowIndex );
+      LoopSummandDerivatives( eigensystemSolver.eigenvalues()( rowIndex ),
+                              inverseScaleSquared,
+                              subtractFromLogarithm,
+                              summandFirstDerivatives[ rowIndex ],
+                              summandSecondDerivatives[ rowIndex ] );
+    }
+
+    // The second-order perturbation of the sum couples each pair of
+    // eigenstates with the divided difference of the first derivative of the
+    // summand, which becomes the second derivative for (nearly) degenerate
+    // eigenvalues.
+    Eigen::MatrixXd dividedDifferences( numberOfRows,
+                                        numberOfRows );
+    for( size_t rowIndex( 0 );
+         rowIndex < numberOfRows;
+         ++rowIndex )
+    {
+      double const
+      rowEigenvalue( eigensystemSolver.eigenvalues()( rowIndex ) );
+      for( size_t columnIndex( 0 );
+           columnIndex < numberOfRows;
+           ++columnIndex )
+      {
+        double const
+        columnEigenvalue( eigensystemSolver.eigenvalues()( columnIndex ) );
+        double const eigenvalueDifference( rowEigenvalue - columnEigenvalue );
+        if( std::abs( eigenvalueDifference )
+            > ( 1.0E-9 * ( std::abs( rowEigenvalue )
+                           + std::abs( columnEigenvalue ) ) ) )
+        {
+          dividedDifferences( rowIndex,
+                              columnIndex )
+          = ( ( summandFirstDerivatives[ rowIndex ]
+                - summandFirstDerivatives[ columnIndex ] )
+              / eigenvalueDifference );
+        }
+        else
+        {
+          dividedDifferences( rowIndex,
+                              columnIndex )
+          = ( 0.5 * ( summandSecondDerivatives[ rowIndex ]
+                      + summandSecondDerivatives[ columnIndex ] ) );
+        }
+      }
+    }
+
+    // The derivatives of the matrix are rotated into the eigenbasis once per
+    // field, skipping fields on which the matrix does not depend at all.
+    std::vector< EigenMatrix > rotatedFirstDerivatives( numberOfFields );
+    std::vector< bool > fieldAffectsMatrix( numberOfFields,
+                                            false );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      if( firstDerivatives[ fieldIndex ].isZero( 0.0 ) )
+      {
+        continue;
+      }
+      fieldAffectsMatrix[ fieldIndex ] = true;
+      rotatedFirstDerivatives[ fieldIndex ]
+      = ( eigenvectors.adjoint() * firstDerivatives[ fieldIndex ]
+          * eigenvectors );
+      double firstDerivative( 0.0 );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        firstDerivative += ( summandFirstDerivatives[ rowIndex ]
+                             * std::real( rotatedFirstDerivatives[ fieldIndex ](
+                                                                      rowIndex,
+                                                                rowIndex ) ) );
+      }
+      gradientVector[ fieldIndex ] += ( weightFactor * firstDerivative );
+    }
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      for( size_t secondField( firstField );
+           secondField < numberOfFields;
+           ++secondField )
+      {
+        double secondDerivative( 0.0 );
+        EigenMatrix const&
+        matrixSecondDerivative( secondDerivatives[ ( firstField
+                                                     * numberOfFields )
+                                                   + secondField ] );
+        if( !(matrixSecondDerivative.isZero( 0.0 )) )
+        {
+          EigenMatrix const
+          rotatedSecondDerivative( eigenvectors.adjoint()
+                                   * matrixSecondDerivative * eigenvectors );
+          for( size_t rowIndex( 0 );
+               rowIndex < numberOfRows;
+               ++rowIndex )
+          {
+            secondDerivative += ( summandFirstDerivatives[ rowIndex ]
+                                  * std::real( rotatedSecondDerivative(
+                                                                      rowIndex,
+                                                                rowIndex ) ) );
+          }
+        }
+        if( fieldAffectsMatrix[ firstField ]
+            &&
+            fieldAffectsMatrix[ secondField ] )
+        {
+          EigenMatrix const&
+          firstRotated( rotatedFirstDerivatives[ firstField ] );
+          EigenMatrix const&
+          secondRotated( rotatedFirstDerivatives[ secondField ] );
+          for( size_t rowIndex( 0 );
+               rowIndex < numberOfRows;
+               ++rowIndex )
+          {
+            for( size_t columnIndex( 0 );
+                 columnIndex < numberOfRows;
+                 ++columnIndex )
+            {
+              secondDerivative += ( dividedDifferences( rowIndex,
+                                                        columnIndex )
+                                    * std::real( firstRotated( rowIndex,
+                                                               columnIndex )
+                                                 * secondRotated( columnIndex,
+                                                              rowIndex ) ) );
+            }
+          }
+        }
+        hessianMatrix[ firstField ][ secondField ]
+        += ( weightFactor * secondDerivative );
+        if( secondField != firstField )
+        {
+          hessianMatrix[ secondField ][ firstField ]
+          += ( weightFactor * secondDerivative );
+        }
+      }
+    }
+    return true;
+  }
+
+  // This puts the eigenvalues of the matrix for the field configuration given
+  // by fieldConfiguration into massesSquared and their partial derivatives
+  // with respect to the fields into massSquaredGradients, using the values for
+  // the Lagrangian parameters from the last call of UpdateForFixedScale, and
+  // returns true. The derivatives of the eigenvalues are the diagonal elements
+  // of the derivatives of the matrix in its eigenbasis, from first-order
+  // perturbation theory. For degenerate eigenvalues the split between them
+  // depends on the eigenbasis chosen, but their sum, and so any symmetric
+  // function of the masses-squared such as the potential, is still
+  // differentiated correctly.
+  template< typename ElementType > inline bool
+  MassesSquaredFromMatrix< ElementType >::MassesSquaredWithGradients(
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+        std::vector< std::vector< double > >& massSquaredGradients ) const
+  {
+    if( fieldIndependentMassesAreCurrent )
+    {
+      massesSquared = fieldIndependentMassesSquared;
+      massSquaredGradients.assign( numberOfRows,
+                              std::vector< double >( fieldConfiguration.size(),
+                                                     0.0 ) );
+      return true;
+    }
+    EigenMatrix valuesMatrix( EigenMatrix::Zero( numberOfRows,
+                                                 numberOfRows ) );
+    std::vector< EigenMatrix > firstDerivatives( fieldConfiguration.size(),
+                                                 valuesMatrix );
+    std::vector< EigenMatrix > noSecondDerivatives;
+    SetMatrixAndDerivatives( fieldConfiguration,
+                             valuesMatrix,
+                             firstDerivatives,
+                             noSecondDerivatives );
+    EigenvaluesAndDerivatives( valuesMatrix,
+                               firstDerivatives,
+                               massesSquared,
+                               massSquaredGradients );
+    return true;
+  }
+
+  // This puts the eigenvalues of the matrix for the field configuration given
+  // by fieldConfiguration into massesSquared and their partial derivatives
+  // into massSquaredGradients, using the values for the Lagrangian parameters
+  // found in parameterValues, and returns true. The last element of each
+  // massSquaredGradients[ m ] is the derivative with respect to the logarithm
+  // of the scale through the running of the parameters, given their
+  // derivatives in parameterScaleDerivatives, which comes from first-order
+  // perturbation theory just as the field derivatives do.
+  template< typename ElementType > inline bool
+  MassesSquaredFromMatrix< ElementType >::MassesSquaredWithGradients(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          std::vector< double >& massesSquared,
+        std::vector< std::vector< double > >& massSquaredGradients ) const
+  {
+    EigenMatrix valuesMatrix( EigenMatrix::Zero( numberOfRows,
+                                                 numberOfRows ) );
+    std::vector< EigenMatrix >
+    firstDerivatives( ( fieldConfiguration.size() + 1 ),
+                      valuesMatrix );
+    SetRunningMatrixAndDerivatives( parameterValues,
+                                    parameterScaleDerivatives,
+                                    fieldConfiguration,
+                                    valuesMatrix,
+                                    firstDerivatives );
+    EigenvaluesAndDerivatives( valuesMatrix,
+                               firstDerivatives,
+                               massesSquared,
+                               massSquaredGradients );
+    return true;
+  }
+
+  // This puts the eigenvalues of valuesMatrix into massesSquared and, for each
+  // element of firstDerivatives, the derivatives of the eigenvalues from
+  // first-order perturbation theory into massSquaredGradients, so that
+  // massSquaredGradients[ m ][ a ] is the diagonal element for eigenvalue m of
+  // firstDerivatives[ a ] in the eigenbasis of valuesMatrix.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::EigenvaluesAndDerivatives(
+                                               EigenMatrix const& valuesMatrix,
+                            std::vector< EigenMatrix > const& firstDerivatives,
+                                          std::vector< double >& massesSquared,
+        std::vector< std::vector< double > >& massSquaredGradients ) const
+  {
+    size_t const numberOfDerivatives( firstDerivatives.size() );
+    Eigen::SelfAdjointEigenSolver< EigenMatrix >
+    eigensystemSolver( valuesMatrix,
+                       Eigen::ComputeEigenvectors );
+    EigenMatrix const& eigenvectors( eigensystemSolver.eigenvectors() );
+    massesSquared.resize( numberOfRows );
+    massSquaredGradients.assign( numberOfRows,
+                                 std::vector< double >( numberOfDerivatives,
+                                                        0.0 ) );
+    for( size_t rowIndex( 0 );
+         rowIndex < numberOfRows;
+         ++rowIndex )
+    {
+      massesSquared[ rowIndex ] = eigensystemSolver.eigenvalues()( rowIndex );
+    }
+    for( size_t derivativeIndex( 0 );
+         derivativeIndex < numberOfDerivatives;
+         ++derivativeIndex )
+    {
+      if( firstDerivatives[ derivativeIndex ].isZero( 0.0 ) )
+      {
+        continue;
+      }
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        massSquaredGradients[ rowIndex ][ derivativeIndex ]
+        = std::real( eigenvectors.col( rowIndex ).dot(
+                                           firstDerivatives[ derivativeIndex ]
+                                         * eigenvectors.col( rowIndex ) ) );
+      }
+    }
+  }
+
+  // This fills filledElements with the positions of the elements of the
+  // triangle read by the derived class, and duplicateElements with those of
+  // the elements which are identical to an earlier element in filledElements,
+  // if skipZeroElements is true, in which case the elements for which
+  // ElementIsZero returns true are left out of both, and isFieldIndependent is
+  // set to whether none of the remaining elements depend on the fields.
+  // Diagonal elements are only matched with diagonal elements, and
+  // off-diagonal elements with off-diagonal elements, as the derived classes
+  // may treat the diagonal differently (such as leaving out the imaginary
+  // parts for Hermitian matrices).
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::SetFillPattern(
+                                                bool const skipZeroElements )
+  {
+    filledElements.clear();
+    duplicateElements.clear();
+    isFieldIndependent = skipZeroElements;
+    fieldIndependentMassesSquared.clear();
+    fieldIndependentMassesAreCurrent = false;
+    for( size_t rowIndex( 0 );
+         rowIndex < numberOfRows;
+         ++rowIndex )
+    {
+      size_t const firstColumn( readsUpperTriangle ? rowIndex : 0 );
+      size_t const endColumn( readsUpperTriangle ?
+                              numberOfRows :
+                              ( rowIndex + 1 ) );
+      for( size_t columnIndex( firstColumn );
+           columnIndex < endColumn;
+           ++columnIndex )
+      {
+        size_t const elementIndex( ( rowIndex * numberOfRows ) + columnIndex );
+        if( !skipZeroElements )
+        {
+          filledElements.push_back( FilledElement( rowIndex,
+                                                   columnIndex,
+                                                   elementIndex ) );
+          continue;
+        }
+        if( ElementIsZero( elementIndex ) )
+        {
+          continue;
+        }
+        bool const isDiagonal( rowIndex == columnIndex );
+        typename std::vector< FilledElement >::const_iterator
+        sourceElement( filledElements.begin() );
+        while( ( sourceElement < filledElements.end() )
+               &&
+               ( ( ( sourceElement->rowIndex == sourceElement->columnIndex )
+                   != isDiagonal )
+                 ||
+                 !(ElementsAreIdentical( sourceElement->elementIndex,
+                                         elementIndex )) ) )
+        {
+          ++sourceElement;
+        }
+        if( sourceElement < filledElements.end() )
+        {
+          duplicateElements.push_back( DuplicateElement( rowIndex,
+                                                         columnIndex,
+                                                      sourceElement->rowIndex,
+                                               sourceElement->columnIndex ) );
+        }
+        else
+        {
+          filledElements.push_back( FilledElement( rowIndex,
+                                                   columnIndex,
+                                                   elementIndex ) );
+          if( ElementDependsOnFields( elementIndex ) )
+          {
+            isFieldIndependent = false;
+          }
+        }
+      }
+    }
+  }
+
+  // This returns true if any element in the fill pattern depends on the field
+  // with index fieldIndex.
+  template< typename ElementType > inline bool
+  MassesSquaredFromMatrix< ElementType >::DependsOnField(
+                                                size_t const fieldIndex ) const
+  {
+    // Duplicate elements depend on the same fields as their sources, so only
+    // filledElements needs to be checked.
+    for( typename std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
+    {
+      if( ElementDependsOnField( filledElement->elementIndex,
+                                 fieldIndex ) )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // This should be called by UpdateForFixedScale of the derived classes once
+  // they have updated their elements. If the matrix is field independent, it
+  // puts the eigenvalues of the matrix with the updated values of the
+  // Lagrangian parameters into fieldIndependentMassesSquared.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::UpdateFieldIndependentMasses()
+  {
+    if( !isFieldIndependent )
+    {
+      return;
+    }
+    // The elements do not look at the field configuration at all, so an
+    // empty one is enough.
+    std::vector< double > const noFields;
+    fieldIndependentMassesSquared.assign( numberOfRows,
+                                          0.0 );
+    (this->*eigenvalueFinder)( NULL,
+                               noFields,
+                               fieldIndependentMassesSquared );
+    fieldIndependentMassesAreCurrent = true;
+  }
+
+  // This copies the value of each element in duplicateElements from its
+  // source, and the value of its mirror element in the other triangle from the
+  // mirror element of its source, so that it works whether the derived class
+  // writes both triangles or only one. MatrixType can be EigenMatrix or
+  // MatrixMap.
+  template< typename ElementType > template< typename MatrixType > inline void
+  MassesSquaredFromMatrix< ElementType >::CopyDuplicateElements(
+                                             MatrixType& valuesMatrix ) const
+  {
+    for( typename std::vector< DuplicateElement >::const_iterator
+         duplicateElement( duplicateElements.begin() );
+         duplicateElement < duplicateElements.end();
+         ++duplicateElement )
+    {
+      valuesMatrix.coeffRef( duplicateElement->rowIndex,
+                             duplicateElement->columnIndex )
+      = valuesMatrix.coeff( duplicateElement->sourceRowIndex,
+                            duplicateElement->sourceColumnIndex );
+      valuesMatrix.coeffRef( duplicateElement->columnIndex,
+                             duplicateElement->rowIndex )
+      = valuesMatrix.coeff( duplicateElement->sourceColumnIndex,
+                            duplicateElement->sourceRowIndex );
+    }
+  }
+
+  // This calls CopyDuplicateElements on each of valuesMatrices.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::CopyDuplicateElements(
+                             std::vector< EigenMatrix >& valuesMatrices ) const
+  {
+    if( duplicateElements.empty() )
+    {
+      return;
+    }
+    for( typename std::vector< EigenMatrix >::iterator
+         valuesMatrix( valuesMatrices.begin() );
+         valuesMatrix < valuesMatrices.end();
+         ++valuesMatrix )
+    {
+      CopyDuplicateElements( *valuesMatrix );
+    }
+  }
+
+  // This fills massesSquaredByConfiguration with the eigenvalues of each of
+  // the real symmetric matrices in matrixValues, all found together.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::BatchedEigenvalues(
+                           std::vector< Eigen::MatrixXd > const& matrixValues,
+                                                     size_t const numberOfRows,
+     std::vector< std::vector< double > >& massesSquaredByConfiguration )
+  {
+    size_t const batchSize( matrixValues.size() );
+    std::vector< double >
+    elementsByLane( ( numberOfRows * numberOfRows * batchSize ) );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        for( size_t columnIndex( 0 );
+             columnIndex < numberOfRows;
+             ++columnIndex )
+        {
+          elementsByLane[ ( ( rowIndex * numberOfRows ) + columnIndex )
+                          * batchSize + laneIndex ]
+          = matrixValues[ laneIndex ].coeff( rowIndex,
+                                             columnIndex );
+        }
+      }
+    }
+    BatchedSymmetricEigenvalues::RealSymmetricEigenvalues( numberOfRows,
+                                                           batchSize,
+                                                           elementsByLane,
+                                                massesSquaredByConfiguration );
+  }
+
+  // This fills massesSquaredByConfiguration with the eigenvalues of each of
+  // the Hermitian matrices in matrixValues, all found together, reading only
+  // the lower triangles as Eigen::SelfAdjointEigenSolver does.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::BatchedEigenvalues(
+                          std::vector< Eigen::MatrixXcd > const& matrixValues,
+                                                     size_t const numberOfRows,
+     std::vector< std::vector< double > >& massesSquaredByConfiguration )
+  {
+    size_t const batchSize( matrixValues.size() );
+    std::vector< double >
+    realPartsByLane( ( numberOfRows * numberOfRows * batchSize ) );
+    std::vector< double >
+    imaginaryPartsByLane( ( numberOfRows * numberOfRows * batchSize ) );
+    for( size_t laneIndex( 0 );
+         laneIndex < batchSize;
+         ++laneIndex )
+    {
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfRows;
+           ++rowIndex )
+      {
+        for( size_t columnIndex( 0 );
+             columnIndex <= rowIndex;
+             ++columnIndex )
+        {
+          size_t const elementIndex( ( ( rowIndex * numberOfRows )
+                                       + columnIndex ) * batchSize
+                                     + laneIndex );
+          realPartsByLane[ elementIndex ]
+          = matrixValues[ laneIndex ].coeff( rowIndex,
+                                             columnIndex ).real();
+          imaginaryPartsByLane[ elementIndex ]
+          = matrixValues[ laneIndex ].coeff( rowIndex,
+                                             columnIndex ).imag();
+        }
+      }
+    }
+    BatchedSymmetricEigenvalues::HermitianEigenvalues( numberOfRows,
+                                                       batchSize,
+                                                       realPartsByLane,
+                                                       imaginaryPartsByLane,
+                                                massesSquaredByConfiguration );
+  }
+
+  // This returns the eigenvalue finder for fixed-size matrices with
+  // numberOfRows rows if numberOfRows is between 2 and 8 inclusive, and the
+  // eigenvalue finder for dynamic-size matrices otherwise. It is called once
+  // when the matrix is constructed so that the choice is not re-made for
+  // every field configuration.
+  template< typename ElementType > inline
+  typename MassesSquaredFromMatrix< ElementType >::EigenvalueFinder
+  MassesSquaredFromMatrix< ElementType >::ChooseEigenvalueFinder(
+                                                  size_t const numberOfRows )
+  {
+    switch( numberOfRows )
+    {
+      case 2:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 2 >;
+      case 3:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 3 >;
+      case 4:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 4 >;
+      case 5:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 5 >;
+      case 6:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 6 >;
+      case 7:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 7 >;
+      case 8:
+        return &MassesSquaredFromMatrix::template FixedSizeEigenvalues< 8 >;
+      default:
+        return &MassesSquaredFromMatrix::DynamicSizeEigenvalues;
+    }
+  }
+
+  // This assembles the matrix directly into a matrix with compile-time
+  // dimensions, so that nothing is allocated on the heap and Eigen can unroll
+  // its loops, and fills massesSquared with its eigenvalues.
+  template< typename ElementType > template< int FixedRows > inline void
+  MassesSquaredFromMatrix< ElementType >::FixedSizeEigenvalues(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                  std::vector< double >& massesSquared ) const
+  {
+    typedef Eigen::Matrix< ElementType, FixedRows, FixedRows > FixedMatrix;
+    FixedMatrix fixedSizeValues( FixedMatrix::Zero() );
+    AssembleValues( parameterValues,
+                    fieldConfiguration,
+                    MatrixMap( fixedSizeValues.data(),
+                               FixedRows,
+                               FixedRows ) );
+    Eigen::SelfAdjointEigenSolver< FixedMatrix >
+    eigenvalueSolver( fixedSizeValues,
+                      Eigen::EigenvaluesOnly );
+    for( int rowIndex( 0 );
+         rowIndex < FixedRows;
+         ++rowIndex )
+    {
+      massesSquared[ rowIndex ] = eigenvalueSolver.eigenvalues()( rowIndex );
+    }
+  }
+
+  // This assembles the matrix into an EigenMatrix and fills massesSquared with
+  // its eigenvalues, for matrices too large to have a fixed-size
+  // instantiation.
+  template< typename ElementType > inline void
+  MassesSquaredFromMatrix< ElementType >::DynamicSizeEigenvalues(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                  std::vector< double >& massesSquared ) const
+  {
+    EigenMatrix valuesMatrix( EigenMatrix::Zero( numberOfRows,
+                                                 numberOfRows ) );
+    AssembleValues( parameterValues,
+                    fieldConfiguration,
+                    MatrixMap( valuesMatrix.data(),
+                               numberOfRows,
+                               numberOfRows ) );
+    Eigen::SelfAdjointEigenSolver< EigenMatrix >
+    eigenvalueSolver( valuesMatrix,
+                      Eigen::EigenvaluesOnly );
+    for( size_t rowIndex( 0 );
+         rowIndex < massesSquared.size();
+         ++rowIndex )
+    {
+      massesSquared[ rowIndex ] = eigenvalueSolver.eigenvalues()( rowIndex );
     }
-    return massesSquared;
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -30,7 +30,9 @@ namespace VevaciousPlusPlus
     virtual ~RealMassesSquaredMatrix();
 
 
-    // This calls UpdateForFixedScale on each element of matrixElements.
+    // This calls UpdateForFixedScale on each element of matrixElements which
+    // is in the fill pattern, and then finds the eigenvalues if the matrix is
+    // field independent.
     virtual void
     UpdateForFixedScale( std::vector< double > const& parameterValues );
 
@@ -48,35 +50,91 @@ namespace VevaciousPlusPlus
   protected:
     std::vector< ParametersAndFieldsProductSum > matrixElements;
 
-    // This returns a matrix of the values of the elements for a field
+    // This writes the values of the elements in the fill pattern for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const;
+    // Lagrangian parameters found in parameterValues, into both triangles of
+    // valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& parameterValues,
+                    std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const;
 
-    // This returns a matrix of the values of the elements for a field
+    // This writes the values of the elements in the fill pattern for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const;
+    // Lagrangian parameters from the last call of UpdateForFixedScale, into
+    // both triangles of valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const;
+
+    // This sets valuesMatrix to the matrix for a field configuration given by
+    // fieldConfiguration, using the values for the Lagrangian parameters from
+    // the last call of UpdateForFixedScale, and firstDerivatives and
+    // secondDerivatives to its first and second partial derivatives with
+    // respect to the fields, from the exact derivatives of the polynomial
+    // elements in the fill pattern.
+    virtual void SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXd& valuesMatrix,
+                             std::vector< Eigen::MatrixXd >& firstDerivatives,
+                 std::vector< Eigen::MatrixXd >& secondDerivatives ) const;
+
+    // This sets valuesMatrix to the matrix for a field configuration given by
+    // fieldConfiguration, using the values for the Lagrangian parameters found
+    // in parameterValues, and firstDerivatives to its first partial
+    // derivatives with respect to the fields followed by its derivative with
+    // respect to the logarithm of the scale, given the derivatives of the
+    // parameters in parameterScaleDerivatives.
+    virtual void SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXd& valuesMatrix,
+                     std::vector< Eigen::MatrixXd >& firstDerivatives ) const;
+
+    // This returns true if the element with index elementIndex is identically
+    // zero.
+    virtual bool ElementIsZero( size_t const elementIndex ) const
+    { return matrixElements[ elementIndex ].IsZero(); }
+
+    // This returns true if the elements with indices firstIndex and
+    // secondIndex are made of the same terms.
+    virtual bool ElementsAreIdentical( size_t const firstIndex,
+                                       size_t const secondIndex ) const
+    { return matrixElements[ firstIndex ].HasSameTermsAs(
+                                          matrixElements[ secondIndex ] ); }
+
+    // This returns true if the element with index elementIndex has any term
+    // with a non-zero power of any field.
+    virtual bool ElementDependsOnFields( size_t const elementIndex ) const
+    { return ( matrixElements[ elementIndex ].HighestFieldPower() > 0 ); }
+
+    // This returns true if the element with index elementIndex has any term
+    // with a non-zero power of the field with index fieldIndex.
+    virtual bool ElementDependsOnField( size_t const elementIndex,
+                                        size_t const fieldIndex ) const
+    { return matrixElements[ elementIndex ].DependsOnField( fieldIndex ); }
   };
 
 
 
 
 
-  // This calls UpdateForFixedScale on each element of matrixElements.
+  // This calls UpdateForFixedScale on each element of matrixElements which
+  // is in the fill pattern, and then finds the eigenvalues if the matrix is
+  // field independent.
   inline void RealMassesSquaredMatrix::UpdateForFixedScale(
                                  std::vector< double > const& parameterValues )
   {
-    for( std::vector< ParametersAndFieldsProductSum >::iterator
-         parametersAndFieldsProduct( matrixElements.begin() );
-         parametersAndFieldsProduct < matrixElements.end();
-         ++parametersAndFieldsProduct )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
-      parametersAndFieldsProduct->UpdateForFixedScale( parameterValues );
+      matrixElements[ filledElement->elementIndex ].UpdateForFixedScale(
+                                                             parameterValues );
     }
+    UpdateFieldIndependentMasses();
   }
 
   // This is mainly for debugging:
@@ -29,40 +29,90 @@ namespace VevaciousPlusPlus
 
 
   protected:
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& parameterValues,
-                   std::vector< double > const& fieldConfiguration ) const
-    { return LowerTriangleOfSquareMatrix( MatrixToSquare( parameterValues,
-                                                      fieldConfiguration ) ); }
+    // This writes the lower-triangular part of the square of the mass matrix
+    // for a field configuration given by fieldConfiguration, using the values
+    // for the Lagrangian parameters found in parameterValues, into
+    // valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& parameterValues,
+                    std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const
+    { AssembleSquare( &parameterValues,
+                      fieldConfiguration,
+                      valuesMatrix ); }
 
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    virtual Eigen::MatrixXcd
-    CurrentValues( std::vector< double > const& fieldConfiguration ) const
-    { return
-      LowerTriangleOfSquareMatrix( MatrixToSquare( fieldConfiguration ) ); }
+    // This writes the lower-triangular part of the square of the mass matrix
+    // for a field configuration given by fieldConfiguration, using the values
+    // for the Lagrangian parameters from the last call of
+    // UpdateForFixedScale, into valuesMatrix.
+    virtual void
+    AssembleValues( std::vector< double > const& fieldConfiguration,
+                    MatrixMap valuesMatrix ) const
+    { AssembleSquare( NULL,
+                      fieldConfiguration,
+                      valuesMatrix ); }
 
-    // This returns a matrix of the values of the elements for a field
-    // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters found in parameterValues.
-    Eigen::MatrixXcd
-    MatrixToSquare( std::vector< double > const& parameterValues,
-                    std::vector< double > const& fieldConfiguration ) const;
+    // This sets valuesMatrix to the full square of the mass matrix X, which is
+    // X^dagger X, for a field configuration given by fieldConfiguration,
+    // using the values for the Lagrangian parameters from the last call of
+    // UpdateForFixedScale, and firstDerivatives and secondDerivatives to its
+    // first and second partial derivatives with respect to the fields, by the
+    // product rule from the derivatives of X.
+    virtual void SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXcd& valuesMatrix,
+                             std::vector< Eigen::MatrixXcd >& firstDerivatives,
+                 std::vector< Eigen::MatrixXcd >& secondDerivatives ) const;
+
+    // This sets valuesMatrix to the full square of the mass matrix X for a
+    // field configuration given by fieldConfiguration, using the values for
+    // the Lagrangian parameters found in parameterValues, and firstDerivatives
+    // to its first partial derivatives with respect to the fields followed by
+    // its derivative with respect to the logarithm of the scale, given the
+    // derivatives of the parameters in parameterScaleDerivatives, by the
+    // product rule from the derivatives of X.
+    virtual void SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                          Eigen::MatrixXcd& valuesMatrix,
+                    std::vector< Eigen::MatrixXcd >& firstDerivatives ) const;
+
+    // The mass matrix which is squared is kept on the stack if it has no more
+    // rows than this.
+    static int const maximumRowsOnStack = 8;
+    typedef Eigen::Matrix< std::complex< double >,
+                           Eigen::Dynamic,
+                           Eigen::Dynamic,
+                           Eigen::ColMajor,
+                           maximumRowsOnStack,
+                           maximumRowsOnStack > StackComplexMatrix;
+
+    // This writes the lower-triangular part of the square of the mass matrix
+    // for a field configuration given by fieldConfiguration, using the values
+    // for the Lagrangian parameters found in parameterValues, or those from
+    // the last call of UpdateForFixedScale if parameterValues is NULL, into
+    // valuesMatrix, assembling the mass matrix itself on the stack if it is
+    // small enough.
+    void AssembleSquare( std::vector< double > const* parameterValues,
+                         std::vector< double > const& fieldConfiguration,
+                         MatrixMap valuesMatrix ) const;
 
-    // This returns a matrix of the values of the elements for a field
+    // This writes the values of the elements of the mass matrix for a field
     // configuration given by fieldConfiguration, using the values for the
-    // Lagrangian parameters from the last call of UpdateForFixedScale.
-    Eigen::MatrixXcd
-    MatrixToSquare( std::vector< double > const& fieldConfiguration ) const;
+    // Lagrangian parameters found in parameterValues, or those from the last
+    // call of UpdateForFixedScale if parameterValues is NULL, into both
+    // triangles of matrixToSquare, which must be zero in every element which
+    // is not written.
+    void
+    AssembleMatrixToSquare( std::vector< double > const* parameterValues,
+                            std::vector< double > const& fieldConfiguration,
+                            MatrixMap matrixToSquare ) const;
 
-    // This returns a matrix that is the lower-triangular part (only column
-    // index <= row index) of the square of matrixToSquare.
-    Eigen::MatrixXcd LowerTriangleOfSquareMatrix(
-                                Eigen::MatrixXcd const& matrixToSquare ) const;
+    // This writes the lower-triangular part (only column index <= row index)
+    // of the square of matrixToSquare into valuesSquaredMatrix.
+    void LowerTriangleOfSquareMatrix( MatrixMap const& matrixToSquare,
+                                      MatrixMap valuesSquaredMatrix ) const;
   };
 
 } /* namespace VevaciousPlusPlus */
@@ -15,6 +15,7 @@
 #include <stdexcept>
 #include <sstream>
 #include "PotentialMinimization/PotentialMinimum.hpp"
+#include "PotentialEvaluation/BuildingBlocks/PotentialEvaluationCache.hpp"
 
 namespace VevaciousPlusPlus
 {
@@ -28,14 +29,16 @@ namespace VevaciousPlusPlus
       fieldNames(),
       numberOfFields( 0 ),
       dsbFieldInputStrings(),
-      dsbFieldValueInputs() {}
+      dsbFieldValueInputs(),
+      evaluationCache() {}
 
     PotentialFunction( PotentialFunction const& copySource ) :
       lagrangianParameterManager( copySource.lagrangianParameterManager ),
       fieldNames( copySource.fieldNames ),
       numberOfFields( copySource.numberOfFields ),
       dsbFieldInputStrings( copySource.dsbFieldInputStrings ),
-      dsbFieldValueInputs( copySource.dsbFieldValueInputs ) {}
+      dsbFieldValueInputs( copySource.dsbFieldValueInputs ),
+      evaluationCache( copySource.evaluationCache ) {}
 
     virtual ~PotentialFunction() {}
 
@@ -60,6 +63,17 @@ namespace VevaciousPlusPlus
     virtual double operator()( std::vector< double > const& fieldConfiguration,
                                double const temperatureValue = 0.0 ) const = 0;
 
+    // This puts the energy density in GeV^4 of the potential for each of the
+    // field configurations in fieldConfigurations into the corresponding
+    // element of potentialValues, at the temperature in GeV given by
+    // temperatureValue. By default it just calls operator() for each
+    // configuration in turn, but derived classes which can share work across
+    // the configurations can over-write this function.
+    virtual void EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                   double const temperatureValue = 0.0 ) const;
+
     // If overridden, this should write the potential as
     // def PotentialFunction( fv ): return ...
     // in pythonFilename for fv being an array of floating-point numbers in the
@@ -81,6 +95,31 @@ namespace VevaciousPlusPlus
                                std::vector< double > const& fieldConfiguration,
                                   double const numericalStepSize = 1.0 ) const;
 
+    // If overridden, this should place the exact gradient of the potential at
+    // fieldConfiguration for the temperature temperatureValue in
+    // gradientVector and return true. By default it returns false, to
+    // indicate that the potential can only be differentiated numerically,
+    // and callers should then fall back on finite differences (their own, or
+    // SetAsGradientAt).
+    virtual bool
+    SetAsExactGradientAt( std::vector< double >& gradientVector,
+                          std::vector< double > const& fieldConfiguration,
+                          double const temperatureValue = 0.0 ) const
+    { return false; }
+
+    // This numerically evaluates the gradient and the Hessian matrix of second
+    // derivatives at fieldConfiguration for the temperature temperatureValue
+    // by central differences based on steps of numericalStepSize GeV in each
+    // field direction, placing them in gradientVector and hessianMatrix.
+    // Derived classes which can analytically evaluate the derivatives can
+    // over-write this function.
+    virtual void SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                         double const temperatureValue = 0.0,
+                                  double const numericalStepSize = 1.0 ) const;
+
     // This should return the square of the scale (in GeV^2) relevant to
     // tunneling between the given minima for this potential.
     virtual double
@@ -100,6 +139,17 @@ namespace VevaciousPlusPlus
     { return std::vector< double >( numberOfFields,
                                     0.0 ); }
 
+    // This sets the number of slots of the cache of values of the potential
+    // keyed by exact field configuration and temperature. The default of 0
+    // disables the cache. Derived classes are responsible for looking up and
+    // storing values in operator() and for clearing the cache whenever the
+    // Lagrangian parameters change.
+    void SetEvaluationCacheSize( size_t const numberOfSlots )
+    { evaluationCache.SetNumberOfSlots( numberOfSlots ); }
+
+    PotentialEvaluationCache const& EvaluationCache() const
+    { return evaluationCache; }
+
 
   protected:
     LagrangianParameterManager& lagrangianParameterManager;
@@ -107,6 +157,9 @@ namespace VevaciousPlusPlus
     size_t numberOfFields;
     std::vector< std::string > dsbFieldInputStrings;
     std::vector< double > dsbFieldValueInputs;
+    // The cache is mutable because it does not change the value of the
+    // potential, just how fast operator() returns it.
+    mutable PotentialEvaluationCache evaluationCache;
 
     // This updates the values of dsbFieldValueInputs based on asking
     // lagrangianParameterManager for once-off evaluations of the keywords in
@@ -137,6 +190,28 @@ namespace VevaciousPlusPlus
     return stringBuilder.str();
   }
 
+  // This puts the energy density in GeV^4 of the potential for each of the
+  // field configurations in fieldConfigurations into the corresponding
+  // element of potentialValues, at the temperature in GeV given by
+  // temperatureValue. By default it just calls operator() for each
+  // configuration in turn, but derived classes which can share work across
+  // the configurations can over-write this function.
+  inline void PotentialFunction::EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                          double const temperatureValue ) const
+  {
+    potentialValues.resize( fieldConfigurations.size() );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      potentialValues[ configurationIndex ]
+      = (*this)( fieldConfigurations[ configurationIndex ],
+                 temperatureValue );
+    }
+  }
+
   // This numerically evaluates the gradient at fieldConfiguration based on
   // steps of numericalStepSize GeV in each field direction, places the
   // the gradient in gradientVector, and returns the potential evaluated at
@@ -148,17 +223,133 @@ namespace VevaciousPlusPlus
                                          double const numericalStepSize ) const
   {
     gradientVector.resize( numberOfFields );
-    double const potentialValue( (*this)( fieldConfiguration ) );
-    std::vector< double > displacementVector( fieldConfiguration );
+    // The displaced configurations are all evaluated as a single batch, with
+    // the undisplaced configuration at the end.
+    std::vector< std::vector< double > >
+    displacedConfigurations( ( numberOfFields + 1 ),
+                             fieldConfiguration );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      displacedConfigurations[ fieldIndex ][ fieldIndex ] += numericalStepSize;
+    }
+    std::vector< double > potentialValues;
+    EvaluateBatch( displacedConfigurations,
+                   potentialValues );
+    double const potentialValue( potentialValues.back() );
     for( size_t fieldIndex( 0 );
          fieldIndex < numberOfFields;
          ++fieldIndex )
     {
-      displacementVector[ fieldIndex ] += numericalStepSize;
       gradientVector[ fieldIndex ]
-      = ( ( (*this)( displacementVector ) - potentialValue )
+      = ( ( potentialValues[ fieldIndex ] - potentialValue )
           / numericalStepSize );
-      displacementVector[ fieldIndex ] -= numericalStepSize;
+    }
+  }
+
+  // This numerically evaluates the gradient and the Hessian matrix of second
+  // derivatives at fieldConfiguration for the temperature temperatureValue by
+  // central differences based on steps of numericalStepSize GeV in each field
+  // direction, placing them in gradientVector and hessianMatrix. Derived
+  // classes which can analytically evaluate the derivatives can over-write
+  // this function.
+  inline void PotentialFunction::SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                                 double const temperatureValue,
+                                         double const numericalStepSize ) const
+  {
+    gradientVector.assign( numberOfFields,
+                           0.0 );
+    hessianMatrix.assign( numberOfFields,
+                          gradientVector );
+    // The displaced configurations are all evaluated as a single batch: first
+    // the undisplaced configuration, then the pair of configurations displaced
+    // by +/- numericalStepSize in each field, then for each pair of different
+    // fields the four configurations displaced by +/- numericalStepSize in
+    // both fields.
+    size_t const numberOfPairs( ( numberOfFields * ( numberOfFields - 1 ) )
+                                / 2 );
+    std::vector< std::vector< double > >
+    displacedConfigurations( ( 1 + ( 2 * numberOfFields )
+                               + ( 4 * numberOfPairs ) ),
+                             fieldConfiguration );
+    size_t configurationIndex( 1 );
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      displacedConfigurations[ configurationIndex++ ][ firstField ]
+      += numericalStepSize;
+      displacedConfigurations[ configurationIndex++ ][ firstField ]
+      -= numericalStepSize;
+    }
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      for( size_t secondField( firstField + 1 );
+           secondField < numberOfFields;
+           ++secondField )
+      {
+        for( int firstSign( 1 );
+             firstSign >= -1;
+             firstSign -= 2 )
+        {
+          for( int secondSign( 1 );
+               secondSign >= -1;
+               secondSign -= 2 )
+          {
+            std::vector< double >&
+            displacedConfiguration(
+                               displacedConfigurations[ configurationIndex++ ] );
+            displacedConfiguration[ firstField ]
+            += ( firstSign * numericalStepSize );
+            displacedConfiguration[ secondField ]
+            += ( secondSign * numericalStepSize );
+          }
+        }
+      }
+    }
+    std::vector< double > potentialValues;
+    EvaluateBatch( displacedConfigurations,
+                   potentialValues,
+                   temperatureValue );
+    double const potentialValue( potentialValues.front() );
+    double const stepSquared( numericalStepSize * numericalStepSize );
+    configurationIndex = 1;
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      double const plusValue( potentialValues[ configurationIndex++ ] );
+      double const minusValue( potentialValues[ configurationIndex++ ] );
+      gradientVector[ firstField ]
+      = ( ( plusValue - minusValue ) / ( 2.0 * numericalStepSize ) );
+      hessianMatrix[ firstField ][ firstField ]
+      = ( ( plusValue + minusValue - ( 2.0 * potentialValue ) )
+          / stepSquared );
+    }
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      for( size_t secondField( firstField + 1 );
+           secondField < numberOfFields;
+           ++secondField )
+      {
+        double const plusPlus( potentialValues[ configurationIndex++ ] );
+        double const plusMinus( potentialValues[ configurationIndex++ ] );
+        double const minusPlus( potentialValues[ configurationIndex++ ] );
+        double const minusMinus( potentialValues[ configurationIndex++ ] );
+        hessianMatrix[ firstField ][ secondField ]
+        = ( ( plusPlus - plusMinus - minusPlus + minusMinus )
+            / ( 4.0 * stepSquared ) );
+        hessianMatrix[ secondField ][ firstField ]
+        = hessianMatrix[ firstField ][ secondField ];
+      }
     }
   }
 
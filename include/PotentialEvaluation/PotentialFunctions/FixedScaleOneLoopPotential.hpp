@@ -30,7 +30,8 @@ namespace VevaciousPlusPlus
   public:
     FixedScaleOneLoopPotential( std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                      LagrangianParameterManager& lagrangianParameterManager );
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                   bool const deferLoopCorrections = false );
     FixedScaleOneLoopPotential(
                     PotentialFromPolynomialWithMasses const& potentialToCopy );
     virtual ~FixedScaleOneLoopPotential();
@@ -44,6 +45,61 @@ namespace VevaciousPlusPlus
     operator()( std::vector< double > const& fieldConfiguration,
                 double const temperatureValue = 0.0 ) const;
 
+    // This puts the energy density in GeV^4 of the potential for each of the
+    // field configurations in fieldConfigurations into the corresponding
+    // element of potentialValues, at the temperature in GeV given by
+    // temperatureValue. The polynomial parts are evaluated for the whole
+    // batch in a single traversal of their terms, and each mass-squared
+    // matrix is diagonalized for the whole batch together.
+    virtual void EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                   double const temperatureValue = 0.0 ) const;
+
+    // This places the exact gradient of the full one-loop potential with
+    // thermal corrections at fieldConfiguration for the temperature
+    // temperatureValue in gradientVector, from a single forward-mode pass
+    // through the polynomial parts, the mass-squared matrices and their
+    // eigenvalues, and the loop and thermal functions, and returns true unless
+    // a mass-squared matrix could not provide the derivatives of its
+    // eigenvalues.
+    virtual bool
+    SetAsExactGradientAt( std::vector< double >& gradientVector,
+                          std::vector< double > const& fieldConfiguration,
+                          double const temperatureValue = 0.0 ) const
+    { return SetAsFixedScaleGradient( fieldConfiguration,
+                                      inverseRenormalizationScaleSquared,
+                                      temperatureValue,
+                                      true,
+                                      gradientVector ); }
+
+    // This places the exact gradient at zero temperature from
+    // SetAsExactGradientAt in gradientVector, falling back on the numerical
+    // gradient of PotentialFunction::SetAsGradientAt if it is not available.
+    virtual void SetAsGradientAt( std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                  double const numericalStepSize = 1.0 ) const
+    { if( !(SetAsExactGradientAt( gradientVector,
+                                  fieldConfiguration )) )
+      { PotentialFunction::SetAsGradientAt( gradientVector,
+                                            fieldConfiguration,
+                                            numericalStepSize ); } }
+
+    // This places the gradient and the Hessian matrix of second derivatives at
+    // fieldConfiguration for the temperature temperatureValue into
+    // gradientVector and hessianMatrix. At zero temperature they are
+    // evaluated exactly: the tree-level and polynomial loop parts directly,
+    // and the loop sums over the mass-squared matrices by perturbation theory
+    // for the eigenvalues of the matrices. Otherwise, since the thermal
+    // functions are interpolated, they are evaluated numerically by
+    // PotentialFunction::SetAsGradientAndHessianAt.
+    virtual void SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                         double const temperatureValue = 0.0,
+                                  double const numericalStepSize = 1.0 ) const;
+
     // This returns the square of the current renormalization scale.
     virtual double
     ScaleSquaredRelevantToTunneling( PotentialMinimum const& falseVacuum,
@@ -85,25 +141,70 @@ namespace VevaciousPlusPlus
                                std::vector< double > const& fieldConfiguration,
                                           double const temperatureValue ) const
   {
+    double cachedValue;
+    if( evaluationCache.LookUp( fieldConfiguration,
+                                temperatureValue,
+                                cachedValue ) )
+    {
+      return cachedValue;
+    }
     std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      scalarSquareMasses,
-                                      scalarMassesSquaredWithFactors );
     std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      fermionSquareMasses,
-                                      fermionMassesSquaredWithFactors );
     std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      vectorSquareMasses,
-                                      vectorMassesSquaredWithFactors );
-    return ( treeLevelPotential( fieldConfiguration )
-             + polynomialLoopCorrections( fieldConfiguration )
-             + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
-                                          fermionMassesSquaredWithFactors,
-                                          vectorMassesSquaredWithFactors,
-                                          inverseRenormalizationScaleSquared,
-                                          temperatureValue ) );
+    double const
+    polynomialValue( PolynomialValueAndMassesSquared( fieldConfiguration,
+                                                      true,
+                                                scalarMassesSquaredWithFactors,
+                                               fermionMassesSquaredWithFactors,
+                                            vectorMassesSquaredWithFactors ) );
+    double const
+    potentialValue( polynomialValue
+                    + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
+                                               fermionMassesSquaredWithFactors,
+                                                vectorMassesSquaredWithFactors,
+                                            inverseRenormalizationScaleSquared,
+                                                 temperatureValue ) );
+    evaluationCache.Store( fieldConfiguration,
+                           temperatureValue,
+                           potentialValue );
+    return potentialValue;
+  }
+
+  // This places the gradient and the Hessian matrix of second derivatives at
+  // fieldConfiguration for the temperature temperatureValue into
+  // gradientVector and hessianMatrix. At zero temperature they are
+  // evaluated exactly: the tree-level and polynomial loop parts directly,
+  // and the loop sums over the mass-squared matrices by perturbation theory
+  // for the eigenvalues of the matrices. Otherwise, since the thermal
+  // functions are interpolated, they are evaluated numerically by
+  // PotentialFunction::SetAsGradientAndHessianAt.
+  inline void FixedScaleOneLoopPotential::SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                                 double const temperatureValue,
+                                         double const numericalStepSize ) const
+  {
+    if( temperatureValue <= 0.0 )
+    {
+      gradientVector.assign( numberOfFields,
+                             0.0 );
+      hessianMatrix.assign( numberOfFields,
+                            gradientVector );
+      if( AddFixedScaleDerivatives( fieldConfiguration,
+                                    inverseRenormalizationScaleSquared,
+                                    true,
+                                    gradientVector,
+                                    hessianMatrix ) )
+      {
+        return;
+      }
+    }
+    PotentialFunction::SetAsGradientAndHessianAt( gradientVector,
+                                                  hessianMatrix,
+                                                  fieldConfiguration,
+                                                  temperatureValue,
+                                                  numericalStepSize );
   }
 
 } /* namespace VevaciousPlusPlus */
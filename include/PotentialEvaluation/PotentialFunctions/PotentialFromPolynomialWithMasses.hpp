@@ -12,6 +12,7 @@
 #include <string>
 #include "LagrangianParameterManagement/LagrangianParameterManager.hpp"
 #include "PotentialEvaluation/BuildingBlocks/ParametersAndFieldsProductSum.hpp"
+#include "PotentialEvaluation/BuildingBlocks/IncrementalEvaluationState.hpp"
 #include <utility>
 #include <vector>
 #include <cstddef>
@@ -37,9 +38,13 @@ namespace VevaciousPlusPlus
   class PotentialFromPolynomialWithMasses : public PotentialFunction
   {
   public:
+    // If deferLoopCorrections is true, the mass-squared matrices and the
+    // extra polynomial part of <LoopCorrections> in the model file are not
+    // parsed until PrepareLoopCorrections is called.
     PotentialFromPolynomialWithMasses( std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                      LagrangianParameterManager& lagrangianParameterManager );
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                   bool const deferLoopCorrections = false );
     virtual ~PotentialFromPolynomialWithMasses();
 
 
@@ -59,6 +64,27 @@ namespace VevaciousPlusPlus
     // C++ code. It uses the virtual function WriteActualPythonFunction.
     virtual void WriteAsPython( std::string const& pythonFilename ) const;
 
+    // This parses the mass-squared matrices and the extra polynomial part of
+    // <LoopCorrections> if they have not been parsed yet. It has to be called
+    // before the LagrangianParameterManager reads its first parameter point,
+    // as parsing the matrices registers the Lagrangian parameters which
+    // appear in them.
+    void PrepareLoopCorrections();
+
+    // This returns true if the mass-squared matrices have been parsed.
+    bool LoopCorrectionsArePrepared() const { return loopCorrectionsParsed; }
+
+    // This enables or disables the re-use of the values of polynomial terms
+    // and of the masses-squared of mass-squared matrices which do not depend
+    // on any field which changed since the last evaluation. It is disabled by
+    // default. Derived classes are responsible for using it in operator() and
+    // for clearing it whenever the Lagrangian parameters change.
+    void SetIncrementalEvaluation( bool const enableIncrementalEvaluation )
+    { incrementalEvaluation.SetEnabled( enableIncrementalEvaluation ); }
+
+    IncrementalEvaluationState const& IncrementalEvaluation() const
+    { return incrementalEvaluation; }
+
     // This is for debugging.
     std::string AsDebuggingString() const;
 
@@ -103,8 +129,21 @@ namespace VevaciousPlusPlus
     std::vector< size_t > fieldsAssumedNegative;
     double const assumedPositiveOrNegativeTolerance;
     bool readImaginaryPartForRealValue;
+    std::string modelFilename;
+    // This is the body of <LoopCorrections> from the model file, kept until
+    // the mass-squared matrices are parsed from it.
+    std::string unparsedLoopCorrections;
+    bool loopCorrectionsParsed;
+    // The incremental evaluation state is mutable for the same reason as
+    // evaluationCache is.
+    mutable IncrementalEvaluationState incrementalEvaluation;
 
 
+    // This parses the mass-squared matrices and the extra polynomial part of
+    // <LoopCorrections> from unparsedLoopCorrections, and fills the
+    // MassesSquaredCalculator* vectors.
+    void ParseLoopCorrections();
+
     // This is just for derived classes.
     PotentialFromPolynomialWithMasses(
                       LagrangianParameterManager& lagrangianParameterManager );
@@ -174,6 +213,41 @@ namespace VevaciousPlusPlus
             std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
        std::vector< DoubleVectorWithDouble >& massesSquaredWithFactors ) const;
 
+    // This appends the masses-squared and multiplicities of the scalars,
+    // fermions, and vectors for fieldConfiguration, with all Lagrangian
+    // parameters evaluated at the last scale which was used to update them,
+    // and returns the value of treeLevelPotential, plus that of
+    // polynomialLoopCorrections if includePolynomialLoopCorrections is true.
+    // It goes through incrementalEvaluation when that can be used, which
+    // gives exactly the same values as the full evaluation.
+    double PolynomialValueAndMassesSquared(
+                               std::vector< double > const& fieldConfiguration,
+                                  bool const includePolynomialLoopCorrections,
+         std::vector< DoubleVectorWithDouble >& scalarMassesSquaredWithFactors,
+        std::vector< DoubleVectorWithDouble >& fermionMassesSquaredWithFactors,
+      std::vector< DoubleVectorWithDouble >& vectorMassesSquaredWithFactors )
+    const;
+
+    // This appends the masses-squared and multiplicity from each
+    // MassesSquaredFromMatrix in massSquaredMatrices for each of the field
+    // configurations in fieldConfigurations to the corresponding element of
+    // massesSquaredWithFactorsByConfiguration, with all Lagrangian parameters
+    // evaluated at the last scale which was used to update them. Each matrix
+    // is evaluated for the whole batch of configurations at once.
+    void AddMassesSquaredWithMultiplicityForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                          std::vector< std::vector< DoubleVectorWithDouble > >&
+                               massesSquaredWithFactorsByConfiguration ) const;
+
+    // This fills fieldValuesByIndex with the values of fieldConfigurations in
+    // structure-of-arrays form, so that fieldValuesByIndex[ f ][ c ] is the
+    // value of the field with index f in configuration c, as required by
+    // ParametersAndFieldsProductSum::AddToBatch.
+    void FieldValuesByIndex(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+       std::vector< std::vector< double > >& fieldValuesByIndex ) const;
+
     // This evaluates the sum of corrections for the degrees of freedom with
     // masses-squared given by massesSquaredWithFactors with
     // subtractFromLogarithm as the constant to subtract from the logarithm of
@@ -191,6 +265,135 @@ namespace VevaciousPlusPlus
                            double& cumulativeQuantumCorrection,
                            double& cumulativeThermalCorrection ) const;
 
+    // This adds the exact gradient and Hessian with respect to the fields at
+    // fieldConfiguration of the tree-level potential, and also of the
+    // polynomial loop corrections and the zero-temperature one-loop
+    // corrections from the mass-squared matrices if includeLoopCorrections is
+    // true, with all Lagrangian parameters evaluated at the last scale which
+    // was used to update them and inverseScaleSquared as the inverse of the
+    // square of the renormalization scale, to gradientVector and
+    // hessianMatrix. It returns false if any of the mass-squared matrices
+    // could not provide its derivatives, in which case gradientVector and
+    // hessianMatrix are incomplete.
+    bool AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                   double const inverseScaleSquared,
+                                   bool const includeLoopCorrections,
+                                   std::vector< double >& gradientVector,
+                   std::vector< std::vector< double > >& hessianMatrix ) const;
+
+    // This places the exact gradient with respect to the fields at
+    // fieldConfiguration of the tree-level potential plus the thermal
+    // corrections for the temperature temperatureValue, and also of the
+    // polynomial loop corrections and the one-loop corrections if
+    // includeLoopCorrections is true, in gradientVector, with all Lagrangian
+    // parameters evaluated at the last scale which was used to update them and
+    // inverseScaleSquared as the inverse of the square of the renormalization
+    // scale. This is a single forward-mode pass: the derivatives with respect
+    // to all the fields are carried along with the values through the
+    // polynomials, the mass-squared matrices and their eigenvalues, and the
+    // loop and thermal functions of the eigenvalues. It returns false if any
+    // of the mass-squared matrices could not provide the derivatives of its
+    // eigenvalues, in which case gradientVector is incomplete.
+    bool SetAsFixedScaleGradient(
+                               std::vector< double > const& fieldConfiguration,
+                                  double const inverseScaleSquared,
+                                  double const temperatureValue,
+                                  bool const includeLoopCorrections,
+                                  std::vector< double >& gradientVector ) const;
+
+    // This places the exact gradient at fieldConfiguration of the tree-level
+    // potential plus the one-loop and thermal corrections for the temperature
+    // temperatureValue in gradientVector, with the Lagrangian parameters given
+    // by parameterValues and inverseScaleSquared as the inverse of the square
+    // of the renormalization scale, in the same forward-mode pass as
+    // SetAsFixedScaleGradient. gradientVector is given one more element than
+    // fieldConfiguration: the first elements are the partial derivatives with
+    // respect to the fields at fixed scale, and the last is the partial
+    // derivative with respect to the logarithm of the scale at fixed fields,
+    // both through the running of the parameters, given their derivatives in
+    // parameterScaleDerivatives, and explicitly through the logarithms of the
+    // one-loop corrections. It returns false if any of the mass-squared
+    // matrices could not provide the derivatives of its eigenvalues, in which
+    // case gradientVector is incomplete.
+    bool SetAsRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                    double const inverseScaleSquared,
+                                    double const temperatureValue,
+                                  std::vector< double >& gradientVector ) const;
+
+    // This adds the derivatives with respect to the fields of the sum over the
+    // masses-squared m of each of the mass-squared matrices in
+    // massSquaredMatrices, weighted by its multiplicity factor, of
+    // quantumWeight * m^2 ( ln( |m| * inverseScaleSquared )
+    // - subtractFromLogarithm ) + thermalWeight * ThermalFunction( |m|
+    // * inverseTemperatureSquared ) to gradientVector, with the thermal part
+    // only if inverseTemperatureSquared is positive. It returns false if any
+    // of the matrices could not provide the derivatives of its
+    // masses-squared.
+    bool AddMassesSquaredSumGradient(
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                      double const inverseScaleSquared,
+                                      double const subtractFromLogarithm,
+                                      double const quantumWeight,
+                                      double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                      double const thermalWeight,
+                                  std::vector< double >& gradientVector ) const;
+
+    // This adds the derivatives of the same sums as the other
+    // AddMassesSquaredSumGradient, but with the masses-squared evaluated with
+    // the Lagrangian parameters given by parameterValues, to the first
+    // elements of gradientVector, and their derivative with respect to the
+    // logarithm of the scale, through the running of the parameters given by
+    // parameterScaleDerivatives and explicitly through the logarithm of the
+    // quantum corrections, to its last element.
+    bool AddMassesSquaredSumGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                      double const inverseScaleSquared,
+                                      double const subtractFromLogarithm,
+                                      double const quantumWeight,
+                                      double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                      double const thermalWeight,
+                                  std::vector< double >& gradientVector ) const;
+
+    // This adds the derivatives of quantumWeight * m^2 ( ln( |m|
+    // * inverseScaleSquared ) - subtractFromLogarithm ) + thermalWeight
+    // * ThermalFunction( |m| * inverseTemperatureSquared ) summed over the
+    // masses-squared m in massesSquared, weighted by multiplicityFactor, to
+    // gradientVector by the chain rule from the derivatives of the
+    // masses-squared in massSquaredGradients.
+    void AddMassesSquaredChainRule( std::vector< double > const& massesSquared,
+             std::vector< std::vector< double > > const& massSquaredGradients,
+                                    double const multiplicityFactor,
+                                    double const inverseScaleSquared,
+                                    double const subtractFromLogarithm,
+                                    double const quantumWeight,
+                                    double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                    double const thermalWeight,
+                                  std::vector< double >& gradientVector ) const;
+
+    // This adds the derivatives of the one-loop sums of each of the
+    // mass-squared matrices in massSquaredMatrices, weighted by weightFactor
+    // times its multiplicity factor, to gradientVector and hessianMatrix, and
+    // returns false if any of them could not provide its derivatives.
+    bool AddLoopSumDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                double const inverseScaleSquared,
+                                double const subtractFromLogarithm,
+                                double const weightFactor,
+                                std::vector< double >& gradientVector,
+                   std::vector< std::vector< double > >& hessianMatrix ) const;
+
     // This should return a string that is valid Python with no indentedation
     // to evaluate the potential in three functions:
     // TreeLevelPotential( fv ), JustLoopCorrectedPotential( fv ), and
@@ -254,6 +457,435 @@ namespace VevaciousPlusPlus
     = complexSum.first.ParametersAndFieldsProducts();
   }
 
+  // This adds the exact gradient and Hessian with respect to the fields at
+  // fieldConfiguration of the tree-level potential, and also of the polynomial
+  // loop corrections and the zero-temperature one-loop corrections from the
+  // mass-squared matrices if includeLoopCorrections is true, with all
+  // Lagrangian parameters evaluated at the last scale which was used to update
+  // them and inverseScaleSquared as the inverse of the square of the
+  // renormalization scale, to gradientVector and hessianMatrix. It returns
+  // false if any of the mass-squared matrices could not provide its
+  // derivatives, in which case gradientVector and hessianMatrix are
+  // incomplete.
+  inline bool PotentialFromPolynomialWithMasses::AddFixedScaleDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                              double const inverseScaleSquared,
+                                             bool const includeLoopCorrections,
+                                         std::vector< double >& gradientVector,
+                    std::vector< std::vector< double > >& hessianMatrix ) const
+  {
+    treeLevelPotential.AddFixedScaleDerivatives( fieldConfiguration,
+                                                 gradientVector,
+                                                 hessianMatrix );
+    if( !includeLoopCorrections )
+    {
+      return true;
+    }
+    polynomialLoopCorrections.AddFixedScaleDerivatives( fieldConfiguration,
+                                                        gradientVector,
+                                                        hessianMatrix );
+    // The weights match those used in LoopAndThermalCorrections: real
+    // scalars with no extra factor, Weyl fermions with a factor of -2, and
+    // vector bosons with a factor of 3.
+    return ( AddLoopSumDerivatives( fieldConfiguration,
+                                    scalarSquareMasses,
+                                    inverseScaleSquared,
+                                    1.5,
+                                    loopFactor,
+                                    gradientVector,
+                                    hessianMatrix )
+             &&
+             AddLoopSumDerivatives( fieldConfiguration,
+                                    fermionSquareMasses,
+                                    inverseScaleSquared,
+                                    1.5,
+                                    ( -2.0 * loopFactor ),
+                                    gradientVector,
+                                    hessianMatrix )
+             &&
+             AddLoopSumDerivatives( fieldConfiguration,
+                                    vectorSquareMasses,
+                                    inverseScaleSquared,
+                                    vectorMassCorrectionConstant,
+                                    ( 3.0 * loopFactor ),
+                                    gradientVector,
+                                    hessianMatrix ) );
+  }
+
+  // This adds the derivatives of the one-loop sums of each of the mass-squared
+  // matrices in massSquaredMatrices, weighted by weightFactor times its
+  // multiplicity factor, to gradientVector and hessianMatrix, and returns
+  // false if any of them could not provide its derivatives.
+  inline bool PotentialFromPolynomialWithMasses::AddLoopSumDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                     double const weightFactor,
+                                         std::vector< double >& gradientVector,
+                    std::vector< std::vector< double > >& hessianMatrix ) const
+  {
+    for( std::vector< MassesSquaredCalculator* >::const_iterator
+         whichMatrix( massSquaredMatrices.begin() );
+         whichMatrix < massSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      if( !((*whichMatrix)->AddLoopSumDerivatives( fieldConfiguration,
+                                                   inverseScaleSquared,
+                                                   subtractFromLogarithm,
+                                                   ( weightFactor
+                                       * (*whichMatrix)->MultiplicityFactor() ),
+                                                   gradientVector,
+                                                   hessianMatrix )) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // This places the exact gradient with respect to the fields at
+  // fieldConfiguration of the tree-level potential plus the thermal
+  // corrections for the temperature temperatureValue, and also of the
+  // polynomial loop corrections and the one-loop corrections if
+  // includeLoopCorrections is true, in gradientVector, with all Lagrangian
+  // parameters evaluated at the last scale which was used to update them and
+  // inverseScaleSquared as the inverse of the square of the renormalization
+  // scale. This is a single forward-mode pass: the derivatives with respect to
+  // all the fields are carried along with the values through the polynomials,
+  // the mass-squared matrices and their eigenvalues, and the loop and thermal
+  // functions of the eigenvalues. It returns false if any of the mass-squared
+  // matrices could not provide the derivatives of its eigenvalues, in which
+  // case gradientVector is incomplete.
+  inline bool PotentialFromPolynomialWithMasses::SetAsFixedScaleGradient(
+                               std::vector< double > const& fieldConfiguration,
+                                              double const inverseScaleSquared,
+                                                 double const temperatureValue,
+                                             bool const includeLoopCorrections,
+                                   std::vector< double >& gradientVector ) const
+  {
+    gradientVector.assign( fieldConfiguration.size(),
+                           0.0 );
+    // An empty Hessian means that only the gradient is worked out.
+    std::vector< std::vector< double > > noHessian;
+    treeLevelPotential.AddFixedScaleDerivatives( fieldConfiguration,
+                                                 gradientVector,
+                                                 noHessian );
+    double quantumWeight( 0.0 );
+    if( includeLoopCorrections )
+    {
+      polynomialLoopCorrections.AddFixedScaleDerivatives( fieldConfiguration,
+                                                          gradientVector,
+                                                          noHessian );
+      quantumWeight = loopFactor;
+    }
+    double inverseTemperatureSquared( -1.0 );
+    double thermalWeight( 0.0 );
+    if( temperatureValue > 0.0 )
+    {
+      inverseTemperatureSquared
+      = ( 1.0 / ( temperatureValue * temperatureValue ) );
+      thermalWeight = ( thermalFactor
+                        * temperatureValue * temperatureValue
+                        * temperatureValue * temperatureValue );
+    }
+    if( ( quantumWeight == 0.0 )
+        &&
+        ( thermalWeight == 0.0 ) )
+    {
+      return true;
+    }
+    // The factors match those used in LoopAndThermalCorrections: real scalars
+    // with no extra factor, Weyl fermions with a factor of -2 for the quantum
+    // corrections and 2 for the thermal corrections, and vector bosons with a
+    // factor of 3 for the quantum corrections and 2 for the thermal
+    // corrections.
+    return ( AddMassesSquaredSumGradient( fieldConfiguration,
+                                          scalarSquareMasses,
+                                          inverseScaleSquared,
+                                          1.5,
+                                          quantumWeight,
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::BosonicJSlope),
+                                          thermalWeight,
+                                          gradientVector )
+             &&
+             AddMassesSquaredSumGradient( fieldConfiguration,
+                                          fermionSquareMasses,
+                                          inverseScaleSquared,
+                                          1.5,
+                                          ( -2.0 * quantumWeight ),
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::FermionicJSlope),
+                                          ( 2.0 * thermalWeight ),
+                                          gradientVector )
+             &&
+             AddMassesSquaredSumGradient( fieldConfiguration,
+                                          vectorSquareMasses,
+                                          inverseScaleSquared,
+                                          vectorMassCorrectionConstant,
+                                          ( 3.0 * quantumWeight ),
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::BosonicJSlope),
+                                          ( 2.0 * thermalWeight ),
+                                          gradientVector ) );
+  }
+
+  // This places the exact gradient at fieldConfiguration of the tree-level
+  // potential plus the one-loop and thermal corrections for the temperature
+  // temperatureValue in gradientVector, with the Lagrangian parameters given
+  // by parameterValues and inverseScaleSquared as the inverse of the square of
+  // the renormalization scale, in the same forward-mode pass as
+  // SetAsFixedScaleGradient. gradientVector is given one more element than
+  // fieldConfiguration: the first elements are the partial derivatives with
+  // respect to the fields at fixed scale, and the last is the partial
+  // derivative with respect to the logarithm of the scale at fixed fields,
+  // both through the running of the parameters, given their derivatives in
+  // parameterScaleDerivatives, and explicitly through the logarithms of the
+  // one-loop corrections. It returns false if any of the mass-squared matrices
+  // could not provide the derivatives of its eigenvalues, in which case
+  // gradientVector is incomplete.
+  inline bool PotentialFromPolynomialWithMasses::SetAsRunningScaleGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                              double const inverseScaleSquared,
+                                                 double const temperatureValue,
+                                   std::vector< double >& gradientVector ) const
+  {
+    gradientVector.assign( ( fieldConfiguration.size() + 1 ),
+                           0.0 );
+    treeLevelPotential.AddRunningScaleGradient( parameterValues,
+                                                parameterScaleDerivatives,
+                                                fieldConfiguration,
+                                                gradientVector );
+    polynomialLoopCorrections.AddRunningScaleGradient( parameterValues,
+                                                     parameterScaleDerivatives,
+                                                       fieldConfiguration,
+                                                       gradientVector );
+    double inverseTemperatureSquared( -1.0 );
+    double thermalWeight( 0.0 );
+    if( temperatureValue > 0.0 )
+    {
+      inverseTemperatureSquared
+      = ( 1.0 / ( temperatureValue * temperatureValue ) );
+      thermalWeight = ( thermalFactor
+                        * temperatureValue * temperatureValue
+                        * temperatureValue * temperatureValue );
+    }
+    // The factors are the same as in SetAsFixedScaleGradient.
+    return ( AddMassesSquaredSumGradient( parameterValues,
+                                          parameterScaleDerivatives,
+                                          fieldConfiguration,
+                                          scalarSquareMasses,
+                                          inverseScaleSquared,
+                                          1.5,
+                                          loopFactor,
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::BosonicJSlope),
+                                          thermalWeight,
+                                          gradientVector )
+             &&
+             AddMassesSquaredSumGradient( parameterValues,
+                                          parameterScaleDerivatives,
+                                          fieldConfiguration,
+                                          fermionSquareMasses,
+                                          inverseScaleSquared,
+                                          1.5,
+                                          ( -2.0 * loopFactor ),
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::FermionicJSlope),
+                                          ( 2.0 * thermalWeight ),
+                                          gradientVector )
+             &&
+             AddMassesSquaredSumGradient( parameterValues,
+                                          parameterScaleDerivatives,
+                                          fieldConfiguration,
+                                          vectorSquareMasses,
+                                          inverseScaleSquared,
+                                          vectorMassCorrectionConstant,
+                                          ( 3.0 * loopFactor ),
+                                          inverseTemperatureSquared,
+                                          &(ThermalFunctions::BosonicJSlope),
+                                          ( 2.0 * thermalWeight ),
+                                          gradientVector ) );
+  }
+
+  // This adds the derivatives with respect to the fields of the sum over the
+  // masses-squared m of each of the mass-squared matrices in
+  // massSquaredMatrices, weighted by its multiplicity factor, of
+  // quantumWeight * m^2 ( ln( |m| * inverseScaleSquared )
+  // - subtractFromLogarithm ) + thermalWeight * ThermalFunction( |m|
+  // * inverseTemperatureSquared ) to gradientVector, with the thermal part only
+  // if inverseTemperatureSquared is positive. It returns false if any of the
+  // matrices could not provide the derivatives of its masses-squared.
+  inline bool PotentialFromPolynomialWithMasses::AddMassesSquaredSumGradient(
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                    double const quantumWeight,
+                                        double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                                    double const thermalWeight,
+                                   std::vector< double >& gradientVector ) const
+  {
+    std::vector< double > massesSquared;
+    std::vector< std::vector< double > > massSquaredGradients;
+    for( std::vector< MassesSquaredCalculator* >::const_iterator
+         whichMatrix( massSquaredMatrices.begin() );
+         whichMatrix < massSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      if( !((*whichMatrix)->MassesSquaredWithGradients( fieldConfiguration,
+                                                        massesSquared,
+                                                    massSquaredGradients )) )
+      {
+        return false;
+      }
+      AddMassesSquaredChainRule( massesSquared,
+                                 massSquaredGradients,
+                                 (*whichMatrix)->MultiplicityFactor(),
+                                 inverseScaleSquared,
+                                 subtractFromLogarithm,
+                                 quantumWeight,
+                                 inverseTemperatureSquared,
+                                 ThermalFunctionSlope,
+                                 thermalWeight,
+                                 gradientVector );
+    }
+    return true;
+  }
+
+  // This adds the derivatives of the same sums as the other
+  // AddMassesSquaredSumGradient, but with the masses-squared evaluated with
+  // the Lagrangian parameters given by parameterValues, to the first elements
+  // of gradientVector, and their derivative with respect to the logarithm of
+  // the scale, through the running of the parameters given by
+  // parameterScaleDerivatives and explicitly through the logarithm of the
+  // quantum corrections, to its last element.
+  inline bool PotentialFromPolynomialWithMasses::AddMassesSquaredSumGradient(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                    double const quantumWeight,
+                                        double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                                    double const thermalWeight,
+                                   std::vector< double >& gradientVector ) const
+  {
+    std::vector< double > massesSquared;
+    std::vector< std::vector< double > > massSquaredGradients;
+    for( std::vector< MassesSquaredCalculator* >::const_iterator
+         whichMatrix( massSquaredMatrices.begin() );
+         whichMatrix < massSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      if( !((*whichMatrix)->MassesSquaredWithGradients( parameterValues,
+                                                     parameterScaleDerivatives,
+                                                        fieldConfiguration,
+                                                        massesSquared,
+                                                    massSquaredGradients )) )
+      {
+        return false;
+      }
+      double const multiplicityFactor( (*whichMatrix)->MultiplicityFactor() );
+      AddMassesSquaredChainRule( massesSquared,
+                                 massSquaredGradients,
+                                 multiplicityFactor,
+                                 inverseScaleSquared,
+                                 subtractFromLogarithm,
+                                 quantumWeight,
+                                 inverseTemperatureSquared,
+                                 ThermalFunctionSlope,
+                                 thermalWeight,
+                                 gradientVector );
+      // The derivative of m^2 ( ln( |m| / Q^2 ) - c ) with respect to ln( Q )
+      // at fixed m is -2 m^2.
+      for( std::vector< double >::const_iterator
+           massSquared( massesSquared.begin() );
+           massSquared < massesSquared.end();
+           ++massSquared )
+      {
+        gradientVector.back() -= ( 2.0 * quantumWeight * multiplicityFactor
+                                   * (*massSquared) * (*massSquared) );
+      }
+    }
+    return true;
+  }
+
+  // This adds the derivatives of quantumWeight * m^2 ( ln( |m|
+  // * inverseScaleSquared ) - subtractFromLogarithm ) + thermalWeight
+  // * ThermalFunction( |m| * inverseTemperatureSquared ) summed over the
+  // masses-squared m in massesSquared, weighted by multiplicityFactor, to
+  // gradientVector by the chain rule from the derivatives of the
+  // masses-squared in massSquaredGradients.
+  inline void PotentialFromPolynomialWithMasses::AddMassesSquaredChainRule(
+                                    std::vector< double > const& massesSquared,
+              std::vector< std::vector< double > > const& massSquaredGradients,
+                                               double const multiplicityFactor,
+                                              double const inverseScaleSquared,
+                                            double const subtractFromLogarithm,
+                                                    double const quantumWeight,
+                                        double const inverseTemperatureSquared,
+                                 double (*ThermalFunctionSlope)( double const ),
+                                                    double const thermalWeight,
+                                   std::vector< double >& gradientVector ) const
+  {
+    bool const temperatureGreaterThanZero( inverseTemperatureSquared > 0.0 );
+    double summandDerivative( 0.0 );
+    double unusedSecondDerivative( 0.0 );
+    for( size_t massIndex( 0 );
+         massIndex < massesSquared.size();
+         ++massIndex )
+    {
+      double const massSquared( massesSquared[ massIndex ] );
+      double chainFactor( 0.0 );
+      if( quantumWeight != 0.0 )
+      {
+        MassesSquaredCalculator::LoopSummandDerivatives( massSquared,
+                                                         inverseScaleSquared,
+                                                         subtractFromLogarithm,
+                                                         summandDerivative,
+                                                      unusedSecondDerivative );
+        chainFactor += ( quantumWeight * summandDerivative );
+      }
+      if( temperatureGreaterThanZero
+          &&
+          ( massSquared != 0.0 ) )
+      {
+        // The thermal functions are evaluated for the absolute value of the
+        // mass-squared, so the sign of the mass-squared enters the chain
+        // rule.
+        double const absoluteDerivative( thermalWeight
+                                         * inverseTemperatureSquared
+                                         * (*ThermalFunctionSlope)(
+                                                       std::abs( massSquared )
+                                             * inverseTemperatureSquared ) );
+        chainFactor += ( ( massSquared < 0.0 ) ?
+                         -absoluteDerivative :
+                         absoluteDerivative );
+      }
+      if( chainFactor == 0.0 )
+      {
+        continue;
+      }
+      chainFactor *= multiplicityFactor;
+      std::vector< double > const&
+      massSquaredGradient( massSquaredGradients[ massIndex ] );
+      for( size_t derivativeIndex( 0 );
+           derivativeIndex < gradientVector.size();
+           ++derivativeIndex )
+      {
+        gradientVector[ derivativeIndex ]
+        += ( chainFactor * massSquaredGradient[ derivativeIndex ] );
+      }
+    }
+  }
+
   // This appends the masses-squared and multiplicity from each
   // MassesSquaredFromMatrix in massSquaredMatrices to massSquaredMatrices,
   // with the values of the Lagrangian parameters given in parameterValues.
@@ -297,5 +929,128 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This appends the masses-squared and multiplicities of the scalars,
+  // fermions, and vectors for fieldConfiguration, with all Lagrangian
+  // parameters evaluated at the last scale which was used to update them, and
+  // returns the value of treeLevelPotential, plus that of
+  // polynomialLoopCorrections if includePolynomialLoopCorrections is true. It
+  // goes through incrementalEvaluation when that can be used, which gives
+  // exactly the same values as the full evaluation.
+  inline double
+  PotentialFromPolynomialWithMasses::PolynomialValueAndMassesSquared(
+                               std::vector< double > const& fieldConfiguration,
+                                  bool const includePolynomialLoopCorrections,
+         std::vector< DoubleVectorWithDouble >& scalarMassesSquaredWithFactors,
+        std::vector< DoubleVectorWithDouble >& fermionMassesSquaredWithFactors,
+       std::vector< DoubleVectorWithDouble >& vectorMassesSquaredWithFactors )
+  const
+  {
+    if( !(incrementalEvaluation.BeginConfiguration( fieldConfiguration )) )
+    {
+      AddMassesSquaredWithMultiplicity( fieldConfiguration,
+                                        scalarSquareMasses,
+                                        scalarMassesSquaredWithFactors );
+      AddMassesSquaredWithMultiplicity( fieldConfiguration,
+                                        fermionSquareMasses,
+                                        fermionMassesSquaredWithFactors );
+      AddMassesSquaredWithMultiplicity( fieldConfiguration,
+                                        vectorSquareMasses,
+                                        vectorMassesSquaredWithFactors );
+      if( includePolynomialLoopCorrections )
+      {
+        return ( treeLevelPotential( fieldConfiguration )
+                 + polynomialLoopCorrections( fieldConfiguration ) );
+      }
+      return treeLevelPotential( fieldConfiguration );
+    }
+    // The indices given to incrementalEvaluation just have to distinguish the
+    // sums and the groups of matrices from each other.
+    incrementalEvaluation.AddMassesSquaredWithMultiplicity( scalarSquareMasses,
+                                                            0,
+                                                            fieldConfiguration,
+                                              scalarMassesSquaredWithFactors );
+    incrementalEvaluation.AddMassesSquaredWithMultiplicity(
+                                                           fermionSquareMasses,
+                                                            1,
+                                                            fieldConfiguration,
+                                             fermionMassesSquaredWithFactors );
+    incrementalEvaluation.AddMassesSquaredWithMultiplicity( vectorSquareMasses,
+                                                            2,
+                                                            fieldConfiguration,
+                                              vectorMassesSquaredWithFactors );
+    double const
+    treeLevelValue( incrementalEvaluation.PolynomialValue( treeLevelPotential,
+                                                           0,
+                                                        fieldConfiguration ) );
+    if( includePolynomialLoopCorrections )
+    {
+      return ( treeLevelValue
+               + incrementalEvaluation.PolynomialValue(
+                                                     polynomialLoopCorrections,
+                                                        1,
+                                                        fieldConfiguration ) );
+    }
+    return treeLevelValue;
+  }
+
+  // This appends the masses-squared and multiplicity from each
+  // MassesSquaredFromMatrix in massSquaredMatrices for each of the field
+  // configurations in fieldConfigurations to the corresponding element of
+  // massesSquaredWithFactorsByConfiguration, with all Lagrangian parameters
+  // evaluated at the last scale which was used to update them. Each matrix is
+  // evaluated for the whole batch of configurations at once.
+  inline void
+  PotentialFromPolynomialWithMasses::AddMassesSquaredWithMultiplicityForBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+            std::vector< MassesSquaredCalculator* > const& massSquaredMatrices,
+                          std::vector< std::vector< DoubleVectorWithDouble > >&
+                                massesSquaredWithFactorsByConfiguration ) const
+  {
+    massesSquaredWithFactorsByConfiguration.resize(
+                                                  fieldConfigurations.size() );
+    std::vector< std::vector< double > > massesSquaredByConfiguration;
+    for( std::vector< MassesSquaredCalculator* >::const_iterator
+         whichMatrix( massSquaredMatrices.begin() );
+         whichMatrix < massSquaredMatrices.end();
+         ++whichMatrix )
+    {
+      (*whichMatrix)->MassesSquaredForBatch( fieldConfigurations,
+                                             massesSquaredByConfiguration );
+      for( size_t configurationIndex( 0 );
+           configurationIndex < fieldConfigurations.size();
+           ++configurationIndex )
+      {
+        massesSquaredWithFactorsByConfiguration[ configurationIndex
+                                                                ].push_back(
+             std::make_pair( massesSquaredByConfiguration[ configurationIndex ],
+                             (*whichMatrix)->MultiplicityFactor() ) );
+      }
+    }
+  }
+
+  // This fills fieldValuesByIndex with the values of fieldConfigurations in
+  // structure-of-arrays form, so that fieldValuesByIndex[ f ][ c ] is the
+  // value of the field with index f in configuration c, as required by
+  // ParametersAndFieldsProductSum::AddToBatch.
+  inline void PotentialFromPolynomialWithMasses::FieldValuesByIndex(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+        std::vector< std::vector< double > >& fieldValuesByIndex ) const
+  {
+    fieldValuesByIndex.resize( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      fieldValuesByIndex[ fieldIndex ].resize( fieldConfigurations.size() );
+      for( size_t configurationIndex( 0 );
+           configurationIndex < fieldConfigurations.size();
+           ++configurationIndex )
+      {
+        fieldValuesByIndex[ fieldIndex ][ configurationIndex ]
+        = fieldConfigurations[ configurationIndex ][ fieldIndex ];
+      }
+    }
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* POTENTIALFROMPOLYNOMIALWITHMASSES_HPP_ */
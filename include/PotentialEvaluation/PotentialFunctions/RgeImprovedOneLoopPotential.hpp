@@ -28,7 +28,8 @@ namespace VevaciousPlusPlus
   public:
     RgeImprovedOneLoopPotential( std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                      LagrangianParameterManager& lagrangianParameterManager );
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                   bool const deferLoopCorrections = false );
     RgeImprovedOneLoopPotential(
                     PotentialFromPolynomialWithMasses const& potentialToCopy );
     virtual ~RgeImprovedOneLoopPotential();
@@ -42,6 +43,34 @@ namespace VevaciousPlusPlus
     operator()( std::vector< double > const& fieldConfiguration,
                 double const temperatureValue = 0.0 ) const;
 
+    // This places the exact total gradient of the potential at
+    // fieldConfiguration for the temperature temperatureValue in
+    // gradientVector, and returns true unless the Lagrangian parameter manager
+    // could not provide the derivatives of the parameters with respect to the
+    // logarithm of the scale or a mass-squared matrix could not provide the
+    // derivatives of its eigenvalues. Since the renormalization scale Q
+    // depends on the fields through Q^2 = T^2 + |fieldConfiguration|^2, the
+    // derivative of the potential with respect to ln( Q ) at fixed fields is
+    // added to each field derivative multiplied by the derivative of ln( Q )
+    // with respect to that field, unless Q is held at one of the ends of the
+    // range of allowed scales.
+    virtual bool
+    SetAsExactGradientAt( std::vector< double >& gradientVector,
+                          std::vector< double > const& fieldConfiguration,
+                          double const temperatureValue = 0.0 ) const;
+
+    // This places the exact gradient at zero temperature from
+    // SetAsExactGradientAt in gradientVector, falling back on the numerical
+    // gradient of PotentialFunction::SetAsGradientAt if it is not available.
+    virtual void SetAsGradientAt( std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                  double const numericalStepSize = 1.0 ) const
+    { if( !(SetAsExactGradientAt( gradientVector,
+                                  fieldConfiguration )) )
+      { PotentialFunction::SetAsGradientAt( gradientVector,
+                                            fieldConfiguration,
+                                            numericalStepSize ); } }
+
     // This returns the square of the Euclidean distance between the given
     // vacua in field space.
     virtual double
@@ -77,6 +106,7 @@ namespace VevaciousPlusPlus
   // the potential at the field origin).
   inline void RgeImprovedOneLoopPotential::RespondToObservedSignal()
   {
+    evaluationCache.Clear();
     UpdateDsbValues(
              log( lagrangianParameterManager.AppropriateSingleFixedScale() ) );
     double const
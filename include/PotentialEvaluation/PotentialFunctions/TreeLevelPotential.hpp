@@ -30,7 +30,8 @@ namespace VevaciousPlusPlus
   public:
     TreeLevelPotential( std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                      LagrangianParameterManager& lagrangianParameterManager );
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                   bool const deferLoopCorrections = false );
     TreeLevelPotential(
                     PotentialFromPolynomialWithMasses const& potentialToCopy );
     virtual ~TreeLevelPotential();
@@ -44,6 +45,58 @@ namespace VevaciousPlusPlus
     operator()( std::vector< double > const& fieldConfiguration,
                 double const temperatureValue = 0.0 ) const;
 
+    // This puts the energy density in GeV^4 of the potential for each of the
+    // field configurations in fieldConfigurations into the corresponding
+    // element of potentialValues, at the temperature in GeV given by
+    // temperatureValue. The tree-level polynomial is evaluated for the whole
+    // batch in a single traversal of its terms, and the mass-squared matrices
+    // are only diagonalized if thermal corrections are needed.
+    virtual void EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                   double const temperatureValue = 0.0 ) const;
+
+    // This places the exact gradient of the tree-level potential with thermal
+    // corrections at fieldConfiguration for the temperature temperatureValue
+    // in gradientVector, from a single forward-mode pass through the
+    // polynomial, the mass-squared matrices and their eigenvalues, and the
+    // thermal functions, and returns true unless a mass-squared matrix could
+    // not provide the derivatives of its eigenvalues.
+    virtual bool
+    SetAsExactGradientAt( std::vector< double >& gradientVector,
+                          std::vector< double > const& fieldConfiguration,
+                          double const temperatureValue = 0.0 ) const
+    { return SetAsFixedScaleGradient( fieldConfiguration,
+                                      inverseRenormalizationScaleSquared,
+                                      temperatureValue,
+                                      false,
+                                      gradientVector ); }
+
+    // This places the exact gradient at zero temperature from
+    // SetAsExactGradientAt in gradientVector, falling back on the numerical
+    // gradient of PotentialFunction::SetAsGradientAt if it is not available.
+    virtual void SetAsGradientAt( std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                  double const numericalStepSize = 1.0 ) const
+    { if( !(SetAsExactGradientAt( gradientVector,
+                                  fieldConfiguration )) )
+      { PotentialFunction::SetAsGradientAt( gradientVector,
+                                            fieldConfiguration,
+                                            numericalStepSize ); } }
+
+    // This places the gradient and the Hessian matrix of second derivatives at
+    // fieldConfiguration for the temperature temperatureValue into
+    // gradientVector and hessianMatrix. At zero temperature they are
+    // evaluated exactly from the tree-level polynomial. Otherwise, since the
+    // thermal functions are interpolated, they are evaluated numerically by
+    // PotentialFunction::SetAsGradientAndHessianAt.
+    virtual void SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                         double const temperatureValue = 0.0,
+                                  double const numericalStepSize = 1.0 ) const;
+
     // This returns the square of the current renormalization scale.
     virtual double
     ScaleSquaredRelevantToTunneling( PotentialMinimum const& falseVacuum,
@@ -83,24 +136,68 @@ namespace VevaciousPlusPlus
                                std::vector< double > const& fieldConfiguration,
                                           double const temperatureValue ) const
   {
+    double cachedValue;
+    if( evaluationCache.LookUp( fieldConfiguration,
+                                temperatureValue,
+                                cachedValue ) )
+    {
+      return cachedValue;
+    }
     std::vector< DoubleVectorWithDouble > scalarMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      scalarSquareMasses,
-                                      scalarMassesSquaredWithFactors );
     std::vector< DoubleVectorWithDouble > fermionMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      fermionSquareMasses,
-                                      fermionMassesSquaredWithFactors );
     std::vector< DoubleVectorWithDouble > vectorMassesSquaredWithFactors;
-    AddMassesSquaredWithMultiplicity( fieldConfiguration,
-                                      vectorSquareMasses,
-                                      vectorMassesSquaredWithFactors );
-    return ( treeLevelPotential( fieldConfiguration )
-             + JustThermalCorrections( scalarMassesSquaredWithFactors,
-                                          fermionMassesSquaredWithFactors,
-                                          vectorMassesSquaredWithFactors,
-                                          inverseRenormalizationScaleSquared,
-                                          temperatureValue ) );
+    double const
+    polynomialValue( PolynomialValueAndMassesSquared( fieldConfiguration,
+                                                      false,
+                                                scalarMassesSquaredWithFactors,
+                                               fermionMassesSquaredWithFactors,
+                                            vectorMassesSquaredWithFactors ) );
+    double const
+    potentialValue( polynomialValue
+                    + JustThermalCorrections( scalarMassesSquaredWithFactors,
+                                              fermionMassesSquaredWithFactors,
+                                              vectorMassesSquaredWithFactors,
+                                            inverseRenormalizationScaleSquared,
+                                              temperatureValue ) );
+    evaluationCache.Store( fieldConfiguration,
+                           temperatureValue,
+                           potentialValue );
+    return potentialValue;
+  }
+
+  // This places the gradient and the Hessian matrix of second derivatives at
+  // fieldConfiguration for the temperature temperatureValue into
+  // gradientVector and hessianMatrix. At zero temperature they are
+  // evaluated exactly from the tree-level polynomial. Otherwise, since the
+  // thermal functions are interpolated, they are evaluated numerically by
+  // PotentialFunction::SetAsGradientAndHessianAt.
+  inline void TreeLevelPotential::SetAsGradientAndHessianAt(
+                                         std::vector< double >& gradientVector,
+                           std::vector< std::vector< double > >& hessianMatrix,
+                               std::vector< double > const& fieldConfiguration,
+                                                 double const temperatureValue,
+                                         double const numericalStepSize ) const
+  {
+    if( temperatureValue <= 0.0 )
+    {
+      gradientVector.assign( numberOfFields,
+                             0.0 );
+      hessianMatrix.assign( numberOfFields,
+                            gradientVector );
+      if( AddFixedScaleDerivatives( fieldConfiguration,
+                                    inverseRenormalizationScaleSquared,
+                                    false,
+                                    gradientVector,
+                                    hessianMatrix ) )
+      {
+        return;
+      }
+    }
+    PotentialFunction::SetAsGradientAndHessianAt( gradientVector,
+                                                  hessianMatrix,
+                                                  fieldConfiguration,
+                                                  temperatureValue,
+                                                  numericalStepSize );
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -22,6 +22,13 @@ namespace VevaciousPlusPlus
     static double BosonicJ( double const squareRatio );
     static double FermionicJ( double const squareRatio );
 
+    // These return the derivatives with respect to squareRatio of BosonicJ
+    // and FermionicJ, which are the slopes of the linear interpolation
+    // exactly as it is evaluated, so that they are consistent with the values
+    // used for the potential.
+    static double BosonicJSlope( double const squareRatio );
+    static double FermionicJSlope( double const squareRatio );
+
     static std::string JFunctionsAsPython();
 
   private:
@@ -66,6 +73,15 @@ namespace VevaciousPlusPlus
 
     // 1 to 100 (element [0] is 1, [100] is 100), in steps of 1.0.
     static double FermionPlusOneToPlusOneHundred( double const squareRatio );
+
+    // This returns the slope of the interpolation for squareRatio in the
+    // given range of the tables, using the same piecewise choice of tables as
+    // BosonicJ and FermionicJ.
+    static double InterpolationSlope( double const squareRatio,
+                                      double const* minusOneToMinusTwelve,
+                                      double const* zeroToMinusOne,
+                                      double const* zeroToPlusOne,
+                                      double const* plusOneToPlusOneHundred );
   };
 
 
@@ -128,6 +144,78 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This returns the derivative with respect to squareRatio of BosonicJ.
+  inline double ThermalFunctions::BosonicJSlope( double const squareRatio )
+  {
+    return InterpolationSlope( squareRatio,
+                               bosonMinusOneToMinusTwelve,
+                               bosonZeroToMinusOne,
+                               bosonZeroToPlusOne,
+                               bosonPlusOneToPlusOneHundred );
+  }
+
+  // This returns the derivative with respect to squareRatio of FermionicJ.
+  inline double ThermalFunctions::FermionicJSlope( double const squareRatio )
+  {
+    return InterpolationSlope( squareRatio,
+                               fermionMinusOneToMinusTwelve,
+                               fermionZeroToMinusOne,
+                               fermionZeroToPlusOne,
+                               fermionPlusOneToPlusOneHundred );
+  }
+
+  // This returns the slope of the interpolation for squareRatio in the given
+  // range of the tables, using the same piecewise choice of tables as
+  // BosonicJ and FermionicJ. Within each range, the interpolated value is
+  // linear in squareRatio between adjacent table entries, with the factors
+  // of the scaling of squareRatio and of the weighting of the difference
+  // between the entries cancelling, so the slope is just plus or minus the
+  // difference between the entries. Outside the tables the functions are
+  // constant, so the slope is zero.
+  inline double ThermalFunctions::InterpolationSlope(
+                                                      double const squareRatio,
+                                         double const* minusOneToMinusTwelve,
+                                                  double const* zeroToMinusOne,
+                                                   double const* zeroToPlusOne,
+                                        double const* plusOneToPlusOneHundred )
+  {
+    if( squareRatio <= -12.0 )
+    {
+      return 0.0;
+    }
+    else if( squareRatio <= -1.0 )
+    {
+      size_t const floorIndex( static_cast< size_t >( -10.0
+                                                 * ( squareRatio + 1.0 ) ) );
+      return ( minusOneToMinusTwelve[ floorIndex ]
+               - minusOneToMinusTwelve[ floorIndex + 1 ] );
+    }
+    else if( squareRatio < 0.0 )
+    {
+      size_t const floorIndex( static_cast< size_t >( -100.0
+                                                      * squareRatio ) );
+      return ( zeroToMinusOne[ floorIndex ]
+               - zeroToMinusOne[ floorIndex + 1 ] );
+    }
+    else if( squareRatio < 1.0 )
+    {
+      size_t const floorIndex( static_cast< size_t >( 100.0
+                                                      * squareRatio ) );
+      return ( zeroToPlusOne[ floorIndex + 1 ]
+               - zeroToPlusOne[ floorIndex ] );
+    }
+    else if( squareRatio < 100.0 )
+    {
+      size_t const floorIndex( static_cast< size_t >( squareRatio - 1.0 ) );
+      return ( plusOneToPlusOneHundred[ floorIndex + 1 ]
+               - plusOneToPlusOneHundred[ floorIndex ] );
+    }
+    else
+    {
+      return 0.0;
+    }
+  }
+
   // -1 to -12 (element [0] is -1, [111] is -12), in steps of 0.1.
   inline double
   ThermalFunctions::BosonMinusOneToMinusTwelve( double const squareRatio )
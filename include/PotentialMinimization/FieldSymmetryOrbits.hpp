@@ -0,0 +1,273 @@
+/*
+ * FieldSymmetryOrbits.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef FIELDSYMMETRYORBITS_HPP_
+#define FIELDSYMMETRYORBITS_HPP_
+
+#include "PotentialEvaluation/PotentialFunction.hpp"
+#include "PotentialEvaluation/BuildingBlocks/ParametersAndFieldsProductSum.hpp"
+#include "LagrangianParameterManagement/LagrangianParameterManager.hpp"
+#include "Utilities/VectorUtilities.hpp"
+#include <cstddef>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <iostream>
+
+namespace VevaciousPlusPlus
+{
+  // This class detects discrete symmetries of the potential which act on the
+  // field configuration as sign flips of subsets of the fields or as
+  // exchanges of fields, and maps field configurations to a single
+  // representative of their orbit under the group generated by the detected
+  // symmetries, so that physically equivalent starting points and minima can
+  // be recognized as such.
+  //
+  // The candidate symmetries are read off the monomials of the polynomial
+  // approximation of the potential, with the Lagrangian parameters evaluated
+  // at the appropriate fixed scale: a subset of the fields can be flipped in
+  // sign if every monomial has an even total power of the fields of the
+  // subset, so the sign flips form the null space of the matrix of powers
+  // modulo 2, and two fields can be exchanged if every monomial has the same
+  // coefficient as the monomial with their powers swapped. Since the loop
+  // corrections could break symmetries of the polynomial, each candidate is
+  // only kept if it also leaves the full potential unchanged at the DSB input
+  // and a few generic test configurations.
+  //
+  // The representative of a configuration is the image under the symmetries
+  // which is closest to the DSB input, which is the relevant image for
+  // tunneling. Each combination of the independent sign flips is applied in
+  // turn, then the values of each set of exchangeable fields are placed in
+  // the same order as the DSB input values of those fields, which brings them
+  // as close as possible to the DSB input, and the closest of these images is
+  // taken, with ties broken by lexicographic order. Since the exchanges map
+  // sign flips which leave the potential unchanged to others which do too,
+  // every configuration of an orbit gives the same set of images, so this is
+  // a true representative of the orbit. If there are more than
+  // maximumEnumeratedGenerators independent sign flips, the combinations are
+  // not enumerated, and instead each independent flip, which has a pivot
+  // field which no other independent flip affects, is applied if that field
+  // (or, if that field is zero, the first non-zero field which it affects)
+  // has the opposite sign to that in the DSB input (taken as positive where
+  // the DSB input is zero) before the exchangeable fields are ordered. This
+  // is only a best-effort representative, as configurations of the same
+  // orbit can then be given different representatives.
+  class FieldSymmetryOrbits
+  {
+  public:
+    FieldSymmetryOrbits(
+                  ParametersAndFieldsProductSum const& polynomialApproximation,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                         PotentialFunction const& potentialFunction,
+                         double const verificationTolerance );
+    virtual ~FieldSymmetryOrbits();
+
+
+    // This finds the symmetries of the potential for the current parameter
+    // point, replacing any found before. It should be called each time that
+    // the potential has been updated for a new parameter point.
+    void DetectSymmetries();
+
+    // This returns true if at least one symmetry was found by the last call
+    // of DetectSymmetries.
+    bool HasSymmetries() const
+    { return !( signFlipGenerators.empty() && exchangeClasses.empty() ); }
+
+    // This returns the representative of the orbit of fieldConfiguration
+    // under the detected symmetries, which is the image closest to the DSB
+    // input as described above.
+    std::vector< double >
+    Canonicalize( std::vector< double > const& fieldConfiguration ) const;
+
+    // This returns the number of independent sign flips which were found.
+    size_t NumberOfSignFlipGenerators() const
+    { return signFlipGenerators.size(); }
+
+    // This returns the sets of indices of fields which were found to be
+    // exchangeable among each other.
+    std::vector< std::vector< size_t > > const& ExchangeClasses() const
+    { return exchangeClasses; }
+
+
+  protected:
+    // Above this number of independent sign flips, Canonicalize no longer
+    // tries every combination of them.
+    static size_t const maximumEnumeratedGenerators = 12;
+
+    // The key is the power of each field in a monomial, and the value is
+    // first the coefficient of the monomial for the current parameter point
+    // and second the sum of the absolute values of the coefficients of the
+    // terms which contributed to it, so that cancellations can be recognized.
+    typedef std::map< std::vector< unsigned int >,
+                      std::pair< double, double > > MonomialMap;
+
+    ParametersAndFieldsProductSum const polynomialApproximation;
+    LagrangianParameterManager const& lagrangianParameterManager;
+    PotentialFunction const& potentialFunction;
+    size_t const numberOfFields;
+    double const verificationTolerance;
+    // Each generator is a vector of flags for which fields flip sign, and
+    // the field with the corresponding index in pivotFields is flagged by no
+    // other generator.
+    std::vector< std::vector< bool > > signFlipGenerators;
+    std::vector< size_t > pivotFields;
+    std::vector< std::vector< size_t > > exchangeClasses;
+    std::vector< double > referenceConfiguration;
+    std::vector< std::vector< double > > testConfigurations;
+
+    // This puts the monomials of polynomialApproximation with the Lagrangian
+    // parameters given by parameterValues into monomialMap, dropping any
+    // whose contributions cancel.
+    void FillMonomialMap( std::vector< double > const& parameterValues,
+                          MonomialMap& monomialMap ) const;
+
+    // This finds a basis of the sign flips which leave every monomial in
+    // monomialMap unchanged, by Gaussian elimination modulo 2, and keeps
+    // those which also leave the full potential unchanged in
+    // signFlipGenerators.
+    void FindSignFlips( MonomialMap const& monomialMap );
+
+    // This finds the pairs of fields which can be exchanged without changing
+    // the coefficient of any monomial in monomialMap or the full potential,
+    // and groups them into exchangeClasses.
+    void FindExchanges( MonomialMap const& monomialMap );
+
+    // This returns true if the powers of the fields with indices firstField
+    // and secondField can be swapped in every monomial in monomialMap without
+    // changing its coefficient.
+    static bool MonomialsAreExchangeSymmetric( MonomialMap const& monomialMap,
+                                               size_t const firstField,
+                                               size_t const secondField );
+
+    // This returns true if the full potential has the same value, within
+    // verificationTolerance, at each of testConfigurations and at its image
+    // under the transformation applied by transformConfiguration.
+    template< typename TransformationType >
+    bool PotentialIsInvariantUnder(
+                   TransformationType const& transformConfiguration ) const;
+
+    // This applies each independent sign flip for which the sign of its
+    // pivot field (or, if that is zero, the first non-zero field which it
+    // flips) differs from the sign in referenceConfiguration.
+    void
+    AlignSignFlipsWithPivots( std::vector< double >& fieldConfiguration ) const;
+
+    // This places the values of each set of exchangeable fields in the same
+    // order as the values of those fields in referenceConfiguration.
+    void
+    AlignExchangeClasses( std::vector< double >& fieldConfiguration ) const;
+
+    // This returns the square of the Euclidean distance of fieldConfiguration
+    // from referenceConfiguration.
+    double DistanceSquaredFromReference(
+                        std::vector< double > const& fieldConfiguration ) const;
+
+    // This flips the sign of the fields flagged in signFlip.
+    static void ApplySignFlip( std::vector< bool > const& signFlip,
+                               std::vector< double >& fieldConfiguration );
+
+    // This is used to flip the signs of the fields flagged by a candidate
+    // generator in PotentialIsInvariantUnder.
+    struct SignFlipTransformation
+    {
+      SignFlipTransformation( std::vector< bool > const& signFlip ) :
+        signFlip( signFlip ) {}
+
+      std::vector< bool > const& signFlip;
+
+      void operator()( std::vector< double >& fieldConfiguration ) const
+      { ApplySignFlip( signFlip,
+                       fieldConfiguration ); }
+    };
+
+    // This is used to swap the values of two fields in
+    // PotentialIsInvariantUnder.
+    struct ExchangeTransformation
+    {
+      ExchangeTransformation( size_t const firstField,
+                              size_t const secondField ) :
+        firstField( firstField ),
+        secondField( secondField ) {}
+
+      size_t const firstField;
+      size_t const secondField;
+
+      void operator()( std::vector< double >& fieldConfiguration ) const
+      { std::swap( fieldConfiguration[ firstField ],
+                   fieldConfiguration[ secondField ] ); }
+    };
+  };
+
+
+
+
+  // This flips the sign of the fields flagged in signFlip.
+  inline void
+  FieldSymmetryOrbits::ApplySignFlip( std::vector< bool > const& signFlip,
+                                    std::vector< double >& fieldConfiguration )
+  {
+    for( size_t fieldIndex( 0 );
+         fieldIndex < signFlip.size();
+         ++fieldIndex )
+    {
+      if( signFlip[ fieldIndex ] )
+      {
+        fieldConfiguration[ fieldIndex ] = -fieldConfiguration[ fieldIndex ];
+      }
+    }
+  }
+
+  // This returns the square of the Euclidean distance of fieldConfiguration
+  // from referenceConfiguration.
+  inline double FieldSymmetryOrbits::DistanceSquaredFromReference(
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    double distanceSquared( 0.0 );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      double const fieldDifference( fieldConfiguration[ fieldIndex ]
+                                    - referenceConfiguration[ fieldIndex ] );
+      distanceSquared += ( fieldDifference * fieldDifference );
+    }
+    return distanceSquared;
+  }
+
+  // This returns true if the full potential has the same value, within
+  // verificationTolerance, at each of testConfigurations and at its image
+  // under the transformation applied by transformConfiguration.
+  template< typename TransformationType >
+  inline bool FieldSymmetryOrbits::PotentialIsInvariantUnder(
+                    TransformationType const& transformConfiguration ) const
+  {
+    for( std::vector< std::vector< double > >::const_iterator
+         testConfiguration( testConfigurations.begin() );
+         testConfiguration < testConfigurations.end();
+         ++testConfiguration )
+    {
+      std::vector< double > transformedConfiguration( *testConfiguration );
+      transformConfiguration( transformedConfiguration );
+      double const originalValue( potentialFunction( *testConfiguration ) );
+      double const transformedValue( potentialFunction(
+                                                  transformedConfiguration ) );
+      if( !( fabs( transformedValue - originalValue )
+             <= ( verificationTolerance
+                  * ( fabs( originalValue ) + fabs( transformedValue ) ) ) ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* FIELDSYMMETRYORBITS_HPP_ */
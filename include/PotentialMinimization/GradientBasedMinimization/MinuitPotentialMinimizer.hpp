@@ -19,6 +19,10 @@
 #include <cstddef>
 #include <algorithm>
 #include <cmath>
+#include <sstream>
+#include <limits>
+#include "Eigen/Dense"
+#include "Utilities/WarningLogger.hpp"
 
 
 namespace VevaciousPlusPlus
@@ -30,23 +34,24 @@ namespace VevaciousPlusPlus
     MinuitPotentialMinimizer( PotentialFunction const& potentialFunction,
                               double const errorFraction = 0.1,
                               double const errorMinimum = 1.0,
-                              unsigned int const minuitStrategy = 1 ) :
+                              unsigned int const minuitStrategy = 1,
+                              unsigned int const newtonRefinementSteps = 0 ) :
       GradientMinimizer( potentialFunction ),
       minimizationFunction( potentialFunction ),
       errorFraction( errorFraction ),
       errorMinimum( errorMinimum ),
-      minuitStrategy( minuitStrategy ) {}
+      minuitStrategy( minuitStrategy ),
+      newtonRefinementSteps( newtonRefinementSteps ) {}
 
     virtual ~MinuitPotentialMinimizer() {}
 
 
     // This performs a Minuit2 migrad() minimization but puts the result in the
     // less cumbersome class PotentialMinimum instead of returning just a
-    // ROOT::Minuit2::FunctionMinimum.
+    // ROOT::Minuit2::FunctionMinimum. If newtonRefinementSteps is greater than
+    // zero, the result is then polished by PolishWithNewtonSteps.
     virtual PotentialMinimum
-    operator()( std::vector< double > const& startingPoint ) const
-    { return PotentialMinimum( MinuitMinimum( startingPoint.size(),
-                                              RunMigrad( startingPoint ) ) ); }
+    operator()( std::vector< double > const& startingPoint ) const;
 
     // This ensures that the minimizations are calculated at the given
     // temperature.
@@ -56,7 +61,9 @@ namespace VevaciousPlusPlus
     // This sets up a ROOT::Minuit2::MnMigrad instance and runs its operator().
     // The initial step sizes are set to be the values of startingPoint
     // multiplied by errorFraction, absolute values taken. Any step size less
-    // than errorMinimum is set to errorMinimum.
+    // than errorMinimum is set to errorMinimum. If the potential provides its
+    // exact gradient, Minuit2 is given that instead of working out the
+    // gradient by finite differences.
     ROOT::Minuit2::FunctionMinimum
     RunMigrad( std::vector< double > const& startingPoint,
                double givenTolerance = -1.0 ) const;
@@ -68,21 +75,58 @@ namespace VevaciousPlusPlus
     { return minimizationFunction.FunctionAtOrigin(); }
 
 
+    // This refines foundMinimum by up to newtonRefinementSteps trust-region
+    // Newton steps using the gradient and Hessian from
+    // PotentialFunction::SetAsGradientAndHessianAt, which converge
+    // quadratically close to the minimum where Migrad converges only
+    // linearly. The Hessian is shifted to be positive-definite where
+    // necessary, each step is limited to a trust radius which starts at the
+    // size of the initial step sizes for Migrad, and a step is only accepted
+    // if it lowers the potential, otherwise the radius is shrunk. Finally the
+    // eigenvalues of the Hessian at the refined point are used to check
+    // whether it is really a minimum rather than a saddle point.
+    void PolishWithNewtonSteps( PotentialMinimum& foundMinimum ) const;
+
+
   protected:
     PotentialForMinuit minimizationFunction;
     double const errorFraction;
     double const errorMinimum;
     unsigned int const minuitStrategy;
+    unsigned int const newtonRefinementSteps;
   };
 
 
 
 
 
+  // This performs a Minuit2 migrad() minimization but puts the result in the
+  // less cumbersome class PotentialMinimum instead of returning just a
+  // ROOT::Minuit2::FunctionMinimum. If newtonRefinementSteps is greater than
+  // zero, the result is then polished by PolishWithNewtonSteps.
+  inline PotentialMinimum MinuitPotentialMinimizer::operator()(
+                              std::vector< double > const& startingPoint ) const
+  {
+    PotentialMinimum
+    foundMinimum( MinuitMinimum( startingPoint.size(),
+                                 RunMigrad( startingPoint ) ) );
+    if( newtonRefinementSteps > 0 )
+    {
+      PolishWithNewtonSteps( foundMinimum );
+    }
+    return foundMinimum;
+  }
+
+
+
+
+
   // This sets up a ROOT::Minuit2::MnMigrad instance and runs its operator().
   // The initial step sizes are set to be the values of startingPoint
   // multiplied by errorFraction, absolute values taken. Any step size less
-  // than errorMinimum is set to errorMinimum.
+  // than errorMinimum is set to errorMinimum. If the potential provides its
+  // exact gradient, Minuit2 is given that instead of working out the gradient
+  // by finite differences.
   inline ROOT::Minuit2::FunctionMinimum MinuitPotentialMinimizer::RunMigrad(
                                     std::vector< double > const& startingPoint,
                                                   double givenTolerance ) const
@@ -101,13 +145,208 @@ namespace VevaciousPlusPlus
       givenTolerance = std::max( errorMinimum,
                   ( errorFraction * minimizationFunction( startingPoint ) ) );
     }
-    ROOT::Minuit2::MnMigrad mnMigrad( minimizationFunction,
-                                      startingPoint,
-                                      initialStepSizes,
-                                      minuitStrategy );
+    if( minimizationFunction.ProvidesExactGradient() )
+    {
+      ROOT::Minuit2::MnMigrad
+      mnMigrad( static_cast< ROOT::Minuit2::FCNGradientBase const& >(
+                                                        minimizationFunction ),
+                startingPoint,
+                initialStepSizes,
+                minuitStrategy );
+      return mnMigrad( 0,
+                       givenTolerance );
+    }
+    ROOT::Minuit2::MnMigrad
+    mnMigrad( static_cast< ROOT::Minuit2::FCNBase const& >(
+                                                        minimizationFunction ),
+              startingPoint,
+              initialStepSizes,
+              minuitStrategy );
     return mnMigrad( 0,
                      givenTolerance );
   }
 
+  // This refines foundMinimum by up to newtonRefinementSteps trust-region
+  // Newton steps using the gradient and Hessian from
+  // PotentialFunction::SetAsGradientAndHessianAt, which converge quadratically
+  // close to the minimum where Migrad converges only linearly. The Hessian is
+  // shifted to be positive-definite where necessary, each step is limited to
+  // a trust radius which starts at the size of the initial step sizes for
+  // Migrad, and a step is only accepted if it lowers the potential, otherwise
+  // the radius is shrunk. Finally the eigenvalues of the Hessian at the
+  // refined point are used to check whether it is really a minimum rather
+  // than a saddle point.
+  inline void MinuitPotentialMinimizer::PolishWithNewtonSteps(
+                                        PotentialMinimum& foundMinimum ) const
+  {
+    double const minimizationTemperature(
+                                    minimizationFunction.CurrentTemperature() );
+    size_t const numberOfFields( foundMinimum.FieldConfiguration().size() );
+    if( numberOfFields == 0 )
+    {
+      return;
+    }
+    std::vector< double > currentConfiguration(
+                                         foundMinimum.FieldConfiguration() );
+    double currentValue( minimizationFunction( currentConfiguration ) );
+    std::vector< double > trialConfiguration( currentConfiguration );
+    std::vector< double > gradientVector;
+    std::vector< std::vector< double > > hessianMatrix;
+    Eigen::VectorXd gradientInEigenbasis( numberOfFields );
+    Eigen::MatrixXd eigenHessian( numberOfFields,
+                                  numberOfFields );
+    Eigen::SelfAdjointEigenSolver< Eigen::MatrixXd > eigenSolver;
+    double const
+    configurationLength( std::sqrt( foundMinimum.LengthSquared() ) );
+    double trustRadius( std::max( errorMinimum,
+                                  ( errorFraction * configurationLength ) ) );
+    // Steps smaller than this relative to the field values are taken as
+    // showing that the refinement has converged.
+    double const
+    convergedStepLength( 1.0E-9 * ( configurationLength + errorMinimum ) );
+    bool hessianIsCurrent( false );
+    for( unsigned int stepCount( 0 );
+         stepCount < newtonRefinementSteps;
+         ++stepCount )
+    {
+      if( !hessianIsCurrent )
+      {
+        potentialFunction.SetAsGradientAndHessianAt( gradientVector,
+                                                     hessianMatrix,
+                                                     currentConfiguration,
+                                                     minimizationTemperature );
+        for( size_t rowIndex( 0 );
+             rowIndex < numberOfFields;
+             ++rowIndex )
+        {
+          for( size_t columnIndex( 0 );
+               columnIndex < numberOfFields;
+               ++columnIndex )
+          {
+            eigenHessian( rowIndex,
+                          columnIndex )
+            = hessianMatrix[ rowIndex ][ columnIndex ];
+          }
+        }
+        eigenSolver.compute( eigenHessian );
+        for( size_t eigenIndex( 0 );
+             eigenIndex < numberOfFields;
+             ++eigenIndex )
+        {
+          gradientInEigenbasis( eigenIndex ) = 0.0;
+          for( size_t fieldIndex( 0 );
+               fieldIndex < numberOfFields;
+               ++fieldIndex )
+          {
+            gradientInEigenbasis( eigenIndex )
+            += ( eigenSolver.eigenvectors()( fieldIndex,
+                                             eigenIndex )
+                 * gradientVector[ fieldIndex ] );
+          }
+        }
+        hessianIsCurrent = true;
+      }
+      // The eigenvalues are sorted in increasing order, so the shift which
+      // makes the curvature positive in every direction is determined by the
+      // first eigenvalue.
+      Eigen::VectorXd const& hessianEigenvalues( eigenSolver.eigenvalues() );
+      double const largestCurvature( std::max( std::abs(
+                                                 hessianEigenvalues( 0 ) ),
+                                               std::abs( hessianEigenvalues(
+                                                    numberOfFields - 1 ) ) ) );
+      double const minimumCurvature( std::max( ( 1.0E-9 * largestCurvature ),
+                                    std::numeric_limits< double >::min() ) );
+      double const curvatureShift( std::max( 0.0,
+                          ( minimumCurvature - hessianEigenvalues( 0 ) ) ) );
+      Eigen::VectorXd const
+      stepInEigenbasis( -gradientInEigenbasis.array()
+                        / ( hessianEigenvalues.array() + curvatureShift ) );
+      double stepLength( stepInEigenbasis.norm() );
+      if( !( stepLength > convergedStepLength ) )
+      {
+        break;
+      }
+      double const stepScaling( std::min( 1.0,
+                                          ( trustRadius / stepLength ) ) );
+      Eigen::VectorXd const
+      fieldStep( ( stepScaling * eigenSolver.eigenvectors() )
+                 * stepInEigenbasis );
+      stepLength *= stepScaling;
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        trialConfiguration[ fieldIndex ]
+        = ( currentConfiguration[ fieldIndex ] + fieldStep( fieldIndex ) );
+      }
+      double const trialValue( minimizationFunction( trialConfiguration ) );
+      if( trialValue < currentValue )
+      {
+        currentConfiguration = trialConfiguration;
+        currentValue = trialValue;
+        hessianIsCurrent = false;
+      }
+      else
+      {
+        trustRadius = ( 0.25 * stepLength );
+        if( !( trustRadius > convergedStepLength ) )
+        {
+          break;
+        }
+      }
+    }
+    if( !hessianIsCurrent )
+    {
+      potentialFunction.SetAsGradientAndHessianAt( gradientVector,
+                                                   hessianMatrix,
+                                                   currentConfiguration,
+                                                   minimizationTemperature );
+      for( size_t rowIndex( 0 );
+           rowIndex < numberOfFields;
+           ++rowIndex )
+      {
+        for( size_t columnIndex( 0 );
+             columnIndex < numberOfFields;
+             ++columnIndex )
+        {
+          eigenHessian( rowIndex,
+                        columnIndex )
+          = hessianMatrix[ rowIndex ][ columnIndex ];
+        }
+      }
+      eigenSolver.compute( eigenHessian,
+                           Eigen::EigenvaluesOnly );
+    }
+    // Eigenvalues which are negative only at the level of numerical noise
+    // compared to the largest curvature are not counted as descent
+    // directions.
+    Eigen::VectorXd const& hessianEigenvalues( eigenSolver.eigenvalues() );
+    double const
+    negligibleCurvature( 1.0E-9 * hessianEigenvalues.cwiseAbs().maxCoeff() );
+    unsigned int numberOfDescentDirections( 0 );
+    for( size_t eigenIndex( 0 );
+         eigenIndex < numberOfFields;
+         ++eigenIndex )
+    {
+      if( hessianEigenvalues( eigenIndex ) < -negligibleCurvature )
+      {
+        ++numberOfDescentDirections;
+      }
+    }
+    if( numberOfDescentDirections > 0 )
+    {
+      std::stringstream warningBuilder;
+      warningBuilder << "Newton refinement found that the point at "
+      << potentialFunction.FieldConfigurationAsMathematica(
+                                                        currentConfiguration )
+      << " is a saddle point with " << numberOfDescentDirections
+      << " descending direction(s) rather than a minimum.";
+      WarningLogger::LogWarning( warningBuilder.str() );
+    }
+    foundMinimum.MoveTo( currentConfiguration,
+                         currentValue,
+                         ( numberOfDescentDirections == 0 ) );
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* MINUITPOTENTIALMINIMIZER_HPP_ */
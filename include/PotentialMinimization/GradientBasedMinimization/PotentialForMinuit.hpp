@@ -9,22 +9,29 @@
 #define POTENTIALFORMINUIT_HPP_
 
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/FCNGradientBase.h"
 #include "PotentialEvaluation/PotentialFunction.hpp"
 #include <vector>
+#include <stdexcept>
 
 namespace VevaciousPlusPlus
 {
 
-  class PotentialForMinuit : public ROOT::Minuit2::FCNBase
+  // This is both an FCNBase and an FCNGradientBase, so that a
+  // ROOT::Minuit2::MnMigrad can be given it as an FCNBase to work out the
+  // gradient numerically itself, or as an FCNGradientBase to use the exact
+  // gradient from the potential if ProvidesExactGradient returns true.
+  class PotentialForMinuit : public ROOT::Minuit2::FCNGradientBase
   {
   public:
     PotentialForMinuit( PotentialFunction const& minimizationFunction ) :
-      ROOT::Minuit2::FCNBase(),
+      ROOT::Minuit2::FCNGradientBase(),
       minimizationFunction( minimizationFunction ),
       fieldOrigin( minimizationFunction.NumberOfFieldVariables(),
                    0.0 ),
       functionAtOrigin( minimizationFunction( fieldOrigin ) ),
-      currentTemperature( 0.0 ) {}
+      currentTemperature( 0.0 ),
+      exactGradientAvailable( GradientIsExactAtOrigin() ) {}
 
     virtual ~PotentialForMinuit() {}
 
@@ -36,6 +43,23 @@ namespace VevaciousPlusPlus
     { return ( minimizationFunction( fieldConfiguration,
                                    currentTemperature ) - functionAtOrigin ); }
 
+    // This implements Gradient for FCNGradientBase, using the exact gradient
+    // from the potential. It throws an exception if the potential cannot
+    // provide it, so it should only be used if ProvidesExactGradient returned
+    // true.
+    virtual std::vector< double >
+    Gradient( std::vector< double > const& fieldConfiguration ) const;
+
+    // The gradient is exact, so Minuit2 does not need to check it against
+    // finite differences.
+    virtual bool CheckGradient() const { return false; }
+
+    // This returns true if the potential can provide its exact gradient at
+    // the current temperature. The potential either always or never provides
+    // its gradient exactly, so this was checked just once at the field origin
+    // when the temperature was set, rather than for every minimization.
+    bool ProvidesExactGradient() const { return exactGradientAvailable; }
+
     // This implements Up() for FCNBase just to stick to a basic value.
     virtual double Up() const { return 1.0; }
 
@@ -45,17 +69,42 @@ namespace VevaciousPlusPlus
 
     double FunctionAtOrigin() const { return functionAtOrigin; }
 
+    double CurrentTemperature() const { return currentTemperature; }
+
 
   protected:
     PotentialFunction const& minimizationFunction;
     std::vector< double > const fieldOrigin;
     double functionAtOrigin;
     double currentTemperature;
+    bool exactGradientAvailable;
+
+    // This returns true if the potential can provide its exact gradient at
+    // the field origin at the current temperature.
+    bool GradientIsExactAtOrigin() const;
   };
 
 
 
 
+  // This implements Gradient for FCNGradientBase, using the exact gradient
+  // from the potential. It throws an exception if the potential cannot
+  // provide it, so it should only be used if ProvidesExactGradient returned
+  // true.
+  inline std::vector< double > PotentialForMinuit::Gradient(
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    std::vector< double > gradientVector;
+    if( !(minimizationFunction.SetAsExactGradientAt( gradientVector,
+                                                     fieldConfiguration,
+                                                     currentTemperature )) )
+    {
+      throw std::runtime_error( "PotentialForMinuit::Gradient(..) was called"
+                           " for a potential without an exact gradient." );
+    }
+    return gradientVector;
+  }
+
   // The potential is minimized at a fixed temperature, so this sets the
   // temperature.
   inline void
@@ -64,6 +113,17 @@ namespace VevaciousPlusPlus
     this->currentTemperature = currentTemperature;
     functionAtOrigin = minimizationFunction( fieldOrigin,
                                              currentTemperature );
+    exactGradientAvailable = GradientIsExactAtOrigin();
+  }
+
+  // This returns true if the potential can provide its exact gradient at the
+  // field origin at the current temperature.
+  inline bool PotentialForMinuit::GradientIsExactAtOrigin() const
+  {
+    std::vector< double > gradientVector;
+    return minimizationFunction.SetAsExactGradientAt( gradientVector,
+                                                      fieldOrigin,
+                                                      currentTemperature );
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -13,9 +13,16 @@
 #include "GradientMinimizer.hpp"
 #include "PotentialEvaluation/PotentialFunction.hpp"
 #include "PotentialMinimum.hpp"
+#include "FieldSymmetryOrbits.hpp"
+#include "Utilities/TaskGroup.hpp"
 #include <vector>
+#include <memory>
 #include <iostream>
 #include <cmath>
+#include <string>
+#include <sstream>
+#include <future>
+#include <functional>
 
 namespace VevaciousPlusPlus
 {
@@ -49,14 +56,93 @@ namespace VevaciousPlusPlus
 
     virtual void setWhichPanicVacuum( bool global_Is_Panic_setting);
 
+    // This switches on screening of the starting points with a cheaper
+    // potential (usually the tree-level potential) before the full potential
+    // is minimized: each starting point is first rolled with
+    // screeningMinimizer, which should minimize screeningPotential, and only
+    // the distinct screening minima which are not the screening minimum
+    // rolled to from the DSB input and which are no more than
+    // screeningDepthWindow times the absolute depth of that minimum above it
+    // are used as starting points for gradientMinimizer. If no screening
+    // minima pass, the full potential is only minimized from the DSB input.
+    void SetScreening( std::unique_ptr<PotentialFunction> screeningPotential,
+                       std::unique_ptr<GradientMinimizer> screeningMinimizer,
+                       double const screeningDepthWindow );
+
+    // This switches on canonicalization of the starting points and of the
+    // found minima to a single representative of their orbits under the
+    // discrete symmetries of the potential found by symmetryOrbits, so that
+    // each distinct basin is only minimized, and only recorded as a panic
+    // vacuum, once.
+    void
+    SetSymmetryOrbits( std::unique_ptr<FieldSymmetryOrbits> symmetryOrbits )
+    { this->symmetryOrbits = std::move( symmetryOrbits ); }
+
+    // This sets the number of threads used to roll the starting points (and
+    // the screening minimizations) as independent tasks. The default of 1
+    // rolls them one after the other, and 0 uses the default number of
+    // threads of the OpenMP runtime.
+    void SetNumberOfMinimizationThreads(
+                                unsigned int const numberOfMinimizationThreads )
+    { this->numberOfMinimizationThreads = numberOfMinimizationThreads; }
+
   protected:
+    // This is the result of rolling a single starting point with
+    // gradientMinimizer, along with the progress messages which would have
+    // been printed while rolling it.
+    struct RolledStartingPoint
+    {
+      PotentialMinimum foundMinimum;
+      bool rolledToDsbOrSignFlip;
+      std::string progressReport;
+    };
+
+
     std::unique_ptr<StartingPointFinder> startingPointFinder;
     std::unique_ptr<GradientMinimizer> gradientMinimizer;
+    // The screening potential is declared before the screening minimizer
+    // which refers to it, so that it is destroyed after it.
+    std::unique_ptr<PotentialFunction> screeningPotential;
+    std::unique_ptr<GradientMinimizer> screeningMinimizer;
+    double screeningDepthWindow;
+    std::unique_ptr<FieldSymmetryOrbits> symmetryOrbits;
     std::vector< std::vector< double > > startingPoints;
     double extremumSeparationThresholdFraction;
     double nonDsbRollingToDsbScalingFactor;
     bool global_Is_Panic;
     bool done_homotopy;
+    unsigned int numberOfMinimizationThreads;
+
+    // This rolls startingPoint with gradientMinimizer, retrying from scaled
+    // starting points as described in FindMinima, and returns the minimum
+    // along with whether it is the DSB vacuum or a phase rotation of it. The
+    // progress messages are collected in the returned report rather than
+    // printed, so that rolls running concurrently do not interleave their
+    // output.
+    RolledStartingPoint
+    RollStartingPoint( std::vector< double > const& startingPoint,
+                       double const thresholdSeparationSquared ) const;
+
+    // This rolls each of startingPoints with screeningMinimizer at the
+    // temperature minimizationTemperature and puts the configurations of the
+    // screening minima which pass the depth window, as described for
+    // SetScreening, into screenedPoints.
+    void ScreenStartingPoints( double const minimizationTemperature,
+                   std::vector< std::vector< double > >& screenedPoints ) const;
+
+    // This puts the representatives under symmetryOrbits of the orbits of
+    // pointsToCanonicalize into canonicalPoints, leaving out any which are
+    // within the extremum separation threshold of a representative already
+    // there.
+    void CanonicalizeStartingPoints(
+             std::vector< std::vector< double > > const& pointsToCanonicalize,
+                  std::vector< std::vector< double > >& canonicalPoints ) const;
+
+    // This returns true if a minimum in foundMinima from the index
+    // firstComparisonIndex onwards is within the extremum separation
+    // threshold of comparisonMinimum.
+    bool AlreadyFound( PotentialMinimum const& comparisonMinimum,
+                       size_t const firstComparisonIndex ) const;
   };
 
 
@@ -74,5 +160,24 @@ namespace VevaciousPlusPlus
     return (*gradientMinimizer)( minimumToAdjust.FieldConfiguration() );
   }
 
+  // This switches on screening of the starting points with a cheaper
+  // potential (usually the tree-level potential) before the full potential is
+  // minimized: each starting point is first rolled with screeningMinimizer,
+  // which should minimize screeningPotential, and only the distinct screening
+  // minima which are not the screening minimum rolled to from the DSB input
+  // and which are no more than screeningDepthWindow times the absolute depth
+  // of that minimum above it are used as starting points for
+  // gradientMinimizer. If no screening minima pass, the full potential is only
+  // minimized from the DSB input.
+  inline void GradientFromStartingPoints::SetScreening(
+                        std::unique_ptr<PotentialFunction> screeningPotential,
+                        std::unique_ptr<GradientMinimizer> screeningMinimizer,
+                                            double const screeningDepthWindow )
+  {
+    this->screeningPotential = std::move( screeningPotential );
+    this->screeningMinimizer = std::move( screeningMinimizer );
+    this->screeningDepthWindow = screeningDepthWindow;
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* GRADIENTFROMSTARTINGPOINTS_HPP_ */
@@ -56,6 +56,17 @@ namespace VevaciousPlusPlus
 
     double PotentialValue() const{ return functionValue; }
 
+    // This moves the minimum to refinedConfiguration with the value
+    // refinedValue, keeping the errors from the original minimization, and
+    // marks it as no longer valid if isTrueMinimum is false (for example if
+    // refinement showed that it is actually a saddle point).
+    void MoveTo( std::vector< double > const& refinedConfiguration,
+                 double const refinedValue,
+                 bool const isTrueMinimum )
+    { variableValues = refinedConfiguration;
+      functionValue = refinedValue;
+      isValidMinimum = ( isValidMinimum && isTrueMinimum ); }
+
 
     // This prints the minimum as an empty XML element.
     std::string AsEmptyXmlElement( std::string const& elementName,
@@ -0,0 +1,170 @@
+/*
+ * IntervalBranchAndBoundSolver.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef INTERVALBRANCHANDBOUNDSOLVER_HPP_
+#define INTERVALBRANCHANDBOUNDSOLVER_HPP_
+
+#include "PotentialMinimization/StartingPointFinder.hpp"
+#include "PotentialEvaluation/BuildingBlocks/ParametersAndFieldsProductSum.hpp"
+#include "LagrangianParameterManagement/LagrangianParameterManager.hpp"
+#include <cstddef>
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <iostream>
+#include "Utilities/VectorUtilities.hpp"
+#include "Utilities/WarningLogger.hpp"
+
+namespace VevaciousPlusPlus
+{
+  // This class finds the global minimum of the polynomial approximation of
+  // the potential at a fixed scale within a box in field space by interval
+  // branch-and-bound: boxes are bisected in the direction in which they are
+  // widest, and a box is discarded once the lower bound on the polynomial
+  // over the box from interval arithmetic is above the upper bound on the
+  // value of the polynomial at the best point found so far. Both bounds are
+  // rounded outwards, so boxes are only discarded if floating-point rounding
+  // could not have hidden a lower point in them. Boxes are examined in order
+  // of their lower bounds, so once every remaining box has a lower bound
+  // above that of the best point found, the global minimum of the polynomial
+  // within the initial box is certified to lie in one of the boxes which were
+  // bisected down to the resolution size. The best point found and the
+  // centers of those boxes are given as the starting points for the
+  // gradient-based minimizer. This is only practical for models with few
+  // fields, such as the two-Higgs-doublet model, as the number of boxes grows
+  // exponentially with the number of fields.
+  class IntervalBranchAndBoundSolver : public StartingPointFinder
+  {
+  public:
+    IntervalBranchAndBoundSolver(
+                     ParametersAndFieldsProductSum const& polynomialToMinimize,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                                 std::vector< double > const& dsbFieldValues,
+                                  size_t const numberOfFields,
+                                  double const fieldRange,
+                                  double const resolutionFraction,
+                                  size_t const maximumNumberOfBoxes,
+                                  bool const stopOnceDsbIsUnstable );
+    virtual ~IntervalBranchAndBoundSolver();
+
+
+    // This searches the box where each field lies between -fieldRange and
+    // +fieldRange (or the maximum evaluation scale of
+    // lagrangianParameterManager if fieldRange is not positive) for the
+    // global minimum of polynomialToMinimize with the Lagrangian parameters
+    // evaluated at lagrangianParameterManager.AppropriateSingleFixedScale(),
+    // and puts the best point found and the centers of the smallest boxes
+    // which could still contain the global minimum into startingPoints. If
+    // stopOnceDsbIsUnstable is true, the search stops as soon as a point
+    // which is deeper than the DSB field configuration and not just a small
+    // shift of it is found, since then the DSB vacuum is already known to be
+    // unstable at this level of approximation.
+    virtual void
+    operator()( std::vector< std::vector< double > >& startingPoints ) const;
+
+
+  protected:
+    // This holds the bounds on the fields of a box in field space and the
+    // lower bound on the polynomial over it. The comparison is reversed so
+    // that std::priority_queue gives the box with the lowest bound first.
+    struct BoundedBox
+    {
+      BoundedBox( std::vector< double > const& lowerFieldBounds,
+                  std::vector< double > const& upperFieldBounds ) :
+        lowerFieldBounds( lowerFieldBounds ),
+        upperFieldBounds( upperFieldBounds ),
+        lowerBound( 0.0 ) {}
+
+      std::vector< double > lowerFieldBounds;
+      std::vector< double > upperFieldBounds;
+      double lowerBound;
+
+      bool operator<( BoundedBox const& otherBox ) const
+      { return ( lowerBound > otherBox.lowerBound ); }
+    };
+
+    ParametersAndFieldsProductSum const polynomialToMinimize;
+    LagrangianParameterManager const& lagrangianParameterManager;
+    std::vector< double > const& dsbFieldValues;
+    size_t const numberOfFields;
+    double const fieldRange;
+    double const resolutionFraction;
+    size_t const maximumNumberOfBoxes;
+    bool const stopOnceDsbIsUnstable;
+
+    // This sets the lower bound of boxToBound from the interval bounds of
+    // polynomialToMinimize with the Lagrangian parameters given by
+    // parameterValues, and bounds the polynomial at the center of the box
+    // from above, replacing bestValue and bestConfiguration if the bound
+    // there is lower.
+    void BoundBoxAndTryCenter( std::vector< double > const& parameterValues,
+                               BoundedBox& boxToBound,
+                               double& bestValue,
+                           std::vector< double >& bestConfiguration ) const;
+
+    // This appends the center of each box in candidateBoxes which has a lower
+    // bound no greater than bestValue to startingPoints, unless a point
+    // already in startingPoints lies within the box.
+    static void AppendBoxCenters(
+                               std::vector< BoundedBox > const& candidateBoxes,
+                                  double const bestValue,
+                         std::vector< std::vector< double > >& startingPoints );
+
+    // This returns the upper bound from interval arithmetic on the value of
+    // polynomialToMinimize at fieldConfiguration with the Lagrangian
+    // parameters given by parameterValues, so that the true value is
+    // certainly no higher despite floating-point rounding.
+    double UpperBoundAt( std::vector< double > const& parameterValues,
+                     std::vector< double > const& fieldConfiguration ) const;
+
+    // This returns the center of boxToCenter.
+    static std::vector< double > BoxCenter( BoundedBox const& boxToCenter );
+  };
+
+
+
+
+
+  // This returns the upper bound from interval arithmetic on the value of
+  // polynomialToMinimize at fieldConfiguration with the Lagrangian parameters
+  // given by parameterValues, so that the true value is certainly no higher
+  // despite floating-point rounding.
+  inline double IntervalBranchAndBoundSolver::UpperBoundAt(
+                                  std::vector< double > const& parameterValues,
+                       std::vector< double > const& fieldConfiguration ) const
+  {
+    double unusedLowerBound( 0.0 );
+    double upperBound( 0.0 );
+    polynomialToMinimize.IntervalBounds( parameterValues,
+                                         fieldConfiguration,
+                                         fieldConfiguration,
+                                         unusedLowerBound,
+                                         upperBound );
+    return upperBound;
+  }
+
+  // This returns the center of boxToCenter.
+  inline std::vector< double >
+  IntervalBranchAndBoundSolver::BoxCenter( BoundedBox const& boxToCenter )
+  {
+    std::vector< double > boxCenter( boxToCenter.lowerFieldBounds );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < boxCenter.size();
+         ++fieldIndex )
+    {
+      boxCenter[ fieldIndex ]
+      = ( 0.5 * ( boxToCenter.lowerFieldBounds[ fieldIndex ]
+                  + boxToCenter.upperFieldBounds[ fieldIndex ] ) );
+    }
+    return boxCenter;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* INTERVALBRANCHANDBOUNDSOLVER_HPP_ */
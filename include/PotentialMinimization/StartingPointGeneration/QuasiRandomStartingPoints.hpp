@@ -0,0 +1,112 @@
+/*
+ * QuasiRandomStartingPoints.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef QUASIRANDOMSTARTINGPOINTS_HPP_
+#define QUASIRANDOMSTARTINGPOINTS_HPP_
+
+#include "PotentialMinimization/StartingPointFinder.hpp"
+#include "PotentialEvaluation/BuildingBlocks/ParametersAndFieldsProductSum.hpp"
+#include "LagrangianParameterManagement/LagrangianParameterManager.hpp"
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace VevaciousPlusPlus
+{
+  // This class generates starting points for the gradient-based minimizer
+  // without any external homotopy continuation program. It samples the
+  // polynomial approximation of the potential at a fixed scale at the points
+  // of a scrambled Halton sequence within a box in field space, keeps the
+  // lowest fraction of the samples, and clusters them so that only the
+  // lowest sample of each basin is returned: going through the kept samples
+  // from the lowest up, a sample is only returned if no lower kept sample is
+  // within the critical distance of multi-level single-linkage clustering,
+  // which shrinks as more points are sampled. The number of samples is the
+  // knob which trades cost against completeness.
+  class QuasiRandomStartingPoints : public StartingPointFinder
+  {
+  public:
+    QuasiRandomStartingPoints(
+                     ParametersAndFieldsProductSum const& polynomialToMinimize,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                               size_t const numberOfFields,
+                               double const fieldRange,
+                               size_t const numberOfSamples,
+                               double const retainedFraction,
+                               double const clusteringFactor,
+                               size_t const maximumNumberOfStartingPoints,
+                               unsigned int const scramblingSeed );
+    virtual ~QuasiRandomStartingPoints();
+
+
+    // This samples polynomialToMinimize with the Lagrangian parameters
+    // evaluated at lagrangianParameterManager.AppropriateSingleFixedScale()
+    // at the points of the scrambled Halton sequence in the box where each
+    // field lies between -fieldRange and +fieldRange (or the maximum
+    // evaluation scale of lagrangianParameterManager if fieldRange is not
+    // positive), and puts the lowest sample of each cluster into
+    // startingPoints, up to maximumNumberOfStartingPoints of them, lowest
+    // first.
+    virtual void
+    operator()( std::vector< std::vector< double > >& startingPoints ) const;
+
+
+  protected:
+    ParametersAndFieldsProductSum const polynomialToMinimize;
+    LagrangianParameterManager const& lagrangianParameterManager;
+    size_t const numberOfFields;
+    double const fieldRange;
+    size_t const numberOfSamples;
+    double const retainedFraction;
+    double const clusteringFactor;
+    size_t const maximumNumberOfStartingPoints;
+    std::vector< unsigned int > haltonBases;
+    std::vector< std::vector< unsigned int > > digitPermutations;
+
+    // This returns the element of the scrambled Halton sequence with index
+    // sequenceIndex for the dimension with index dimensionIndex, which lies
+    // in [ 0, 1 ).
+    double ScrambledRadicalInverse( size_t sequenceIndex,
+                                    size_t const dimensionIndex ) const;
+  };
+
+
+
+
+
+  // This returns the element of the scrambled Halton sequence with index
+  // sequenceIndex for the dimension with index dimensionIndex, which lies in
+  // [ 0, 1 ).
+  inline double QuasiRandomStartingPoints::ScrambledRadicalInverse(
+                                                          size_t sequenceIndex,
+                                           size_t const dimensionIndex ) const
+  {
+    unsigned int const haltonBase( haltonBases[ dimensionIndex ] );
+    std::vector< unsigned int > const&
+    digitPermutation( digitPermutations[ dimensionIndex ] );
+    double const inverseBase( 1.0 / haltonBase );
+    double digitWeight( inverseBase );
+    double radicalInverse( 0.0 );
+    while( sequenceIndex > 0 )
+    {
+      radicalInverse
+      += ( digitWeight * digitPermutation[ sequenceIndex % haltonBase ] );
+      sequenceIndex /= haltonBase;
+      digitWeight *= inverseBase;
+    }
+    return radicalInverse;
+  }
+
+} /* namespace VevaciousPlusPlus */
+
+#endif /* QUASIRANDOMSTARTINGPOINTS_HPP_ */
@@ -18,6 +18,15 @@
 #include <limits>
 #include "Utilities/WarningLogger.hpp"
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <future>
+#include <functional>
+#include "Utilities/TaskGroup.hpp"
+#include <chrono>
+#include <algorithm>
 
 namespace VevaciousPlusPlus
 {
@@ -40,6 +49,40 @@ namespace VevaciousPlusPlus
                         PotentialMinimum const& falseVacuum,
                         PotentialMinimum const& trueVacuum );
 
+    // This sets the flag which is checked between the stages of the
+    // calculation, so that a calculation running concurrently with others can
+    // be abandoned early once the flag is set to true by another thread. The
+    // results of an abandoned calculation are only upper bounds on the
+    // survival probabilities. Passing NULL means that the calculation is never
+    // abandoned, which is the default.
+    void SetCancellationFlag( std::atomic< bool > const* cancellationFlag )
+    { this->cancellationFlag = cancellationFlag; }
+
+    // This gives a second instance, which should have the same settings but
+    // its own path finders and bounce action calculator, to calculate thermal
+    // tunneling on a separate thread while this instance calculates quantum
+    // tunneling, for the QuantumThenThermal and ThermalThenQuantum
+    // strategies. Passing a null pointer goes back to calculating them one
+    // after the other.
+    void SetConcurrentThermalTunneler(
+                       std::unique_ptr< BounceActionTunneler > thermalTunneler )
+    { concurrentThermalTunneler = std::move( thermalTunneler ); }
+
+    // This makes CalculateTunneling start with its resolutions divided by
+    // 2^numberOfRefinements and then repeat the calculation with the
+    // resolutions doubled each time, up to their full values, as long as
+    // ln(-ln(P)) for the survival probability P is within the uncertainty
+    // margin of ln(-ln(survivalProbabilityThreshold)) and the next
+    // calculation is expected to finish within timeBudgetInSeconds of the
+    // start of the first. The uncertainty margin is taken to be
+    // uncertaintyMargin for the coarsest calculation and to halve with each
+    // refinement. A numberOfRefinements of 0 always calculates with the full
+    // resolutions, which is the default, and a timeBudgetInSeconds which is
+    // not positive means that there is no limit on the time.
+    void SetAdaptiveAccuracy( unsigned int const numberOfRefinements,
+                              double const uncertaintyMargin,
+                              double const timeBudgetInSeconds );
+
 
   protected:
     static double const maximumPowerOfNaturalExponent;
@@ -56,6 +99,75 @@ namespace VevaciousPlusPlus
     std::pair< double, double > rangeOfMaxTemperatureForOriginToTrue;
 
     double const vacuumSeparationFractionSquared;
+    std::atomic< bool > const* cancellationFlag;
+    // This is set when the concurrent calculation of the other kind of
+    // tunneling has already decided the outcome of the tunneling strategy.
+    std::atomic< bool > resultIsUnneeded;
+    std::unique_ptr< BounceActionTunneler > concurrentThermalTunneler;
+    unsigned int numberOfAccuracyRefinements;
+    double coarsestUncertaintyMargin;
+    double accuracyTimeBudgetInSeconds;
+    // The resolutions used by the current calculation are the full values
+    // divided by 2^accuracyCoarsening.
+    unsigned int accuracyCoarsening;
+
+    // This returns true if the calculation should be abandoned because
+    // cancellationFlag or resultIsUnneeded has been set.
+    bool CalculationIsCancelled() const
+    { return ( resultIsUnneeded.load()
+               ||
+               ( ( cancellationFlag != NULL ) && cancellationFlag->load() ) ); }
+
+    // This returns fullResolution divided by 2^accuracyCoarsening, but no
+    // less than minimumResolution (or fullResolution if that is smaller).
+    unsigned int CoarsenedResolution( unsigned int const fullResolution,
+                                 unsigned int const minimumResolution ) const;
+
+    // This calls the virtual tunneling calculation functions based on
+    // tunnelingStrategy, with the resolutions given by accuracyCoarsening.
+    void CalculateForStrategy( PotentialFunction const& potentialFunction,
+                               PotentialMinimum const& falseVacuum,
+                               PotentialMinimum const& trueVacuum );
+
+    // This repeats CalculateForStrategy with accuracyCoarsening going down
+    // from numberOfAccuracyRefinements for as long as the result is within
+    // the uncertainty margin of the threshold and the time budget allows,
+    // and then records the uncertainty margin of the last calculation in
+    // logOfMinusLogUncertainty.
+    void CalculateWithAdaptiveAccuracy(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum );
+
+    // This calculates quantum tunneling on one thread while
+    // concurrentThermalTunneler calculates thermal tunneling on another, and
+    // then copies the thermal results from concurrentThermalTunneler. As soon
+    // as the calculation which comes first in tunnelingStrategy gives a
+    // survival probability no greater than survivalProbabilityThreshold, the
+    // other is abandoned and its results are left as not calculated, just as
+    // if it had never been started. The progress messages of the thermal
+    // calculation are collected while it runs and then written after those
+    // of the quantum calculation, so that the two do not interleave.
+    void CalculateQuantumAndThermalConcurrently(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum );
+
+    // This calculates quantum tunneling and, if tunnelingStrategy is
+    // QuantumThenThermal and the survival probability is no greater than
+    // survivalProbabilityThreshold, marks the result of
+    // concurrentThermalTunneler as unneeded.
+    void QuantumTunnelingTask( PotentialFunction const& potentialFunction,
+                               PotentialMinimum const& falseVacuum,
+                               PotentialMinimum const& trueVacuum );
+
+    // This calculates thermal tunneling with concurrentThermalTunneler and,
+    // if tunnelingStrategy is ThermalThenQuantum and the survival probability
+    // is no greater than survivalProbabilityThreshold, marks the quantum
+    // result of this instance as unneeded.
+    void ThermalTunnelingTask( PotentialFunction const& potentialFunction,
+                               PotentialMinimum const& falseVacuum,
+                               PotentialMinimum const& trueVacuum );
 
 
     // This is a hook to allow for derived classes to prepare things common to
@@ -188,15 +300,15 @@ namespace VevaciousPlusPlus
           // Here we have the origin as the false vacuum. 
           rangeOfMaxTemperatureForOriginToFalse.first = maximumAllowedTemperature;
           rangeOfMaxTemperatureForOriginToFalse.second = maximumAllowedTemperature;
-          std::cout << "We are tunneling from the origin as DSB is not"
+          ProgressStream() << "We are tunneling from the origin as DSB is not"
           << " present at one-loop. Setting maximum temperature at which"
           << " the false vacuum is still present to the Planck scale";
-          std::cout << std::endl;
+          ProgressStream() << std::endl;
         }
     else
         {
           // false vacuum is NOT the origin. 
-          std::cout << std::endl
+          ProgressStream() << std::endl
           << "Looking for temperature at which tunneling from the field origin to"
           << " the false vacuum at "
           << falseVacuum.AsMathematica( potentialFunction.FieldNames() )
@@ -207,7 +319,7 @@ namespace VevaciousPlusPlus
                                                potentialAtOriginAtZeroTemperature );
         }
 
-    std::cout << std::endl
+    ProgressStream() << std::endl
     << "Looking for temperature at which tunneling from the field origin to"
     << " the false vacuum at "
     << falseVacuum.AsMathematica( potentialFunction.FieldNames() )
@@ -216,7 +328,7 @@ namespace VevaciousPlusPlus
                                          rangeOfMaxTemperatureForOriginToFalse,
                                          falseVacuum,
                                          potentialAtOriginAtZeroTemperature );
-    std::cout << std::endl
+    ProgressStream() << std::endl
     << "Looking for temperature at which tunneling from the field origin to"
     << " the true vacuum at "
     << trueVacuum.AsMathematica( potentialFunction.FieldNames() )
@@ -227,6 +339,41 @@ namespace VevaciousPlusPlus
                                          potentialAtOriginAtZeroTemperature );
   }
 
+  // This makes CalculateTunneling start with its resolutions divided by
+  // 2^numberOfRefinements and then repeat the calculation with the
+  // resolutions doubled each time, up to their full values, as long as
+  // ln(-ln(P)) for the survival probability P is within the uncertainty margin
+  // of ln(-ln(survivalProbabilityThreshold)) and the next calculation is
+  // expected to finish within timeBudgetInSeconds of the start of the first.
+  // The uncertainty margin is taken to be uncertaintyMargin for the coarsest
+  // calculation and to halve with each refinement. A numberOfRefinements of 0
+  // always calculates with the full resolutions, which is the default, and a
+  // timeBudgetInSeconds which is not positive means that there is no limit on
+  // the time.
+  inline void
+  BounceActionTunneler::SetAdaptiveAccuracy(
+                                       unsigned int const numberOfRefinements,
+                                              double const uncertaintyMargin,
+                                            double const timeBudgetInSeconds )
+  {
+    // Dividing by more than 2^31 would not leave any resolution anyway.
+    numberOfAccuracyRefinements = std::min( numberOfRefinements,
+                                            31u );
+    coarsestUncertaintyMargin = uncertaintyMargin;
+    accuracyTimeBudgetInSeconds = timeBudgetInSeconds;
+  }
+
+  // This returns fullResolution divided by 2^accuracyCoarsening, but no less
+  // than minimumResolution (or fullResolution if that is smaller).
+  inline unsigned int BounceActionTunneler::CoarsenedResolution(
+                                            unsigned int const fullResolution,
+                                  unsigned int const minimumResolution ) const
+  {
+    return std::max( std::min( fullResolution,
+                               minimumResolution ),
+                     ( fullResolution >> accuracyCoarsening ) );
+  }
+
   // This returns true if the temperature is below that at which tunneling
   // from the field origin to zeroTemperatureVacuum becomes impossible.
   inline bool BounceActionTunneler::BelowCriticalTemperature(
@@ -20,10 +20,12 @@
 #include <cstddef>
 #include "PotentialMinimization/GradientBasedMinimization/MinuitPotentialMinimizer.hpp"
 #include <iostream>
+#include <memory>
 #include "Utilities/WarningLogger.hpp"
 #include "BounceActionEvaluation/PathParameterization/TunnelPath.hpp"
 #include "BounceActionEvaluation/PathParameterization/LinearSplineThroughNodes.hpp"
 #include "BounceActionEvaluation/SplinePotential.hpp"
+#include "BounceActionEvaluation/HermiteSplinePotential.hpp"
 #include "BounceActionEvaluation/BubbleProfile.hpp"
 
 namespace VevaciousPlusPlus
@@ -40,7 +42,8 @@ namespace VevaciousPlusPlus
                                   unsigned int const temperatureAccuracy,
                                   unsigned int const pathPotentialResolution,
                                   unsigned int const pathFindingTimeout,
-                                  double const vacuumSeparationFraction);
+                                  double const vacuumSeparationFraction,
+                                  bool const smoothPathPotential = false );
     virtual ~BounceAlongPathWithThreshold();
 
 
@@ -50,6 +53,15 @@ namespace VevaciousPlusPlus
     unsigned int thermalIntegrationResolution;
     unsigned int const pathPotentialResolution;
     unsigned int const pathFindingTimeout;
+    bool const smoothPathPotential;
+
+    // This returns a new SplinePotential for potentialFunction along
+    // tunnelPath, or a new HermiteSplinePotential if smoothPathPotential is
+    // true, with pathPotentialResolution coarsened by accuracyCoarsening.
+    std::unique_ptr<SplinePotential>
+    CreatePathPotential( PotentialFunction const& potentialFunction,
+                         TunnelPath const& tunnelPath,
+                  double const requiredVacuumSeparationSquared ) const;
 
 
     // This returns either the dimensionless bounce action integrated over four
@@ -94,6 +106,33 @@ namespace VevaciousPlusPlus
 
 
 
+  // This returns a new SplinePotential for potentialFunction along
+  // tunnelPath, or a new HermiteSplinePotential if smoothPathPotential is
+  // true, with pathPotentialResolution coarsened by accuracyCoarsening.
+  inline std::unique_ptr<SplinePotential>
+  BounceAlongPathWithThreshold::CreatePathPotential(
+                                    PotentialFunction const& potentialFunction,
+                                                  TunnelPath const& tunnelPath,
+                          double const requiredVacuumSeparationSquared ) const
+  {
+    unsigned int const
+    numberOfPotentialSegments( CoarsenedResolution( pathPotentialResolution,
+                                                    10 ) );
+    if( smoothPathPotential )
+    {
+      return std::unique_ptr<SplinePotential>( new HermiteSplinePotential(
+                                                             potentialFunction,
+                                                                    tunnelPath,
+                                                     numberOfPotentialSegments,
+                                           requiredVacuumSeparationSquared ) );
+    }
+    return std::unique_ptr<SplinePotential>( new SplinePotential(
+                                                             potentialFunction,
+                                                                    tunnelPath,
+                                                     numberOfPotentialSegments,
+                                           requiredVacuumSeparationSquared ) );
+  }
+
   // This returns either the dimensionless bounce action integrated over four
   // dimensions (for zero temperature) or the dimensionful bounce action
   // integrated over three dimensions (for non-zero temperature) for
@@ -11,6 +11,8 @@
 
 #include "PotentialEvaluation/PotentialFunction.hpp"
 #include "PotentialMinimization/PotentialMinimum.hpp"
+#include <iostream>
+#include <ostream>
 
 namespace VevaciousPlusPlus
 {
@@ -38,9 +40,11 @@ namespace VevaciousPlusPlus
       logOfMinusLogOfThermalProbability( -1.0E+100 ),
       partialThermalDecayWidth(-1),
       dominantTemperatureInGigaElectronVolts( -1.0 ),
+      logOfMinusLogUncertainty( -1.0 ),
       survivalProbabilityThreshold( survivalProbabilityThreshold ),
       thresholdAndActions(0),
-      thermalThresholdAndActions(0) {}
+      thermalThresholdAndActions(0),
+      progressStream( &std::cout ) {}
 
     virtual ~TunnelingCalculator() {}
 
@@ -83,6 +87,17 @@ namespace VevaciousPlusPlus
     double PartialThermalDecayWidth() const
     { return partialThermalDecayWidth; }
 
+    // This returns the larger of ln(-ln(P)) for the quantum and thermal
+    // survival probabilities P which were calculated, so that a larger value
+    // means a faster decay, or -1.0E+100 if neither was calculated.
+    double LogOfMinusLogOfSurvival() const;
+
+    // This returns the estimated uncertainty on LogOfMinusLogOfSurvival() if
+    // the accuracy of the calculation was adapted to the result, or a
+    // negative number if it was not estimated.
+    double LogOfMinusLogOfSurvivalUncertainty() const
+    { return logOfMinusLogUncertainty; }
+
     // This returns a vector with the bounce action for the straight path
     // and the best action found by each used pathfinder.
 
@@ -92,6 +107,12 @@ namespace VevaciousPlusPlus
     std::vector< double > GetThermalThresholdAndActions() const
     { return thermalThresholdAndActions;}
 
+    // This sets the stream to which progress messages are written, which is
+    // std::cout by default, so that calculations which run concurrently can
+    // each collect their messages to be printed in order afterwards.
+    void SetProgressStream( std::ostream& progressStream )
+    { this->progressStream = &progressStream; }
+
 
   protected:
     TunnelingStrategy tunnelingStrategy;
@@ -101,6 +122,7 @@ namespace VevaciousPlusPlus
     double thermalSurvivalProbability;
     double logOfMinusLogOfThermalProbability;
     double dominantTemperatureInGigaElectronVolts;
+    double logOfMinusLogUncertainty;
     double survivalProbabilityThreshold;
     double partialThermalDecayWidth;
     // The vectors below will hold the action threshold in their 0 component
@@ -108,7 +130,33 @@ namespace VevaciousPlusPlus
     // and subsequently the best action for each path finder
     std::vector< double > thresholdAndActions;
     std::vector< double > thermalThresholdAndActions;
+    std::ostream* progressStream;
+
+    // This returns the stream to which progress messages should be written.
+    std::ostream& ProgressStream() const { return *progressStream; }
   };
 
+
+
+
+  // This returns the larger of ln(-ln(P)) for the quantum and thermal
+  // survival probabilities P which were calculated, so that a larger value
+  // means a faster decay, or -1.0E+100 if neither was calculated.
+  inline double TunnelingCalculator::LogOfMinusLogOfSurvival() const
+  {
+    double logOfMinusLogOfSurvival( -1.0E+100 );
+    if( quantumSurvivalProbability >= 0.0 )
+    {
+      logOfMinusLogOfSurvival = logOfMinusLogOfQuantumProbability;
+    }
+    if( ( thermalSurvivalProbability >= 0.0 )
+        &&
+        ( logOfMinusLogOfThermalProbability > logOfMinusLogOfSurvival ) )
+    {
+      logOfMinusLogOfSurvival = logOfMinusLogOfThermalProbability;
+    }
+    return logOfMinusLogOfSurvival;
+  }
+
 } /* namespace VevaciousPlusPlus */
 #endif /* TUNNELINGCALCULATOR_HPP_ */
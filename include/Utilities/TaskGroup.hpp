@@ -0,0 +1,162 @@
+/*
+ * TaskGroup.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef TASKGROUP_HPP_
+#define TASKGROUP_HPP_
+
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace VevaciousPlusPlus
+{
+  // This class collects independent pieces of work, such as minimizations
+  // from different starting points or tunneling calculations to different
+  // vacua, and runs them concurrently as OpenMP tasks, so that all the
+  // components which can split up their work do so through the same
+  // mechanism. The OpenMP runtime keeps a pool of threads which take queued
+  // tasks as they become idle, so uneven tasks are balanced automatically.
+  // Each submitted task gives a std::future for its result, which also
+  // carries any exception thrown by the task, since exceptions cannot leave
+  // an OpenMP task directly.
+  //
+  // If RunAll is called from within a task of another TaskGroup (or any other
+  // OpenMP parallel region), the new tasks join the queue of the threads
+  // which are already running rather than starting a new set of threads, so
+  // nested groups interleave their tasks. With numberOfThreads given as 1, or
+  // without OpenMP, the tasks are just run one after the other in the order
+  // in which they were submitted.
+  class TaskGroup
+  {
+  public:
+    // A numberOfThreads of 0 uses the default number of threads of the
+    // OpenMP runtime.
+    TaskGroup( unsigned int const numberOfThreads = 0 ) :
+      numberOfThreads( numberOfThreads ),
+      pendingTasks() {}
+
+    virtual ~TaskGroup() {}
+
+
+    // This queues taskFunction, which must be callable with no arguments, to
+    // be run by the next call of RunAll, and returns a future which gives its
+    // result (or throws its exception) once RunAll has returned.
+    template< typename FunctionType >
+    std::future< typename std::result_of< FunctionType() >::type >
+    Submit( FunctionType taskFunction );
+
+    // This runs all the tasks which have been submitted since the last call,
+    // concurrently where possible, and returns once they have all finished.
+    void RunAll();
+
+    // This returns the number of tasks waiting for RunAll.
+    size_t NumberOfPendingTasks() const { return pendingTasks.size(); }
+
+
+  protected:
+    // This runs a std::packaged_task which is shared with the future given
+    // out by Submit, as std::function needs a copyable target.
+    template< typename ResultType >
+    struct PackagedTaskRunner
+    {
+      typedef std::shared_ptr< std::packaged_task< ResultType() > >
+      TaskPointer;
+
+      PackagedTaskRunner( TaskPointer const& packagedTask ) :
+        packagedTask( packagedTask ) {}
+
+      TaskPointer packagedTask;
+
+      void operator()() const { (*packagedTask)(); }
+    };
+
+    unsigned int const numberOfThreads;
+    std::vector< std::function< void() > > pendingTasks;
+
+    // This creates an OpenMP task for each of tasksToRun and waits for them
+    // all to finish. It has to be called from within a parallel region.
+    static void
+    SpawnAndWait( std::vector< std::function< void() > >& tasksToRun );
+  };
+
+
+
+
+  // This queues taskFunction, which must be callable with no arguments, to be
+  // run by the next call of RunAll, and returns a future which gives its
+  // result (or throws its exception) once RunAll has returned.
+  template< typename FunctionType >
+  inline std::future< typename std::result_of< FunctionType() >::type >
+  TaskGroup::Submit( FunctionType taskFunction )
+  {
+    typedef typename std::result_of< FunctionType() >::type ResultType;
+    std::shared_ptr< std::packaged_task< ResultType() > >
+    packagedTask( new std::packaged_task< ResultType() >( taskFunction ) );
+    pendingTasks.push_back( PackagedTaskRunner< ResultType >( packagedTask ) );
+    return packagedTask->get_future();
+  }
+
+  // This runs all the tasks which have been submitted since the last call,
+  // concurrently where possible, and returns once they have all finished.
+  inline void TaskGroup::RunAll()
+  {
+    std::vector< std::function< void() > > tasksToRun;
+    tasksToRun.swap( pendingTasks );
+#ifdef _OPENMP
+    if( ( numberOfThreads != 1 )
+        &&
+        ( tasksToRun.size() > 1 ) )
+    {
+      if( omp_in_parallel() )
+      {
+        SpawnAndWait( tasksToRun );
+        return;
+      }
+      int const threadsToUse( ( numberOfThreads > 0 ) ?
+                              static_cast< int >( numberOfThreads ) :
+                              omp_get_max_threads() );
+#pragma omp parallel num_threads( threadsToUse )
+      {
+#pragma omp single
+        SpawnAndWait( tasksToRun );
+      }
+      return;
+    }
+#endif
+    for( std::vector< std::function< void() > >::iterator
+         taskToRun( tasksToRun.begin() );
+         taskToRun < tasksToRun.end();
+         ++taskToRun )
+    {
+      (*taskToRun)();
+    }
+  }
+
+  // This creates an OpenMP task for each of tasksToRun and waits for them all
+  // to finish. It has to be called from within a parallel region.
+  inline void TaskGroup::SpawnAndWait(
+                          std::vector< std::function< void() > >& tasksToRun )
+  {
+    for( size_t taskIndex( 0 );
+         taskIndex < tasksToRun.size();
+         ++taskIndex )
+    {
+      std::function< void() >* const taskToRun( &(tasksToRun[ taskIndex ]) );
+#pragma omp task firstprivate( taskToRun )
+      (*taskToRun)();
+    }
+#pragma omp taskwait
+  }
+
+} /* namespace VevaciousPlusPlus */
+#endif /* TASKGROUP_HPP_ */
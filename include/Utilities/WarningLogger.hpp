@@ -25,7 +25,8 @@ namespace VevaciousPlusPlus
     SetWarningRecord( std::vector< std::string >* const warningDestination );
 
     // This prints the warning to std::cout and also stores it for later
-    // recall.
+    // recall. Warnings can be logged from concurrent tunneling calculations,
+    // so only one thread at a time is allowed to record its warning.
     static void LogWarning( std::string const& warningMessage );
 
 
@@ -43,14 +44,18 @@ namespace VevaciousPlusPlus
   }
 
   // This prints the warning to std::cout and also stores it for later
-  // recall.
+  // recall. Warnings can be logged from concurrent tunneling calculations, so
+  // only one thread at a time is allowed to record its warning.
   inline void WarningLogger::LogWarning( std::string const& warningMessage )
   {
-    if( warningMessages != NULL )
+#pragma omp critical( VevaciousPlusPlusWarningLogger )
     {
-      warningMessages->push_back( warningMessage );
+      if( warningMessages != NULL )
+      {
+        warningMessages->push_back( warningMessage );
+      }
+      std::cout << "Warning: " << warningMessage << std::endl;
     }
-    std::cout << "Warning: " << warningMessage << std::endl;
   }
 
 }
@@ -22,6 +22,8 @@
 #include "PotentialMinimization/StartingPointFinder.hpp"
 #include "PotentialMinimization/StartingPointGeneration/PolynomialAtFixedScalesSolver.hpp"
 #include "PotentialMinimization/StartingPointGeneration/PolynomialSystemSolver.hpp"
+#include "PotentialMinimization/StartingPointGeneration/IntervalBranchAndBoundSolver.hpp"
+#include "PotentialMinimization/StartingPointGeneration/QuasiRandomStartingPoints.hpp"
 #include "PotentialMinimization/HomotopyContinuation/Hom4ps2Runner.hpp"
 #include "PotentialMinimization/HomotopyContinuation/PHCRunner.hpp"
 #include "PotentialMinimization/GradientMinimizer.hpp"
@@ -36,6 +38,10 @@
 #include "BounceActionEvaluation/BubbleShootingOnPathInFieldSpace.hpp"
 #include <ctime>
 #include <fstream>
+#include <atomic>
+#include <future>
+#include <functional>
+#include "Utilities/TaskGroup.hpp"
 #include "VersionInformation.hpp"
 #include "LHPC/Utilities/ParsingUtilities.hpp"
 #include <sstream>
@@ -115,6 +121,20 @@ namespace VevaciousPlusPlus
     				   std::vector<std::pair<int,double>> const& parameters, 
     				   int const dimension );
 
+    // This sets the parameter point given by newInput, as RunPoint does, but
+    // without finding the minima or calculating tunneling, so that the
+    // potential can then be evaluated for that point through
+    // GetPotentialFunction.
+    void NewParameterPoint( std::string const& newInput );
+
+    // This clears any blocks which were given by ReadLhaBlock.
+    void ClearParameterPoint()
+    { lagrangianParameterManager->ClearParameterPoint(); }
+
+    // This returns the potential which is minimized for each parameter point.
+    PotentialFunction const& GetPotentialFunction() const
+    { return potentialMinimizer->GetPotentialFunction(); }
+
     // This writes the results as an XML file.
     void WriteResultsAsXmlFile( std::string const& xmlFilename );
     
@@ -140,6 +160,19 @@ namespace VevaciousPlusPlus
     void AppendResultsToLhaFile( std::string const& lhaFilename,
                                  bool const writeWarnings = true );
 
+    // This sets whether RunPoint should calculate tunneling from the DSB
+    // vacuum to every deeper minimum found by the PotentialMinimizer,
+    // concurrently on up to numberOfTunnelingThreads threads (0 meaning one
+    // thread for each deeper minimum), rather than just to the single panic
+    // vacuum chosen by the PotentialMinimizer. It only has an effect if the
+    // TunnelingCalculator was created from an initialization file and is a
+    // BounceAlongPathWithThreshold, as each deeper minimum needs its own
+    // instance.
+    void SetTunnelingToEveryPanicVacuum( bool const tunnelToEveryPanicVacuum,
+                                unsigned int const numberOfTunnelingThreads )
+    { this->tunnelToEveryPanicVacuum = tunnelToEveryPanicVacuum;
+      this->numberOfTunnelingThreads = numberOfTunnelingThreads; }
+
 
   protected:
     typedef PotentialFromPolynomialWithMasses OneLoopPotential;
@@ -224,6 +257,20 @@ namespace VevaciousPlusPlus
                     PotentialFromPolynomialWithMasses const& potentialFunction,
                                      std::string const& constructorArguments );
 
+    // This creates a new IntervalBranchAndBoundSolver based on the given
+    // arguments and returns a pointer to it.
+    static std::unique_ptr<IntervalBranchAndBoundSolver>
+    CreateIntervalBranchAndBoundSolver(
+                    PotentialFromPolynomialWithMasses const& potentialFunction,
+                                     std::string const& constructorArguments );
+
+    // This creates a new QuasiRandomStartingPoints based on the given
+    // arguments and returns a pointer to it.
+    static std::unique_ptr<QuasiRandomStartingPoints>
+    CreateQuasiRandomStartingPoints(
+                    PotentialFromPolynomialWithMasses const& potentialFunction,
+                                     std::string const& constructorArguments );
+
     // This puts the content of the current element of xmlParser into
     // contentDestination, interpreted as an int represented in ASCII, if the
     // element's name matches elementName.
@@ -339,6 +386,22 @@ namespace VevaciousPlusPlus
     std::unique_ptr<PotentialFromPolynomialWithMasses> ownedPotentialFunction;
     std::unique_ptr<PotentialMinimizer> potentialMinimizer;
     std::unique_ptr<TunnelingCalculator> tunnelingCalculator;
+    std::string tunnelingCalculatorInitializationFilename;
+    bool tunnelToEveryPanicVacuum;
+    unsigned int numberOfTunnelingThreads;
+    // These are created from tunnelingCalculatorInitializationFilename, one
+    // for each deeper minimum, the first time that tunneling to every panic
+    // vacuum is calculated, and then kept for later parameter points, with
+    // more only being created if a later point has more deeper minima.
+    std::vector< std::unique_ptr< TunnelingCalculator > >
+    panicVacuumCalculators;
+    // This points at the element of panicVacuumCalculators which holds the
+    // results for tunnelingPanicVacuum if tunneling to every panic vacuum was
+    // calculated for the last point, and is NULL otherwise.
+    TunnelingCalculator* panicVacuumResults;
+    // This is the deeper minimum to which the results of tunnelingCalculator
+    // refer.
+    PotentialMinimum tunnelingPanicVacuum;
     std::vector< std::string > warningMessagesFromConstructor;
     std::string resultsFromLastRunAsXml;
     std::vector< std::string > warningMessagesFromLastRun;
@@ -347,6 +410,56 @@ namespace VevaciousPlusPlus
     // This prepares the results in XML format, stored in resultsAsXml;
     void PrepareResultsAsXml();
 
+    // This calculates tunneling from the DSB vacuum to each deeper minimum
+    // found by potentialMinimizer concurrently, each with its own element of
+    // panicVacuumCalculators, which are created from
+    // tunnelingCalculatorInitializationFilename the first time that they are
+    // needed and then kept for later parameter points. As soon as one of them
+    // gives a survival probability below the threshold, the point is
+    // excluded, so the calculations which are still running are abandoned
+    // and those which have not yet started are skipped. The progress messages
+    // of each calculation are collected while it runs and then printed in the
+    // order of the deeper minima. The deeper minimum with the lowest survival
+    // probability is put into tunnelingPanicVacuum and panicVacuumResults is
+    // pointed at its TunnelingCalculator, leaving tunnelingCalculator as it
+    // was. It returns false without calculating anything if there are no
+    // deeper minima or if the TunnelingCalculator cannot be duplicated for
+    // concurrent calculations.
+    bool CalculateTunnelingToEveryPanicVacuum();
+
+    // This calculates tunneling from the DSB vacuum to panicVacuum with
+    // vacuumCalculator unless pointIsExcluded is already true, and sets
+    // pointIsExcluded to true if the survival probability is below the
+    // threshold. It returns false if the calculation was skipped. The cache
+    // of potential values bypasses itself within the concurrent tasks, as it
+    // is not safe to share between threads.
+    bool TunnelToPanicVacuum( TunnelingCalculator& vacuumCalculator,
+                              PotentialMinimum const& panicVacuum,
+                              std::atomic< bool >& pointIsExcluded ) const;
+
+    // This returns tunnelingCalculator, first creating it from the file given
+    // by tunnelingCalculatorInitializationFilename if it has not been created
+    // yet, so that runs which never calculate tunneling, such as RunVacua, do
+    // not pay for reading the tunneling initialization file or building the
+    // tunneling components.
+    TunnelingCalculator& GetTunnelingCalculator();
+
+    // This returns the TunnelingCalculator which holds the results of the
+    // last tunneling calculation: the element of panicVacuumCalculators
+    // pointed at by panicVacuumResults if tunneling to every panic vacuum was
+    // calculated, or else GetTunnelingCalculator().
+    TunnelingCalculator& TunnelingResults()
+    { return ( ( panicVacuumResults != NULL ) ?
+               *panicVacuumResults :
+               GetTunnelingCalculator() ); }
+
+    // This makes sure that the mass-squared matrices of
+    // ownedPotentialFunction have been parsed, which has to happen before the
+    // first parameter point is read.
+    void PrepareLoopCorrections()
+    { if( ownedPotentialFunction )
+      { ownedPotentialFunction->PrepareLoopCorrections(); } }
+
     // This returns a vector which is the union of
     // warningMessagesFromConstructor with warningMessagesFromLastRun.
     std::vector< std::string > WarningMessagesToReport() const;
@@ -396,12 +509,27 @@ namespace VevaciousPlusPlus
     return result;
   }
 
+  // This returns tunnelingCalculator, first creating it from the file given by
+  // tunnelingCalculatorInitializationFilename if it has not been created yet,
+  // so that runs which never calculate tunneling, such as RunVacua, do not
+  // pay for reading the tunneling initialization file or building the
+  // tunneling components.
+  inline TunnelingCalculator& VevaciousPlusPlus::GetTunnelingCalculator()
+  {
+    if( !tunnelingCalculator )
+    {
+      tunnelingCalculator
+      = CreateTunnelingCalculator( tunnelingCalculatorInitializationFilename );
+    }
+    return *tunnelingCalculator;
+  }
+
      // This gives the Lifetime in seconds as output.
   inline double
   VevaciousPlusPlus::GetLifetimeInSeconds() {
-    if (tunnelingCalculator->QuantumSurvivalProbability() >= 0.0)
+    if (TunnelingResults().QuantumSurvivalProbability() >= 0.0)
     {
-    return tunnelingCalculator->QuantumLifetimeInSeconds();
+    return TunnelingResults().QuantumLifetimeInSeconds();
     }
   else
     {
@@ -412,11 +540,11 @@ namespace VevaciousPlusPlus
 
   inline double
   VevaciousPlusPlus::GetThermalDecayWidth() {
-    if (tunnelingCalculator->ThermalSurvivalProbability() >= 0.0)
+    if (TunnelingResults().ThermalSurvivalProbability() >= 0.0)
     {
     // Here we multiply by M_Planck^3 to get the witdth in GeV   
     double MPCubed = 1.4437663e+55;
-    return MPCubed * tunnelingCalculator->PartialThermalDecayWidth();
+    return MPCubed * TunnelingResults().PartialThermalDecayWidth();
     }
   else
     {
@@ -427,9 +555,9 @@ namespace VevaciousPlusPlus
   // This gives the upper bound on the thermal survival probability as output.
   inline double
   VevaciousPlusPlus::GetThermalProbability() {
-    if (tunnelingCalculator->ThermalSurvivalProbability()  >= 0.0)
+    if (TunnelingResults().ThermalSurvivalProbability()  >= 0.0)
     {
-      return tunnelingCalculator->ThermalSurvivalProbability();
+      return TunnelingResults().ThermalSurvivalProbability();
     }
     else
     {
@@ -440,18 +568,19 @@ namespace VevaciousPlusPlus
   inline
   std::vector<double> VevaciousPlusPlus::GetThresholdAndActions(){
 
-    return tunnelingCalculator->GetThresholdAndActions();
+    return TunnelingResults().GetThresholdAndActions();
 
   }
 
   inline
   std::vector<double> VevaciousPlusPlus::GetThermalThresholdAndActions(){
 
-   return tunnelingCalculator->GetThermalThresholdAndActions();
+   return TunnelingResults().GetThermalThresholdAndActions();
   }
 
 
 
+
 // This reads the current element of outerParser and if its name matches
   // elementName, it puts the contents of the child element <ClassType> into
   // className and <ConstructorArguments> into constructorArguments, both
@@ -565,12 +694,23 @@ namespace VevaciousPlusPlus
       return std::move(CreatePolynomialAtFixedScalesSolver( potentialFunction,
                                                   constructorArguments ));
     }
+    else if( classChoice == "IntervalBranchAndBoundSolver" )
+    {
+      return std::move(CreateIntervalBranchAndBoundSolver( potentialFunction,
+                                                  constructorArguments ));
+    }
+    else if( classChoice == "QuasiRandomStartingPoints" )
+    {
+      return std::move(CreateQuasiRandomStartingPoints( potentialFunction,
+                                                  constructorArguments ));
+    }
     else
     {
       std::stringstream errorStream;
       errorStream
       << "<StartingPointFinderClass> was not a recognized class! The only"
-      << " option currently valid is \"PolynomialAtFixedScalesSolver\".";
+      << " options currently valid are \"PolynomialAtFixedScalesSolver\","
+      << " \"IntervalBranchAndBoundSolver\", or \"QuasiRandomStartingPoints\".";
       throw std::runtime_error( errorStream.str() );
     }
   }
@@ -812,6 +952,9 @@ namespace VevaciousPlusPlus
   {
     double lengthScaleResolutionForBounce( 0.05 );
     unsigned int shootAttemptsForBounce( 32 );
+    unsigned int roughShootAttempts( 0 );
+    double roughIntegrationTolerance( 1.0e-4 );
+    double roughActionUncertainty( 0.05 );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
     while( xmlParser.ReadNextElement() )
@@ -822,10 +965,22 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "NumberShootAttemptsAllowed",
                                      shootAttemptsForBounce );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "RoughShootAttempts",
+                                     roughShootAttempts );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "RoughIntegrationTolerance",
+                                     roughIntegrationTolerance );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "RoughActionUncertainty",
+                                     roughActionUncertainty );
     }
     return
     Utils::make_unique<BubbleShootingOnPathInFieldSpace>( lengthScaleResolutionForBounce,
-                                          shootAttemptsForBounce );
+                                          shootAttemptsForBounce,
+                                          roughShootAttempts,
+                                          roughIntegrationTolerance,
+                                          roughActionUncertainty );
   }
 
   // This returns a vector which is the union of
@@ -0,0 +1,142 @@
+/*
+ * VevaciousPlusPlusCInterface.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#ifndef VEVACIOUSPLUSPLUSCINTERFACE_H_
+#define VEVACIOUSPLUSPLUSCINTERFACE_H_
+
+/*
+ * These functions give a plain C interface to VevaciousPlusPlus in the
+ * VevaciousPlusPlus shared library, so that scan frameworks and scripts in
+ * other languages (for example Python through ctypes) can load a model, give
+ * it parameter points from memory, and evaluate the potential and its
+ * gradient for whole arrays of field configurations in single calls, at the
+ * speed of the C++ code.
+ *
+ * All the functions which can fail return 0 on success and -1 on failure, in
+ * which case VevaciousPlusPlus_LastErrorMessage gives the message of the
+ * exception which caused the failure. No C++ exception ever leaves these
+ * functions. Calls must not be made concurrently, even on separate handles,
+ * as every instance records its warnings through the single process-wide
+ * record of WarningLogger, which VevaciousPlusPlus_Create and
+ * VevaciousPlusPlus_FindMinima point at the instance they are working on.
+ *
+ * Arrays of field configurations are given as numberOfConfigurations
+ * consecutive blocks of VevaciousPlusPlus_NumberOfFields doubles each, with
+ * the fields in the order given by VevaciousPlusPlus_FieldName. Gradients
+ * are returned in the same layout.
+ *
+ * The interface version is only increased when existing functions change, so
+ * callers can check it with VevaciousPlusPlus_InterfaceVersion.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct VevaciousPlusPlusHandle VevaciousPlusPlusHandle;
+
+/* This returns the version of this interface. */
+int VevaciousPlusPlus_InterfaceVersion( void );
+
+/* This returns the message of the last failure on the calling thread, or an
+ * empty string if there has not been one. The string stays valid until the
+ * next failure on the same thread. */
+char const* VevaciousPlusPlus_LastErrorMessage( void );
+
+/* This creates a VevaciousPlusPlus instance from the initialization file with
+ * name initializationFilename, as the main program does, and returns a handle
+ * to it, or NULL on failure. */
+VevaciousPlusPlusHandle*
+VevaciousPlusPlus_Create( char const* initializationFilename );
+
+/* This deletes the instance created by VevaciousPlusPlus_Create. It does
+ * nothing if vevaciousHandle is NULL. */
+void VevaciousPlusPlus_Destroy( VevaciousPlusPlusHandle* vevaciousHandle );
+
+/* This returns the number of field variables of the potential, or -1 on
+ * failure. */
+int
+VevaciousPlusPlus_NumberOfFields( VevaciousPlusPlusHandle* vevaciousHandle );
+
+/* This returns the name of the field with index fieldIndex, or NULL on
+ * failure. The string stays valid as long as the handle does. */
+char const*
+VevaciousPlusPlus_FieldName( VevaciousPlusPlusHandle* vevaciousHandle,
+                             int fieldIndex );
+
+/* This gives an SLHA block to the Lagrangian parameter manager from memory,
+ * as VevaciousPlusPlus::ReadLhaBlock does, with the numberOfEntries entries
+ * given by entryIndices and entryValues. A dimension of 1 reads the entries
+ * as a list, while a dimension of n reads them as an n by n matrix row by
+ * row. The block is only used once VevaciousPlusPlus_NewParameterPoint is
+ * called with "internal", which updates the parameters interpolated from the
+ * blocks and prepares the loop corrections of the potential, so it must be
+ * called after the blocks of a parameter point have been read and before the
+ * potential is evaluated. */
+int VevaciousPlusPlus_ReadLhaBlock( VevaciousPlusPlusHandle* vevaciousHandle,
+                                    char const* uppercaseBlockName,
+                                    double scale,
+                                    int const* entryIndices,
+                                    double const* entryValues,
+                                    int numberOfEntries,
+                                    int dimension );
+
+/* This sets the parameter point given by newInput, which is either the name
+ * of an SLHA file or "internal" for the blocks given by
+ * VevaciousPlusPlus_ReadLhaBlock, without finding minima or calculating
+ * tunneling. */
+int
+VevaciousPlusPlus_NewParameterPoint( VevaciousPlusPlusHandle* vevaciousHandle,
+                                     char const* newInput );
+
+/* This clears the blocks given by VevaciousPlusPlus_ReadLhaBlock. */
+int VevaciousPlusPlus_ClearParameterPoint(
+                                    VevaciousPlusPlusHandle* vevaciousHandle );
+
+/* This puts the value of the potential in GeV^4 at the temperature
+ * temperatureValue in GeV for each of the numberOfConfigurations field
+ * configurations in fieldConfigurations into the corresponding element of
+ * potentialValues, which must have space for numberOfConfigurations
+ * doubles. */
+int VevaciousPlusPlus_EvaluatePotential(
+                                      VevaciousPlusPlusHandle* vevaciousHandle,
+                                         double const* fieldConfigurations,
+                                         int numberOfConfigurations,
+                                         double temperatureValue,
+                                         double* potentialValues );
+
+/* This puts the gradient of the potential with respect to the fields at the
+ * temperature temperatureValue in GeV for each of the numberOfConfigurations
+ * field configurations in fieldConfigurations into gradientVectors, which
+ * must have space for as many doubles as fieldConfigurations has. The
+ * gradient is exact where the potential provides it, and otherwise from
+ * central differences with steps of 1 GeV, evaluated for all the
+ * configurations as a single batch. */
+int VevaciousPlusPlus_EvaluateGradients(
+                                      VevaciousPlusPlusHandle* vevaciousHandle,
+                                         double const* fieldConfigurations,
+                                         int numberOfConfigurations,
+                                         double temperatureValue,
+                                         double* gradientVectors );
+
+/* This finds the minima of the potential for the parameter point given by
+ * newInput, as VevaciousPlusPlus::RunVacua does, and puts the field values of
+ * the global minimum into globalMinimum and those of the deeper minimum
+ * nearest to the DSB minimum into nearestMinimum, each of which must have
+ * space for VevaciousPlusPlus_NumberOfFields doubles. They are filled with
+ * NaN if the minimizer did not find such a minimum. */
+int VevaciousPlusPlus_FindMinima( VevaciousPlusPlusHandle* vevaciousHandle,
+                                  char const* newInput,
+                                  double* globalMinimum,
+                                  double* nearestMinimum );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VEVACIOUSPLUSPLUSCINTERFACE_H_ */
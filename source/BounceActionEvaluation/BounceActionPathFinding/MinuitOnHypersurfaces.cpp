@@ -26,6 +26,8 @@ namespace VevaciousPlusPlus
     currentParallelComponent(),
     currentHyperplaneOrigin(),
     reflectionMatrix(),
+    hyperplaneBasis(),
+    exactGradientAvailable( false ),
     nodeZeroParameterization(),
     minuitResultAsUntransformedVector()
   {
@@ -72,6 +74,13 @@ namespace VevaciousPlusPlus
                                         numberOfFields );
     nodeZeroParameterization = std::vector< double >( ( numberOfFields - 1 ),
                                                       0.0  );
+    // The potential either always or never provides its gradient exactly, so
+    // it is enough to check once at the false vacuum.
+    std::vector< double > gradientVector;
+    exactGradientAvailable
+    = potentialFunction.SetAsExactGradientAt( gradientVector,
+                                              falseVacuum.FieldConfiguration(),
+                                              pathTemperature );
     SetNodesForInitialPath( falseVacuum,
                             trueVacuum );
     SetCurrentMinuitTolerance( falseVacuum,
@@ -80,7 +89,7 @@ namespace VevaciousPlusPlus
 
   // This sets up reflectionMatrix to be the Householder reflection matrix
   // which reflects the axis of field 0 to be parallel to
-  // currentParallelComponent.
+  // currentParallelComponent, and hyperplaneBasis to match it.
   void MinuitOnHypersurfaces::SetUpHouseholderReflection()
   {
     // First we check that targetVector doesn't already lie on the axis of the
@@ -152,6 +161,33 @@ namespace VevaciousPlusPlus
                                         * minusInverseOfOneMinusDotProduct ) );
       }
     }
+    hyperplaneBasis = reflectionMatrix.rightCols( numberOfFields - 1 );
+  }
+
+  // This creates and runs a Minuit2 MnMigrad object starting from
+  // nodeZeroParameterization and returns its result. Minuit only uses
+  // Gradient if it is given this object as an FCNGradientBase, so if the
+  // potential cannot provide its gradient exactly, it is given this object as
+  // just an FCNBase.
+  ROOT::Minuit2::FunctionMinimum MinuitOnHypersurfaces::RunMigradOnNode()
+  {
+    if( exactGradientAvailable )
+    {
+      ROOT::Minuit2::MnMigrad
+      mnMigrad( static_cast< ROOT::Minuit2::FCNGradientBase const& >( *this ),
+                nodeZeroParameterization,
+                minuitInitialSteps,
+                minuitStrategy );
+      return mnMigrad( 0,
+                       currentMinuitTolerance );
+    }
+    ROOT::Minuit2::MnMigrad
+    mnMigrad( static_cast< ROOT::Minuit2::FCNBase const& >( *this ),
+              nodeZeroParameterization,
+              minuitInitialSteps,
+              minuitStrategy );
+    return mnMigrad( 0,
+                     currentMinuitTolerance );
   }
 
   // This creates and runs a Minuit2 MnMigrad object and converts the result
@@ -160,12 +196,7 @@ namespace VevaciousPlusPlus
   Eigen::VectorXd
   MinuitOnHypersurfaces::RunMigradAndReturnDisplacement()
   {
-    ROOT::Minuit2::MnMigrad mnMigrad( *this,
-                                      nodeZeroParameterization,
-                                      minuitInitialSteps,
-                                      minuitStrategy );
-    ROOT::Minuit2::FunctionMinimum const minuitResult( mnMigrad( 0,
-                                                    currentMinuitTolerance ) );
+    ROOT::Minuit2::FunctionMinimum const minuitResult( RunMigradOnNode() );
 
     // We return a zero displacement if Minuit2 failed to minimize operator()
     // better than that.
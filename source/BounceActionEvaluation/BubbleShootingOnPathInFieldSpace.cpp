@@ -14,13 +14,21 @@ namespace VevaciousPlusPlus
 
   BubbleShootingOnPathInFieldSpace::BubbleShootingOnPathInFieldSpace(
                                             double const lengthScaleResolution,
-                                           unsigned int const shootAttempts ) :
+                                             unsigned int const shootAttempts,
+                                        unsigned int const roughShootAttempts,
+                                       double const roughIntegrationTolerance,
+                                       double const roughActionUncertainty ) :
     BounceActionCalculator(),
     lengthScaleResolution( lengthScaleResolution ),
     radialStepSize( -1.0 ),
     estimatedRadialMaximum( -1.0 ),
     shootAttempts( shootAttempts ),
-    auxiliaryThreshold( 1.0E-6 )
+    auxiliaryThreshold( 1.0E-6 ),
+    roughShootAttempts( roughShootAttempts ),
+    roughIntegrationTolerance( roughIntegrationTolerance ),
+    actionThreshold( 0.0 ),
+    hasActionThreshold( false ),
+    roughRelativeUncertainty( roughActionUncertainty )
   {
     // This constructor is just an initialization list.
   }
@@ -31,22 +39,76 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This sets up the bubble profile, numerically integrates the bounce action
-  // over it, and then returns the bubble profile with calculated bounce action
-  // along the path given by tunnelPath. Either S_4, the dimensionless quantum
-  // bounce action integrated over four dimensions, or S_3(T), the dimensionful
-  // (in GeV) thermal bounce action integrated over three dimensions at
-  // temperature T, is calculated: S_3(T) if the temperature T given by
-  // tunnelPath is greater than 0.0, S_4 otherwise.
+  // If roughShootAttempts is not 0 and an action threshold has been set since
+  // the last call of ResetVacua, this first shoots with roughShootAttempts
+  // attempts and roughIntegrationTolerance. If the resulting bounce action is
+  // further from the threshold than twice its estimated uncertainty, the
+  // rough bubble is returned with that uncertainty. Otherwise, or if there is
+  // no threshold, this returns the bubble profile from shooting with
+  // shootAttempts attempts and the default integration tolerance. Either S_4,
+  // the dimensionless quantum bounce action integrated over four dimensions,
+  // or S_3(T), the dimensionful (in GeV) thermal bounce action integrated over
+  // three dimensions at temperature T, is calculated: S_3(T) if the
+  // temperature T given by tunnelPath is greater than 0.0, S_4 otherwise.
   BubbleProfile*
   BubbleShootingOnPathInFieldSpace::operator()( TunnelPath const& tunnelPath,
                   OneDimensionalPotentialAlongPath const& pathPotential ) const
+  {
+    if( !hasActionThreshold
+        ||
+        ( roughShootAttempts == 0 ) )
+    {
+      return ShootBubble( tunnelPath,
+                          pathPotential,
+                          shootAttempts,
+                          1.0e-6 );
+    }
+    UndershootOvershootBubble* roughBubble( ShootBubble( tunnelPath,
+                                                         pathPotential,
+                                                         roughShootAttempts,
+                                                 roughIntegrationTolerance ) );
+    double const roughAction( roughBubble->BounceAction() );
+    double const
+    roughUncertainty( roughRelativeUncertainty * fabs( roughAction ) );
+    if( fabs( roughAction - actionThreshold ) > ( 2.0 * roughUncertainty ) )
+    {
+      roughBubble->BounceActionUncertainty() = roughUncertainty;
+      return roughBubble;
+    }
+    UndershootOvershootBubble* preciseBubble( ShootBubble( tunnelPath,
+                                                           pathPotential,
+                                                           shootAttempts,
+                                                           1.0e-6 ) );
+    // The difference between the rough and precise bounce actions is used to
+    // make sure that the uncertainty assumed for later rough bounce actions
+    // is not too optimistic.
+    double const preciseAction( preciseBubble->BounceAction() );
+    if( fabs( preciseAction ) > 0.0 )
+    {
+      roughRelativeUncertainty = std::max( roughRelativeUncertainty,
+                                           ( fabs( roughAction - preciseAction )
+                                             / fabs( preciseAction ) ) );
+    }
+    delete roughBubble;
+    return preciseBubble;
+  }
+
+  // This sets up the bubble profile by shooting with the given number of
+  // attempts and integration tolerance, numerically integrates the bounce
+  // action over it, and then returns the bubble profile with calculated bounce
+  // action along the path given by tunnelPath.
+  UndershootOvershootBubble* BubbleShootingOnPathInFieldSpace::ShootBubble(
+                                                  TunnelPath const& tunnelPath,
+                         OneDimensionalPotentialAlongPath const& pathPotential,
+                                      unsigned int const numberOfShootAttempts,
+                                    double const integrationTolerance ) const
   {
     UndershootOvershootBubble*
     bubbleProfile( new UndershootOvershootBubble( radialStepSize,
                                                   estimatedRadialMaximum,
-                                                  shootAttempts,
-                                                  auxiliaryThreshold ) );
+                                                  numberOfShootAttempts,
+                                                  auxiliaryThreshold,
+                                                  integrationTolerance ) );
     bubbleProfile->CalculateProfile( tunnelPath,
                                      pathPotential );
 
@@ -0,0 +1,161 @@
+/*
+ * HermiteSplinePotential.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#include "BounceActionEvaluation/HermiteSplinePotential.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  HermiteSplinePotential::HermiteSplinePotential(
+                                    PotentialFunction const& potentialFunction,
+                                                  TunnelPath const& tunnelPath,
+                                  unsigned int const numberOfPotentialSegments,
+                         double const minimumSquareDistanceBetweenPathVacua ) :
+    SplinePotential( potentialFunction,
+                     tunnelPath,
+                     numberOfPotentialSegments,
+                     minimumSquareDistanceBetweenPathVacua ),
+    nodeAuxiliaries(),
+    nodePotentials(),
+    nodeSlopes()
+  {
+    if( !energyBarrierWasResolved )
+    {
+      return;
+    }
+
+    // The path false vacuum and the path panic vacuum are taken to be minima
+    // along the path, so have zero slope, as for the quadratic end segments
+    // of SplinePotential. In between, the nodes are the starts of the normal
+    // segments and the start of the final segment, which have their
+    // potentials relative to the path false vacuum in potentialValues.
+    nodeAuxiliaries.push_back( auxiliaryOfPathFalseVacuum );
+    nodePotentials.push_back( 0.0 );
+    nodeSlopes.push_back( 0.0 );
+    for( size_t nodeIndex( 0 );
+         nodeIndex <= numberOfNormalSegments;
+         ++nodeIndex )
+    {
+      double const nodeAuxiliary( auxiliaryOfPathFalseVacuum
+                          + ( static_cast< double >( nodeIndex + 1 )
+                              * auxiliaryStep ) );
+      if( nodeAuxiliary >= auxiliaryOfPathPanicVacuum )
+      {
+        break;
+      }
+      nodeAuxiliaries.push_back( nodeAuxiliary );
+      nodePotentials.push_back( potentialValues[ nodeIndex ] );
+      nodeSlopes.push_back( PotentialSlopeAlongPath( nodeAuxiliary ) );
+    }
+    nodeAuxiliaries.push_back( auxiliaryOfPathPanicVacuum );
+    nodePotentials.push_back( finalPotential );
+    nodeSlopes.push_back( 0.0 );
+    LimitSlopesForMonotonicity();
+  }
+
+  HermiteSplinePotential::~HermiteSplinePotential()
+  {
+    // This does nothing.
+  }
+
+
+  // This returns the derivative of the potential with respect to the path
+  // auxiliary at auxiliaryValue.
+  double HermiteSplinePotential::PotentialSlopeAlongPath(
+                                            double const auxiliaryValue ) const
+  {
+    // The direction of the path is found by a finite difference over a
+    // fraction of a segment, which only needs the path itself to be
+    // evaluated, and is projected onto the exact gradient of the potential
+    // if there is one.
+    double const auxiliaryDifference( 1.0e-3 * auxiliaryStep );
+    double const lowerAuxiliary( std::max( 0.0,
+                                  ( auxiliaryValue - auxiliaryDifference ) ) );
+    double const upperAuxiliary( std::min( 1.0,
+                                  ( auxiliaryValue + auxiliaryDifference ) ) );
+    size_t const numberOfFields( fieldConfiguration.size() );
+    std::vector< double > lowerConfiguration( numberOfFields );
+    std::vector< double > upperConfiguration( numberOfFields );
+    tunnelPath.PutOnPathAt( lowerConfiguration,
+                            lowerAuxiliary );
+    tunnelPath.PutOnPathAt( upperConfiguration,
+                            upperAuxiliary );
+    std::vector< double > nodeConfiguration( numberOfFields );
+    tunnelPath.PutOnPathAt( nodeConfiguration,
+                            auxiliaryValue );
+    std::vector< double > gradientVector( numberOfFields );
+    if( potentialFunction.SetAsExactGradientAt( gradientVector,
+                                                nodeConfiguration,
+                                                pathTemperature ) )
+    {
+      double projectedGradient( 0.0 );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        projectedGradient += ( gradientVector[ fieldIndex ]
+                               * ( upperConfiguration[ fieldIndex ]
+                                   - lowerConfiguration[ fieldIndex ] ) );
+      }
+      return ( projectedGradient / ( upperAuxiliary - lowerAuxiliary ) );
+    }
+    return ( ( potentialFunction( upperConfiguration,
+                                  pathTemperature )
+               - potentialFunction( lowerConfiguration,
+                                    pathTemperature ) )
+             / ( upperAuxiliary - lowerAuxiliary ) );
+  }
+
+  // This reduces the magnitudes of nodeSlopes where necessary so that the
+  // cubic polynomial of each interval is monotonic if the potential at its
+  // nodes is, by the criteria of Fritsch and Carlson.
+  void HermiteSplinePotential::LimitSlopesForMonotonicity()
+  {
+    for( size_t intervalIndex( 0 );
+         ( intervalIndex + 1 ) < nodeAuxiliaries.size();
+         ++intervalIndex )
+    {
+      double const secantSlope( ( nodePotentials[ intervalIndex + 1 ]
+                                  - nodePotentials[ intervalIndex ] )
+                                / ( nodeAuxiliaries[ intervalIndex + 1 ]
+                                    - nodeAuxiliaries[ intervalIndex ] ) );
+      double& lowerSlope( nodeSlopes[ intervalIndex ] );
+      double& upperSlope( nodeSlopes[ intervalIndex + 1 ] );
+      if( secantSlope == 0.0 )
+      {
+        lowerSlope = 0.0;
+        upperSlope = 0.0;
+        continue;
+      }
+      // A node slope with the opposite sign to the secant would make the
+      // cubic overshoot one of the node values, so it is set to zero. Since
+      // later intervals can only reduce the magnitudes of the slopes, the
+      // conditions for earlier intervals stay satisfied.
+      double lowerRatio( lowerSlope / secantSlope );
+      double upperRatio( upperSlope / secantSlope );
+      if( lowerRatio < 0.0 )
+      {
+        lowerSlope = 0.0;
+        lowerRatio = 0.0;
+      }
+      if( upperRatio < 0.0 )
+      {
+        upperSlope = 0.0;
+        upperRatio = 0.0;
+      }
+      double const ratioRadiusSquared( ( lowerRatio * lowerRatio )
+                                       + ( upperRatio * upperRatio ) );
+      if( ratioRadiusSquared > 9.0 )
+      {
+        double const scalingFactor( 3.0 / sqrt( ratioRadiusSquared ) );
+        lowerSlope = ( scalingFactor * lowerRatio * secantSlope );
+        upperSlope = ( scalingFactor * upperRatio * secantSlope );
+      }
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -16,7 +16,8 @@ namespace VevaciousPlusPlus
                                        double const initialIntegrationStepSize,
                                       double const initialIntegrationEndRadius,
                                       unsigned int const allowShootingAttempts,
-                                             double const shootingThreshold ) :
+                                              double const shootingThreshold,
+                                          double const integrationTolerance ) :
     BubbleProfile(),
     auxiliaryProfile(),
     auxiliaryAtBubbleCenter( -1.0 ),
@@ -32,6 +33,7 @@ namespace VevaciousPlusPlus
     initialConditions( 2 ),
     shootingThresholdSquared( shootingThreshold * shootingThreshold ),
     allowShootingAttempts( allowShootingAttempts ),
+    integrationTolerance( integrationTolerance ),
     worthIntegratingFurther( true ),
     currentShotGoodEnough( false ),
     badInitialConditions( false ),
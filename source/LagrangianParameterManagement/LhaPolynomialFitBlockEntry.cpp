@@ -18,7 +18,8 @@ namespace VevaciousPlusPlus
                                          lhaParser,
                                          parameterName ),
     scaleLogarithmPowerCoefficients( std::vector< double > ( 1,
-                                                             0.0 ) )
+                                                             0.0 ) ),
+    scaleLogarithmDerivativeCoefficients()
   {
     // This constructor is just an initialization list.
   }
@@ -27,7 +28,9 @@ namespace VevaciousPlusPlus
                               LhaPolynomialFitBlockEntry const& copySource ) :
     LhaInterpolatedParameterFunctionoid( copySource ),
     scaleLogarithmPowerCoefficients(
-                                   copySource.scaleLogarithmPowerCoefficients )
+                                  copySource.scaleLogarithmPowerCoefficients ),
+    scaleLogarithmDerivativeCoefficients(
+                             copySource.scaleLogarithmDerivativeCoefficients )
   {
     // This constructor is just an initialization list.
   }
@@ -39,7 +42,7 @@ namespace VevaciousPlusPlus
 
 
   // This re-calculates the coefficients of the polynomial of the logarithm
-  // of the scale used in evaluating the functionoid.
+  // of the scale used in evaluating the functionoid, and of its derivative.
   void LhaPolynomialFitBlockEntry::UpdateForNewLhaParameters()
   {
     // We set up a matrix equation for the coefficients of the polynomial in
@@ -119,6 +122,8 @@ namespace VevaciousPlusPlus
                              scaleDependenceMatrix.colPivHouseholderQr().solve(
                                                      scaleDependenceVector ) );
     }
+    scaleLogarithmDerivativeCoefficients.BecomeFirstDerivativeOf(
+                                             scaleLogarithmPowerCoefficients );
   }
 
 } /* namespace VevaciousPlusPlus */
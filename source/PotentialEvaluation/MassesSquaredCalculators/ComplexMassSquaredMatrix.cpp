@@ -37,81 +37,68 @@ namespace VevaciousPlusPlus
     // This does nothing.
   }
 
-  // This returns a matrix of the values of the elements for a field
-   // configuration given by fieldConfiguration, using the values for the
-   // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXcd ComplexMassSquaredMatrix::CurrentValues(
+  // This writes the values of the elements in the fill pattern for a field
+  // configuration given by fieldConfiguration, using the values for the
+  // Lagrangian parameters found in parameterValues, into the lower triangle
+  // of valuesMatrix.
+  void ComplexMassSquaredMatrix::AssembleValues(
                                   std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+                               std::vector< double > const& fieldConfiguration,
+                                                MatrixMap valuesMatrix ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
-      for( size_t columnIndex( 0 );
-           columnIndex < rowIndex;
-           ++columnIndex )
+      ComplexParametersAndFieldsProductSum const&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      std::complex< double >&
+      elementValue( valuesMatrix.coeffRef( filledElement->rowIndex,
+                                           filledElement->columnIndex ) );
+      elementValue.real( complexPair.first( parameterValues,
+                                            fieldConfiguration ) );
+      // The diagonal elements of a Hermitian matrix are real, so their
+      // imaginary parts are left as zero. The Eigen routines don't bother
+      // looking at elements of valuesMatrix where columnIndex > rowIndex, so
+      // we don't even bother filling them with the conjugates of the
+      // transpose.
+      if( filledElement->columnIndex < filledElement->rowIndex )
       {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
-                                                               parameterValues,
-                                                          fieldConfiguration ));
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
-                                                               parameterValues,
-                                                          fieldConfiguration ));
-        // The Eigen routines don't bother looking at elements of valuesMatrix
-        // where columnIndex > rowIndex, so we don't even bother filling them
-        // with the conjugates of the transpose.
+        elementValue.imag( complexPair.second( parameterValues,
+                                               fieldConfiguration ) );
       }
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first( parameterValues,
-                                                          fieldConfiguration ));
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).imag(0.0);
-      rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+    CopyDuplicateElements( valuesMatrix );
   }
 
-  // This returns a matrix of the values of the elements for a field
+  // This writes the values of the elements in the fill pattern for a field
   // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXcd ComplexMassSquaredMatrix::CurrentValues(
-                        std::vector< double > const& fieldConfiguration ) const
+  // Lagrangian parameters from the last call of UpdateForFixedScale, into the
+  // lower triangle of valuesMatrix.
+  void ComplexMassSquaredMatrix::AssembleValues(
+                               std::vector< double > const& fieldConfiguration,
+                                                MatrixMap valuesMatrix ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
-      for( size_t columnIndex( 0 );
-           columnIndex < rowIndex;
-           ++columnIndex )
+      ComplexParametersAndFieldsProductSum const&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      std::complex< double >&
+      elementValue( valuesMatrix.coeffRef( filledElement->rowIndex,
+                                           filledElement->columnIndex ) );
+      elementValue.real( complexPair.first( fieldConfiguration ) );
+      // The diagonal elements of a Hermitian matrix are real, so their
+      // imaginary parts are left as zero.
+      if( filledElement->columnIndex < filledElement->rowIndex )
       {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
-                                                          fieldConfiguration ));
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
-                                                          fieldConfiguration ));
-        // The Eigen routines don't bother looking at elements of valuesMatrix
-        // where columnIndex > rowIndex, so we don't even bother filling them
-        // with the conjugates of the transpose.
+        elementValue.imag( complexPair.second( fieldConfiguration ) );
       }
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first(
-                                                          fieldConfiguration ));
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).imag(0.0);
-      rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+    CopyDuplicateElements( valuesMatrix );
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -13,7 +13,8 @@ namespace VevaciousPlusPlus
   RealMassesSquaredMatrix::RealMassesSquaredMatrix( size_t const numberOfRows,
                    std::map< std::string, std::string > const& attributeMap ) :
     MassesSquaredFromMatrix< double >( numberOfRows,
-                                       attributeMap ),
+                                       attributeMap,
+                                       true ),
     matrixElements( ( numberOfRows * numberOfRows ),
                     ParametersAndFieldsProductSum() )
   {
@@ -41,72 +42,185 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This returns a matrix of the values of the elements for a field
+  // This writes the values of the elements in the fill pattern for a field
   // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXd RealMassesSquaredMatrix::CurrentValues(
+  // Lagrangian parameters found in parameterValues, into both triangles of
+  // valuesMatrix.
+  void RealMassesSquaredMatrix::AssembleValues(
                                   std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+                               std::vector< double > const& fieldConfiguration,
+                                                MatrixMap valuesMatrix ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXd valuesMatrix( numberOfRows,
-                                  numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
+      double const
+      elementValue( matrixElements[ filledElement->elementIndex ](
+                                                               parameterValues,
+                                                        fieldConfiguration ) );
+      valuesMatrix.coeffRef( filledElement->rowIndex,
+                             filledElement->columnIndex ) = elementValue;
+      valuesMatrix.coeffRef( filledElement->columnIndex,
+                             filledElement->rowIndex ) = elementValue;
+    }
+    CopyDuplicateElements( valuesMatrix );
+  }
+
+  // This writes the values of the elements in the fill pattern for a field
+  // configuration given by fieldConfiguration, using the values for the
+  // Lagrangian parameters from the last call of UpdateForFixedScale, into
+  // both triangles of valuesMatrix.
+  void RealMassesSquaredMatrix::AssembleValues(
+                               std::vector< double > const& fieldConfiguration,
+                                                MatrixMap valuesMatrix ) const
+  {
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
+    {
+      double const
+      elementValue( matrixElements[ filledElement->elementIndex ](
+                                                        fieldConfiguration ) );
+      valuesMatrix.coeffRef( filledElement->rowIndex,
+                             filledElement->columnIndex ) = elementValue;
+      valuesMatrix.coeffRef( filledElement->columnIndex,
+                             filledElement->rowIndex ) = elementValue;
+    }
+    CopyDuplicateElements( valuesMatrix );
+  }
+
+  // This sets valuesMatrix to the matrix for a field configuration given by
+  // fieldConfiguration, using the values for the Lagrangian parameters from
+  // the last call of UpdateForFixedScale, and firstDerivatives and
+  // secondDerivatives to its first and second partial derivatives with
+  // respect to the fields, from the exact derivatives of the polynomial
+  // elements in the fill pattern.
+  void RealMassesSquaredMatrix::SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                                 Eigen::MatrixXd& valuesMatrix,
+                              std::vector< Eigen::MatrixXd >& firstDerivatives,
+                   std::vector< Eigen::MatrixXd >& secondDerivatives ) const
+  {
+    size_t const numberOfFields( fieldConfiguration.size() );
+    bool const setSecondDerivatives( !(secondDerivatives.empty()) );
+    std::vector< double > elementGradient( numberOfFields );
+    // The Hessian of each element is left empty if only the first derivatives
+    // are wanted, so that ParametersAndFieldsProductSum does not work them
+    // out.
+    std::vector< std::vector< double > >
+    elementHessian( ( setSecondDerivatives ? numberOfFields : 0 ),
+                    std::vector< double >( numberOfFields ) );
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
+    {
+      size_t const rowIndex( filledElement->rowIndex );
+      size_t const columnIndex( filledElement->columnIndex );
+      ParametersAndFieldsProductSum const&
+      matrixElement( matrixElements[ filledElement->elementIndex ] );
+      double const elementValue( matrixElement( fieldConfiguration ) );
       valuesMatrix.coeffRef( rowIndex,
-                             rowIndex )
-      = matrixElements[ rowsTimesLength + rowIndex ]( parameterValues,
-                                                      fieldConfiguration );
-      for( size_t columnIndex( rowIndex + 1 );
-           columnIndex < numberOfRows;
-           ++columnIndex )
+                             columnIndex ) = elementValue;
+      valuesMatrix.coeffRef( columnIndex,
+                             rowIndex ) = elementValue;
+      elementGradient.assign( numberOfFields,
+                              0.0 );
+      for( std::vector< std::vector< double > >::iterator
+           hessianRow( elementHessian.begin() );
+           hessianRow < elementHessian.end();
+           ++hessianRow )
       {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex )
-        = matrixElements[ rowsTimesLength + columnIndex ]( parameterValues,
-                                                          fieldConfiguration );
-        valuesMatrix.coeffRef( columnIndex,
-                               rowIndex ) = valuesMatrix.coeff( rowIndex,
-                                                                columnIndex );
+        hessianRow->assign( numberOfFields,
+                            0.0 );
+      }
+      matrixElement.AddFixedScaleDerivatives( fieldConfiguration,
+                                              elementGradient,
+                                              elementHessian );
+      for( size_t firstField( 0 );
+           firstField < numberOfFields;
+           ++firstField )
+      {
+        firstDerivatives[ firstField ].coeffRef( rowIndex,
+                                                 columnIndex )
+        = elementGradient[ firstField ];
+        firstDerivatives[ firstField ].coeffRef( columnIndex,
+                                                 rowIndex )
+        = elementGradient[ firstField ];
+        for( size_t secondField( firstField );
+             setSecondDerivatives && ( secondField < numberOfFields );
+             ++secondField )
+        {
+          Eigen::MatrixXd&
+          secondDerivative( secondDerivatives[ ( firstField * numberOfFields )
+                                               + secondField ] );
+          secondDerivative.coeffRef( rowIndex,
+                                     columnIndex )
+          = elementHessian[ firstField ][ secondField ];
+          secondDerivative.coeffRef( columnIndex,
+                                     rowIndex )
+          = elementHessian[ firstField ][ secondField ];
+        }
       }
-      rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+    CopyDuplicateElements( valuesMatrix );
+    CopyDuplicateElements( firstDerivatives );
+    CopyDuplicateElements( secondDerivatives );
   }
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXd RealMassesSquaredMatrix::CurrentValues(
-                        std::vector< double > const& fieldConfiguration ) const
+  // This sets valuesMatrix to the matrix for a field configuration given by
+  // fieldConfiguration, using the values for the Lagrangian parameters found
+  // in parameterValues, and firstDerivatives to its first partial derivatives
+  // with respect to the fields followed by its derivative with respect to the
+  // logarithm of the scale, given the derivatives of the parameters in
+  // parameterScaleDerivatives.
+  void RealMassesSquaredMatrix::SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                                 Eigen::MatrixXd& valuesMatrix,
+                       std::vector< Eigen::MatrixXd >& firstDerivatives ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXd valuesMatrix( numberOfRows,
-                                  numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    size_t const numberOfDerivatives( firstDerivatives.size() );
+    std::vector< double > elementGradient( numberOfDerivatives );
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
+      size_t const rowIndex( filledElement->rowIndex );
+      size_t const columnIndex( filledElement->columnIndex );
+      ParametersAndFieldsProductSum const&
+      matrixElement( matrixElements[ filledElement->elementIndex ] );
+      double const elementValue( matrixElement( parameterValues,
+                                                fieldConfiguration ) );
       valuesMatrix.coeffRef( rowIndex,
-                             rowIndex )
-      = matrixElements[ rowsTimesLength + rowIndex ]( fieldConfiguration );
-      for( size_t columnIndex( rowIndex + 1 );
-           columnIndex < numberOfRows;
-           ++columnIndex )
+                             columnIndex ) = elementValue;
+      valuesMatrix.coeffRef( columnIndex,
+                             rowIndex ) = elementValue;
+      elementGradient.assign( numberOfDerivatives,
+                              0.0 );
+      matrixElement.AddRunningScaleGradient( parameterValues,
+                                             parameterScaleDerivatives,
+                                             fieldConfiguration,
+                                             elementGradient );
+      for( size_t derivativeIndex( 0 );
+           derivativeIndex < numberOfDerivatives;
+           ++derivativeIndex )
       {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex )
-        = matrixElements[ rowsTimesLength + columnIndex ](
-                                                          fieldConfiguration );
-        valuesMatrix.coeffRef( columnIndex,
-                               rowIndex ) = valuesMatrix.coeff( rowIndex,
-                                                                columnIndex );
+        firstDerivatives[ derivativeIndex ].coeffRef( rowIndex,
+                                                      columnIndex )
+        = elementGradient[ derivativeIndex ];
+        firstDerivatives[ derivativeIndex ].coeffRef( columnIndex,
+                                                      rowIndex )
+        = elementGradient[ derivativeIndex ];
       }
-      rowsTimesLength += numberOfRows;
     }
-    return valuesMatrix;
+    CopyDuplicateElements( valuesMatrix );
+    CopyDuplicateElements( firstDerivatives );
   }
 
 } /* namespace VevaciousPlusPlus */
@@ -38,96 +38,89 @@ namespace VevaciousPlusPlus
   }
 
 
-  // This returns a matrix of the values of the elements for a field
-  // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters found in parameterValues.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::MatrixToSquare(
-                                  std::vector< double > const& parameterValues,
-                        std::vector< double > const& fieldConfiguration ) const
+  // This writes the lower-triangular part of the square of the mass matrix
+  // for a field configuration given by fieldConfiguration, using the values
+  // for the Lagrangian parameters found in parameterValues, or those from the
+  // last call of UpdateForFixedScale if parameterValues is NULL, into
+  // valuesMatrix, assembling the mass matrix itself on the stack if it is
+  // small enough.
+  void SymmetricComplexMassMatrix::AssembleSquare(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                           MatrixMap valuesMatrix ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    if( numberOfRows <= static_cast< size_t >( maximumRowsOnStack ) )
     {
-      for( size_t columnIndex( 0 );
-           columnIndex < rowIndex;
-           ++columnIndex )
-      {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
-                                                               parameterValues,
-                                                          fieldConfiguration ));
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
-                                                               parameterValues,
-                                                          fieldConfiguration ));
-        // We use the fact that the matrix is symmetric.
-        valuesMatrix.coeffRef( columnIndex,
-                               rowIndex )
-        = valuesMatrix.coeff( rowIndex,
-                              columnIndex );
-      }
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first( parameterValues,
-                                                          fieldConfiguration ));
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).imag(matrixElements[ rowsTimesLength + rowIndex ].second( parameterValues,
-                                                          fieldConfiguration ));
-      rowsTimesLength += numberOfRows;
+      StackComplexMatrix
+      matrixToSquare( StackComplexMatrix::Zero( numberOfRows,
+                                                numberOfRows ) );
+      MatrixMap const matrixMap( matrixToSquare.data(),
+                                 numberOfRows,
+                                 numberOfRows );
+      AssembleMatrixToSquare( parameterValues,
+                              fieldConfiguration,
+                              matrixMap );
+      LowerTriangleOfSquareMatrix( matrixMap,
+                                   valuesMatrix );
+    }
+    else
+    {
+      Eigen::MatrixXcd matrixToSquare( Eigen::MatrixXcd::Zero( numberOfRows,
+                                                             numberOfRows ) );
+      MatrixMap const matrixMap( matrixToSquare.data(),
+                                 numberOfRows,
+                                 numberOfRows );
+      AssembleMatrixToSquare( parameterValues,
+                              fieldConfiguration,
+                              matrixMap );
+      LowerTriangleOfSquareMatrix( matrixMap,
+                                   valuesMatrix );
     }
-    return valuesMatrix;
   }
 
-  // This returns a matrix of the values of the elements for a field
+  // This writes the values of the elements of the mass matrix for a field
   // configuration given by fieldConfiguration, using the values for the
-  // Lagrangian parameters from the last call of UpdateForFixedScale.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::MatrixToSquare(
-                        std::vector< double > const& fieldConfiguration ) const
+  // Lagrangian parameters found in parameterValues, or those from the last
+  // call of UpdateForFixedScale if parameterValues is NULL, into both
+  // triangles of matrixToSquare, which must be zero in every element which is
+  // not written.
+  void SymmetricComplexMassMatrix::AssembleMatrixToSquare(
+                                  std::vector< double > const* parameterValues,
+                               std::vector< double > const& fieldConfiguration,
+                                         MatrixMap matrixToSquare ) const
   {
-    size_t rowsTimesLength( 0 );
-    Eigen::MatrixXcd valuesMatrix( numberOfRows,
-                                   numberOfRows );
-    for( size_t rowIndex( 0 );
-         rowIndex < numberOfRows;
-         ++rowIndex )
+    for( std::vector< FilledElement >::const_iterator
+         filledElement( filledElements.begin() );
+         filledElement < filledElements.end();
+         ++filledElement )
     {
-      for( size_t columnIndex( 0 );
-           columnIndex < rowIndex;
-           ++columnIndex )
-      {
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).real(matrixElements[ rowsTimesLength + columnIndex ].first(
-                                                          fieldConfiguration ));
-        valuesMatrix.coeffRef( rowIndex,
-                               columnIndex ).imag(matrixElements[ rowsTimesLength + columnIndex ].second(
-                                                          fieldConfiguration ));
-        // We use the fact that the matrix is symmetric.
-        valuesMatrix.coeffRef( columnIndex,
-                               rowIndex )
-        = valuesMatrix.coeff( rowIndex,
-                              columnIndex );
-      }
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).real(matrixElements[ rowsTimesLength + rowIndex ].first(
-                                                          fieldConfiguration ));
-      valuesMatrix.coeffRef( rowIndex,
-                             rowIndex ).imag(matrixElements[ rowsTimesLength + rowIndex ].second(
-                                                          fieldConfiguration ));
-      rowsTimesLength += numberOfRows;
+      ComplexParametersAndFieldsProductSum const&
+      complexPair( matrixElements[ filledElement->elementIndex ] );
+      std::complex< double > const
+      elementValue( ( parameterValues == NULL ) ?
+                    std::complex< double >(
+                                      complexPair.first( fieldConfiguration ),
+                                    complexPair.second( fieldConfiguration ) ) :
+                    std::complex< double >(
+                                      complexPair.first( *parameterValues,
+                                                         fieldConfiguration ),
+                                      complexPair.second( *parameterValues,
+                                                      fieldConfiguration ) ) );
+      matrixToSquare.coeffRef( filledElement->rowIndex,
+                               filledElement->columnIndex ) = elementValue;
+      // We use the fact that the matrix is symmetric.
+      matrixToSquare.coeffRef( filledElement->columnIndex,
+                               filledElement->rowIndex ) = elementValue;
     }
-    return valuesMatrix;
+    CopyDuplicateElements( matrixToSquare );
   }
 
-  // This returns a matrix that is the lower-triangular part (only column
-  // index <= row index) of the square of matrixToSquare.
-  Eigen::MatrixXcd SymmetricComplexMassMatrix::LowerTriangleOfSquareMatrix(
-                                 Eigen::MatrixXcd const& matrixToSquare ) const
+  // This writes the lower-triangular part (only column index <= row index) of
+  // the square of matrixToSquare into valuesSquaredMatrix.
+  void SymmetricComplexMassMatrix::LowerTriangleOfSquareMatrix(
+                                              MatrixMap const& matrixToSquare,
+                                     MatrixMap valuesSquaredMatrix ) const
   {
-    Eigen::MatrixXcd valuesSquaredMatrix( numberOfRows,
-                                          numberOfRows );
     for( size_t rowIndex( 0 );
          rowIndex < numberOfRows;
          ++rowIndex )
@@ -173,7 +166,125 @@ namespace VevaciousPlusPlus
         }
       }
     }
-    return valuesSquaredMatrix;
+  }
+
+  // This sets valuesMatrix to the full square of the mass matrix X, which is
+  // X^dagger X, for a field configuration given by fieldConfiguration, using
+  // the values for the Lagrangian parameters from the last call of
+  // UpdateForFixedScale, and firstDerivatives and secondDerivatives to its
+  // first and second partial derivatives with respect to the fields, by the
+  // product rule from the derivatives of X.
+  void SymmetricComplexMassMatrix::SetMatrixAndDerivatives(
+                               std::vector< double > const& fieldConfiguration,
+                                                Eigen::MatrixXcd& valuesMatrix,
+                             std::vector< Eigen::MatrixXcd >& firstDerivatives,
+                  std::vector< Eigen::MatrixXcd >& secondDerivatives ) const
+  {
+    size_t const numberOfFields( fieldConfiguration.size() );
+    Eigen::MatrixXcd massMatrix( Eigen::MatrixXcd::Zero( numberOfRows,
+                                                         numberOfRows ) );
+    std::vector< Eigen::MatrixXcd > massFirstDerivatives( numberOfFields,
+                                                          massMatrix );
+    std::vector< Eigen::MatrixXcd >
+    massSecondDerivatives( ( secondDerivatives.empty() ?
+                             0 :
+                             ( numberOfFields * numberOfFields ) ),
+                           massMatrix );
+    SetElementsAndDerivatives( fieldConfiguration,
+                               true,
+                               massMatrix,
+                               massFirstDerivatives,
+                               massSecondDerivatives );
+    valuesMatrix = ( massMatrix.adjoint() * massMatrix );
+    std::vector< bool > fieldAffectsMatrix( numberOfFields,
+                                            false );
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      if( massFirstDerivatives[ firstField ].isZero( 0.0 ) )
+      {
+        continue;
+      }
+      fieldAffectsMatrix[ firstField ] = true;
+      Eigen::MatrixXcd const
+      productTerm( massMatrix.adjoint() * massFirstDerivatives[ firstField ] );
+      firstDerivatives[ firstField ] = ( productTerm + productTerm.adjoint() );
+    }
+    for( size_t firstField( 0 );
+         ( firstField < numberOfFields ) && !(secondDerivatives.empty());
+         ++firstField )
+    {
+      for( size_t secondField( firstField );
+           secondField < numberOfFields;
+           ++secondField )
+      {
+        Eigen::MatrixXcd&
+        secondDerivative( secondDerivatives[ ( firstField * numberOfFields )
+                                             + secondField ] );
+        Eigen::MatrixXcd const&
+        massSecondDerivative( massSecondDerivatives[ ( firstField
+                                                       * numberOfFields )
+                                                     + secondField ] );
+        if( !(massSecondDerivative.isZero( 0.0 )) )
+        {
+          Eigen::MatrixXcd const
+          productTerm( massMatrix.adjoint() * massSecondDerivative );
+          secondDerivative += ( productTerm + productTerm.adjoint() );
+        }
+        if( fieldAffectsMatrix[ firstField ]
+            &&
+            fieldAffectsMatrix[ secondField ] )
+        {
+          Eigen::MatrixXcd const
+          productTerm( massFirstDerivatives[ firstField ].adjoint()
+                       * massFirstDerivatives[ secondField ] );
+          secondDerivative += ( productTerm + productTerm.adjoint() );
+        }
+      }
+    }
+  }
+
+  // This sets valuesMatrix to the full square of the mass matrix X for a field
+  // configuration given by fieldConfiguration, using the values for the
+  // Lagrangian parameters found in parameterValues, and firstDerivatives to
+  // its first partial derivatives with respect to the fields followed by its
+  // derivative with respect to the logarithm of the scale, given the
+  // derivatives of the parameters in parameterScaleDerivatives, by the
+  // product rule from the derivatives of X.
+  void SymmetricComplexMassMatrix::SetRunningMatrixAndDerivatives(
+                                  std::vector< double > const& parameterValues,
+                        std::vector< double > const& parameterScaleDerivatives,
+                               std::vector< double > const& fieldConfiguration,
+                                                Eigen::MatrixXcd& valuesMatrix,
+                      std::vector< Eigen::MatrixXcd >& firstDerivatives ) const
+  {
+    size_t const numberOfDerivatives( firstDerivatives.size() );
+    Eigen::MatrixXcd massMatrix( Eigen::MatrixXcd::Zero( numberOfRows,
+                                                         numberOfRows ) );
+    std::vector< Eigen::MatrixXcd > massFirstDerivatives( numberOfDerivatives,
+                                                          massMatrix );
+    SetRunningElementsAndDerivatives( parameterValues,
+                                      parameterScaleDerivatives,
+                                      fieldConfiguration,
+                                      true,
+                                      massMatrix,
+                                      massFirstDerivatives );
+    valuesMatrix = ( massMatrix.adjoint() * massMatrix );
+    for( size_t derivativeIndex( 0 );
+         derivativeIndex < numberOfDerivatives;
+         ++derivativeIndex )
+    {
+      if( massFirstDerivatives[ derivativeIndex ].isZero( 0.0 ) )
+      {
+        continue;
+      }
+      Eigen::MatrixXcd const
+      productTerm( massMatrix.adjoint()
+                   * massFirstDerivatives[ derivativeIndex ] );
+      firstDerivatives[ derivativeIndex ]
+      = ( productTerm + productTerm.adjoint() );
+    }
   }
 
 } /* namespace VevaciousPlusPlus */
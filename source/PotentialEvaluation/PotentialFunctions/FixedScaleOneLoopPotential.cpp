@@ -13,10 +13,12 @@ namespace VevaciousPlusPlus
   FixedScaleOneLoopPotential::FixedScaleOneLoopPotential(
                                               std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                     LagrangianParameterManager& lagrangianParameterManager ) :
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                            bool const deferLoopCorrections ) :
     PotentialFromPolynomialWithMasses( modelFilename,
                                        assumedPositiveOrNegativeTolerance,
-                                       lagrangianParameterManager ),
+                                       lagrangianParameterManager,
+                                       deferLoopCorrections ),
     LHPC::BasicObserver(),
     renormalizationScale( -1.0 ),
     inverseRenormalizationScaleSquared( -1.0 )
@@ -46,6 +48,8 @@ namespace VevaciousPlusPlus
   // parameters evaluated at that scale.
   void FixedScaleOneLoopPotential::RespondToObservedSignal()
   {
+    evaluationCache.Clear();
+    incrementalEvaluation.Clear();
     renormalizationScale
     = lagrangianParameterManager.AppropriateSingleFixedScale();
     inverseRenormalizationScaleSquared
@@ -87,6 +91,56 @@ namespace VevaciousPlusPlus
     }
   }
 
+  // This puts the energy density in GeV^4 of the potential for each of the
+  // field configurations in fieldConfigurations into the corresponding
+  // element of potentialValues, at the temperature in GeV given by
+  // temperatureValue. The polynomial parts are evaluated for the whole batch
+  // in a single traversal of their terms, and each mass-squared matrix is
+  // diagonalized for the whole batch together.
+  void FixedScaleOneLoopPotential::EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                          double const temperatureValue ) const
+  {
+    potentialValues.assign( fieldConfigurations.size(),
+                            0.0 );
+    std::vector< std::vector< double > > fieldValuesByIndex;
+    FieldValuesByIndex( fieldConfigurations,
+                        fieldValuesByIndex );
+    treeLevelPotential.AddToBatch( fieldValuesByIndex,
+                                   potentialValues );
+    polynomialLoopCorrections.AddToBatch( fieldValuesByIndex,
+                                          potentialValues );
+
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    scalarMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              scalarSquareMasses,
+                                              scalarMassesSquaredWithFactors );
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    fermionMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              fermionSquareMasses,
+                                             fermionMassesSquaredWithFactors );
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    vectorMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              vectorSquareMasses,
+                                              vectorMassesSquaredWithFactors );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      potentialValues[ configurationIndex ]
+      += LoopAndThermalCorrections(
+                          scalarMassesSquaredWithFactors[ configurationIndex ],
+                         fermionMassesSquaredWithFactors[ configurationIndex ],
+                          vectorMassesSquaredWithFactors[ configurationIndex ],
+                                            inverseRenormalizationScaleSquared,
+                                                            temperatureValue );
+    }
+  }
+
   // This returns a string that is valid Python with no indentation to evaluate
   // the potential in three functions:
   // TreeLevelPotential( fv ), JustLoopCorrectedPotential( fv ), and
@@ -35,7 +35,8 @@ namespace VevaciousPlusPlus
   PotentialFromPolynomialWithMasses::PotentialFromPolynomialWithMasses(
                                               std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                     LagrangianParameterManager& lagrangianParameterManager ) :
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                            bool const deferLoopCorrections ) :
     PotentialFunction( lagrangianParameterManager ),
     treeLevelPotential(),
     polynomialLoopCorrections(),
@@ -50,7 +51,11 @@ namespace VevaciousPlusPlus
     fieldsAssumedPositive(),
     fieldsAssumedNegative(),
     assumedPositiveOrNegativeTolerance( assumedPositiveOrNegativeTolerance ),
-    readImaginaryPartForRealValue( false )
+    readImaginaryPartForRealValue( false ),
+    modelFilename( modelFilename ),
+    unparsedLoopCorrections( "" ),
+    loopCorrectionsParsed( false ),
+    incrementalEvaluation()
   {
     LHPC::RestrictedXmlParser xmlParser;
     std::string xmlFieldVariables( "" );
@@ -218,134 +223,13 @@ namespace VevaciousPlusPlus
     ParseSumOfPolynomialTerms( xmlTreeLevelPotential,
                                treeLevelPotential );
     // </TreeLevelPotential>
-    // <LoopCorrections>
-    xmlParser.LoadString( xmlLoopCorrections );
-    std::vector< std::string > matrixLines;
-    while( xmlParser.ReadNextElement() )
+    // The mass-squared matrices are only parsed when they are first needed
+    // if deferLoopCorrections is true, as they are usually the bulk of the
+    // model file.
+    unparsedLoopCorrections.assign( xmlLoopCorrections );
+    if( !deferLoopCorrections )
     {
-      //   <ExtraPolynomialPart>
-      if( xmlParser.CurrentName() == "ExtraPolynomialPart" )
-      {
-        ParseSumOfPolynomialTerms( xmlParser.CurrentBody(),
-                                   polynomialLoopCorrections );
-      }
-      //   </ExtraPolynomialPart>
-      //   <RealBosonMassSquaredMatrix>
-      else if( xmlParser.CurrentName() == "RealBosonMassSquaredMatrix" )
-      {
-        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
-                                                       matrixLines,
-                                              "RealBosonMassSquaredMatrix" ) );
-        RealMassesSquaredMatrix massSquaredMatrix( numberOfRows,
-                                               xmlParser.CurrentAttributes() );
-        for( size_t lineIndex( 0 );
-             lineIndex < matrixLines.size();
-             ++lineIndex )
-        {
-          ParseSumOfPolynomialTerms(
-                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
-                                                    matrixLines[ lineIndex ] ),
-                                     massSquaredMatrix.ElementAt( lineIndex ),
-                                     false );
-        }
-        if( massSquaredMatrix.GetSpinType()
-            == MassesSquaredCalculator::gaugeBoson )
-        {
-          vectorMassSquaredMatrices.push_back( massSquaredMatrix );
-        }
-        else
-        {
-          scalarMassSquaredMatrices.push_back( massSquaredMatrix );
-        }
-      }
-      //   </RealBosonMassSquaredMatrix>
-      //   <WeylFermionMassMatrix>
-      else if( xmlParser.CurrentName() == "WeylFermionMassMatrix" )
-      {
-        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
-                                                       matrixLines,
-                                                   "WeylFermionMassMatrix" ) );
-        SymmetricComplexMassMatrix fermionMassMatrix( numberOfRows,
-                                               xmlParser.CurrentAttributes() );
-        for( size_t lineIndex( 0 );
-             lineIndex < matrixLines.size();
-             ++lineIndex )
-        {
-          ParseSumOfPolynomialTerms(
-                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
-                                                    matrixLines[ lineIndex ] ),
-                                    fermionMassMatrix.ElementAt( lineIndex ) );
-        }
-        fermionMassMatrices.push_back( fermionMassMatrix );
-      }
-      //   </WeylFermionMassMatrix>
-      //   <ComplexWeylFermionMassSquaredMatrix>
-      else if( xmlParser.CurrentName()
-               == "ComplexWeylFermionMassSquaredMatrix" )
-      {
-        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
-                                                       matrixLines,
-                                     "ComplexWeylFermionMassSquaredMatrix" ) );
-        ComplexMassSquaredMatrix fermionMassSquaredMatrix( numberOfRows,
-                                               xmlParser.CurrentAttributes() );
-        for( size_t lineIndex( 0 );
-             lineIndex < matrixLines.size();
-             ++lineIndex )
-        {
-          ParseSumOfPolynomialTerms(
-                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
-                                                    matrixLines[ lineIndex ] ),
-                             fermionMassSquaredMatrix.ElementAt( lineIndex ) );
-        }
-        fermionMassSquaredMatrices.push_back( fermionMassSquaredMatrix );
-      }
-      //   </WeylFermionMassMatrix>
-    }
-    // </LoopCorrections>
-
-    if( readImaginaryPartForRealValue )
-    {
-      std::stringstream warningBuilder;
-      warningBuilder << "At least once in \"" << modelFilename
-      << "\", an imaginary part was read for a polynomial which should be"
-      << " purely real. This imaginary part or these imaginary parts have been"
-      << " ignored, as it may be an artifact of a cancellation which is only"
-      << " apparent when there are values for the Lagrangian parameters (e.g."
-      << " soft SUSY-breaking mass-squared matrices should be Hermitian so the"
-      << " imaginary part of the sum of opposite off-diagonal elements is"
-      << " zero).";
-      WarningLogger::LogWarning( warningBuilder.str() );
-    }
-
-    // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
-    // should remain valid as the other vectors do not change size any more
-    // after the constructor.
-    for( size_t pointerIndex( 0 );
-         pointerIndex < scalarMassSquaredMatrices.size();
-         ++pointerIndex )
-    {
-      scalarSquareMasses.push_back(
-                                &(scalarMassSquaredMatrices[ pointerIndex ]) );
-    }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < fermionMassMatrices.size();
-         ++pointerIndex )
-    {
-      fermionSquareMasses.push_back( &(fermionMassMatrices[ pointerIndex ]) );
-    }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < fermionMassSquaredMatrices.size();
-         ++pointerIndex )
-    {
-      fermionSquareMasses.push_back(
-                               &(fermionMassSquaredMatrices[ pointerIndex ]) );
-    }
-    for( size_t pointerIndex( 0 );
-         pointerIndex < vectorMassSquaredMatrices.size();
-         ++pointerIndex )
-    {
-      vectorSquareMasses.push_back(
-                                &(vectorMassSquaredMatrices[ pointerIndex ]) );
+      ParseLoopCorrections();
     }
   }
 
@@ -354,6 +238,19 @@ namespace VevaciousPlusPlus
     // This does nothing.
   }
 
+  // This parses the mass-squared matrices and the extra polynomial part of
+  // <LoopCorrections> if they have not been parsed yet. It has to be called
+  // before the LagrangianParameterManager reads its first parameter point, as
+  // parsing the matrices registers the Lagrangian parameters which appear in
+  // them.
+  void PotentialFromPolynomialWithMasses::PrepareLoopCorrections()
+  {
+    if( !loopCorrectionsParsed )
+    {
+      ParseLoopCorrections();
+    }
+  }
+
   // This writes the potential as
   // def PotentialFunction( fv ): return ...
   // in pythonFilename for fv being an array of floating-point numbers in the
@@ -700,7 +597,11 @@ namespace VevaciousPlusPlus
     fieldsAssumedPositive(),
     fieldsAssumedNegative(),
     assumedPositiveOrNegativeTolerance( -1.0 ),
-    readImaginaryPartForRealValue( false )
+    readImaginaryPartForRealValue( false ),
+    modelFilename( "" ),
+    unparsedLoopCorrections( "" ),
+    loopCorrectionsParsed( true ),
+    incrementalEvaluation()
   {
     // This protected constructor is just an initialization list only used by
     // derived classes which are going to fill up the data members in their own
@@ -725,7 +626,11 @@ namespace VevaciousPlusPlus
     fieldsAssumedNegative( copySource.fieldsAssumedNegative ),
     assumedPositiveOrNegativeTolerance(
                                copySource.assumedPositiveOrNegativeTolerance ),
-    readImaginaryPartForRealValue( copySource.readImaginaryPartForRealValue )
+    readImaginaryPartForRealValue( copySource.readImaginaryPartForRealValue ),
+    modelFilename( copySource.modelFilename ),
+    unparsedLoopCorrections( copySource.unparsedLoopCorrections ),
+    loopCorrectionsParsed( copySource.loopCorrectionsParsed ),
+    incrementalEvaluation( copySource.incrementalEvaluation )
   {
     // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
     // should remain valid as the other vectors do not change size any more
@@ -757,9 +662,157 @@ namespace VevaciousPlusPlus
       vectorSquareMasses.push_back(
                                 &(vectorMassSquaredMatrices[ pointerIndex ]) );
     }
+    // If copySource had not parsed its mass-squared matrices yet, this copy
+    // parses its own, as there is nothing to tell it when to do so later.
+    if( !loopCorrectionsParsed )
+    {
+      ParseLoopCorrections();
+    }
   }
 
 
+  // This parses the mass-squared matrices and the extra polynomial part of
+  // <LoopCorrections> from unparsedLoopCorrections, and fills the
+  // MassesSquaredCalculator* vectors.
+  void PotentialFromPolynomialWithMasses::ParseLoopCorrections()
+  {
+    loopCorrectionsParsed = true;
+    // <LoopCorrections>
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.LoadString( unparsedLoopCorrections );
+    std::vector< std::string > matrixLines;
+    while( xmlParser.ReadNextElement() )
+    {
+      //   <ExtraPolynomialPart>
+      if( xmlParser.CurrentName() == "ExtraPolynomialPart" )
+      {
+        ParseSumOfPolynomialTerms( xmlParser.CurrentBody(),
+                                   polynomialLoopCorrections );
+      }
+      //   </ExtraPolynomialPart>
+      //   <RealBosonMassSquaredMatrix>
+      else if( xmlParser.CurrentName() == "RealBosonMassSquaredMatrix" )
+      {
+        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
+                                                       matrixLines,
+                                              "RealBosonMassSquaredMatrix" ) );
+        RealMassesSquaredMatrix massSquaredMatrix( numberOfRows,
+                                               xmlParser.CurrentAttributes() );
+        for( size_t lineIndex( 0 );
+             lineIndex < matrixLines.size();
+             ++lineIndex )
+        {
+          ParseSumOfPolynomialTerms(
+                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
+                                                    matrixLines[ lineIndex ] ),
+                                     massSquaredMatrix.ElementAt( lineIndex ),
+                                     false );
+        }
+        massSquaredMatrix.PrepareFillPattern();
+        if( massSquaredMatrix.GetSpinType()
+            == MassesSquaredCalculator::gaugeBoson )
+        {
+          vectorMassSquaredMatrices.push_back( massSquaredMatrix );
+        }
+        else
+        {
+          scalarMassSquaredMatrices.push_back( massSquaredMatrix );
+        }
+      }
+      //   </RealBosonMassSquaredMatrix>
+      //   <WeylFermionMassMatrix>
+      else if( xmlParser.CurrentName() == "WeylFermionMassMatrix" )
+      {
+        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
+                                                       matrixLines,
+                                                   "WeylFermionMassMatrix" ) );
+        SymmetricComplexMassMatrix fermionMassMatrix( numberOfRows,
+                                               xmlParser.CurrentAttributes() );
+        for( size_t lineIndex( 0 );
+             lineIndex < matrixLines.size();
+             ++lineIndex )
+        {
+          ParseSumOfPolynomialTerms(
+                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
+                                                    matrixLines[ lineIndex ] ),
+                                    fermionMassMatrix.ElementAt( lineIndex ) );
+        }
+        fermionMassMatrix.PrepareFillPattern();
+        fermionMassMatrices.push_back( fermionMassMatrix );
+      }
+      //   </WeylFermionMassMatrix>
+      //   <ComplexWeylFermionMassSquaredMatrix>
+      else if( xmlParser.CurrentName()
+               == "ComplexWeylFermionMassSquaredMatrix" )
+      {
+        size_t const numberOfRows( PrepareMatrixLines( xmlParser.CurrentBody(),
+                                                       matrixLines,
+                                     "ComplexWeylFermionMassSquaredMatrix" ) );
+        ComplexMassSquaredMatrix fermionMassSquaredMatrix( numberOfRows,
+                                               xmlParser.CurrentAttributes() );
+        for( size_t lineIndex( 0 );
+             lineIndex < matrixLines.size();
+             ++lineIndex )
+        {
+          ParseSumOfPolynomialTerms(
+                        LHPC::ParsingUtilities::TrimWhitespaceFromFrontAndBack(
+                                                    matrixLines[ lineIndex ] ),
+                             fermionMassSquaredMatrix.ElementAt( lineIndex ) );
+        }
+        fermionMassSquaredMatrix.PrepareFillPattern();
+        fermionMassSquaredMatrices.push_back( fermionMassSquaredMatrix );
+      }
+      //   </WeylFermionMassMatrix>
+    }
+    // </LoopCorrections>
+    unparsedLoopCorrections.clear();
+
+    if( readImaginaryPartForRealValue )
+    {
+      std::stringstream warningBuilder;
+      warningBuilder << "At least once in \"" << modelFilename
+      << "\", an imaginary part was read for a polynomial which should be"
+      << " purely real. This imaginary part or these imaginary parts have been"
+      << " ignored, as it may be an artifact of a cancellation which is only"
+      << " apparent when there are values for the Lagrangian parameters (e.g."
+      << " soft SUSY-breaking mass-squared matrices should be Hermitian so the"
+      << " imaginary part of the sum of opposite off-diagonal elements is"
+      << " zero).";
+      WarningLogger::LogWarning( warningBuilder.str() );
+    }
+
+    // Now we can fill the MassesSquaredCalculator* vectors, as their pointers
+    // should remain valid as the other vectors do not change size any more
+    // after this.
+    for( size_t pointerIndex( 0 );
+         pointerIndex < scalarMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      scalarSquareMasses.push_back(
+                                &(scalarMassSquaredMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < fermionMassMatrices.size();
+         ++pointerIndex )
+    {
+      fermionSquareMasses.push_back( &(fermionMassMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < fermionMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      fermionSquareMasses.push_back(
+                               &(fermionMassSquaredMatrices[ pointerIndex ]) );
+    }
+    for( size_t pointerIndex( 0 );
+         pointerIndex < vectorMassSquaredMatrices.size();
+         ++pointerIndex )
+    {
+      vectorSquareMasses.push_back(
+                                &(vectorMassSquaredMatrices[ pointerIndex ]) );
+    }
+  }
+
   // This evaluates the one-loop potential with thermal corrections assuming
   // that the squared masses were evaluated at the given scale correctly.
   double
@@ -13,10 +13,12 @@ namespace VevaciousPlusPlus
   RgeImprovedOneLoopPotential::RgeImprovedOneLoopPotential(
                                               std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                     LagrangianParameterManager& lagrangianParameterManager ) :
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                            bool const deferLoopCorrections ) :
     PotentialFromPolynomialWithMasses( modelFilename,
                                        assumedPositiveOrNegativeTolerance,
-                                       lagrangianParameterManager ),
+                                       lagrangianParameterManager,
+                                       deferLoopCorrections ),
     LHPC::BasicObserver(),
     minimumScaleSquared( -1.0 ),
     maximumScaleSquared( -1.0 )
@@ -48,6 +50,13 @@ namespace VevaciousPlusPlus
                                std::vector< double > const& fieldConfiguration,
                                           double const temperatureValue ) const
   {
+    double cachedValue;
+    if( evaluationCache.LookUp( fieldConfiguration,
+                                temperatureValue,
+                                cachedValue ) )
+    {
+      return cachedValue;
+    }
     double scaleSquared( temperatureValue * temperatureValue );
     for( std::vector< double >::const_iterator
          fieldValue( fieldConfiguration.begin() );
@@ -87,15 +96,94 @@ namespace VevaciousPlusPlus
                                       fieldConfiguration,
                                       vectorSquareMasses,
                                       vectorMassesSquaredWithFactors );
-    return ( treeLevelPotential( parameterValues,
-                                 fieldConfiguration )
-             + polynomialLoopCorrections( parameterValues,
-                                          fieldConfiguration )
-             + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
-                                          fermionMassesSquaredWithFactors,
-                                          vectorMassesSquaredWithFactors,
-                                          ( 1.0 / scaleSquared ),
-                                          temperatureValue ) );
+    double const
+    potentialValue( treeLevelPotential( parameterValues,
+                                        fieldConfiguration )
+                    + polynomialLoopCorrections( parameterValues,
+                                                 fieldConfiguration )
+                    + LoopAndThermalCorrections( scalarMassesSquaredWithFactors,
+                                               fermionMassesSquaredWithFactors,
+                                                vectorMassesSquaredWithFactors,
+                                                 ( 1.0 / scaleSquared ),
+                                                 temperatureValue ) );
+    evaluationCache.Store( fieldConfiguration,
+                           temperatureValue,
+                           potentialValue );
+    return potentialValue;
+  }
+
+  // This places the exact total gradient of the potential at
+  // fieldConfiguration for the temperature temperatureValue in
+  // gradientVector, and returns true unless the Lagrangian parameter manager
+  // could not provide the derivatives of the parameters with respect to the
+  // logarithm of the scale or a mass-squared matrix could not provide the
+  // derivatives of its eigenvalues. Since the renormalization scale Q depends
+  // on the fields through Q^2 = T^2 + |fieldConfiguration|^2, the derivative
+  // of the potential with respect to ln( Q ) at fixed fields is added to each
+  // field derivative multiplied by the derivative of ln( Q ) with respect to
+  // that field, unless Q is held at one of the ends of the range of allowed
+  // scales.
+  bool RgeImprovedOneLoopPotential::SetAsExactGradientAt(
+                                         std::vector< double >& gradientVector,
+                               std::vector< double > const& fieldConfiguration,
+                                          double const temperatureValue ) const
+  {
+    double scaleSquared( temperatureValue * temperatureValue );
+    for( std::vector< double >::const_iterator
+         fieldValue( fieldConfiguration.begin() );
+         fieldValue < fieldConfiguration.end();
+         ++fieldValue )
+    {
+      scaleSquared += ( (*fieldValue) * (*fieldValue) );
+    }
+    bool scaleDependsOnFields( true );
+    if( scaleSquared < minimumScaleSquared )
+    {
+      scaleSquared = minimumScaleSquared;
+      scaleDependsOnFields = false;
+    }
+    else if( scaleSquared > maximumScaleSquared )
+    {
+      scaleSquared = maximumScaleSquared;
+      scaleDependsOnFields = false;
+    }
+
+    std::vector< double > parameterValues;
+    std::vector< double > parameterScaleDerivatives;
+    if( !(lagrangianParameterManager.ParameterValuesAndScaleDerivatives(
+                                                  ( 0.5 * log( scaleSquared ) ),
+                                                               parameterValues,
+                                                 parameterScaleDerivatives )) )
+    {
+      return false;
+    }
+    std::vector< double > extendedGradient;
+    if( !(SetAsRunningScaleGradient( parameterValues,
+                                     parameterScaleDerivatives,
+                                     fieldConfiguration,
+                                     ( 1.0 / scaleSquared ),
+                                     temperatureValue,
+                                     extendedGradient )) )
+    {
+      return false;
+    }
+    size_t const numberOfFields( fieldConfiguration.size() );
+    // The derivative of ln( Q ) with respect to field i is
+    // fieldConfiguration[ i ] / Q^2 while Q is not held fixed.
+    double const scaleTermFactor( scaleDependsOnFields ?
+                                  ( extendedGradient[ numberOfFields ]
+                                    / scaleSquared ) :
+                                  0.0 );
+    gradientVector.resize( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      gradientVector[ fieldIndex ]
+      = ( extendedGradient[ fieldIndex ]
+          + ( scaleTermFactor * fieldConfiguration[ fieldIndex ] ) );
+    }
+    return true;
   }
 
   // This returns a string that is valid Python with no indentation to evaluate
@@ -13,10 +13,12 @@ namespace VevaciousPlusPlus
   TreeLevelPotential::TreeLevelPotential(
                                               std::string const& modelFilename,
                                double const assumedPositiveOrNegativeTolerance,
-                     LagrangianParameterManager& lagrangianParameterManager ) :
+                        LagrangianParameterManager& lagrangianParameterManager,
+                                            bool const deferLoopCorrections ) :
     PotentialFromPolynomialWithMasses( modelFilename,
                                        assumedPositiveOrNegativeTolerance,
-                                       lagrangianParameterManager ),
+                                       lagrangianParameterManager,
+                                       deferLoopCorrections ),
     LHPC::BasicObserver(),
     renormalizationScale( -1.0 ),
     inverseRenormalizationScaleSquared( -1.0 )
@@ -39,6 +41,58 @@ namespace VevaciousPlusPlus
     // This does nothing.
   }
 
+  // This puts the energy density in GeV^4 of the potential for each of the
+  // field configurations in fieldConfigurations into the corresponding
+  // element of potentialValues, at the temperature in GeV given by
+  // temperatureValue. The tree-level polynomial is evaluated for the whole
+  // batch in a single traversal of its terms, and the mass-squared matrices
+  // are only diagonalized if thermal corrections are needed.
+  void TreeLevelPotential::EvaluateBatch(
+              std::vector< std::vector< double > > const& fieldConfigurations,
+                                        std::vector< double >& potentialValues,
+                                          double const temperatureValue ) const
+  {
+    potentialValues.assign( fieldConfigurations.size(),
+                            0.0 );
+    std::vector< std::vector< double > > fieldValuesByIndex;
+    FieldValuesByIndex( fieldConfigurations,
+                        fieldValuesByIndex );
+    treeLevelPotential.AddToBatch( fieldValuesByIndex,
+                                   potentialValues );
+    if( !( temperatureValue > 0.0 ) )
+    {
+      return;
+    }
+
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    scalarMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              scalarSquareMasses,
+                                              scalarMassesSquaredWithFactors );
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    fermionMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              fermionSquareMasses,
+                                             fermionMassesSquaredWithFactors );
+    std::vector< std::vector< DoubleVectorWithDouble > >
+    vectorMassesSquaredWithFactors;
+    AddMassesSquaredWithMultiplicityForBatch( fieldConfigurations,
+                                              vectorSquareMasses,
+                                              vectorMassesSquaredWithFactors );
+    for( size_t configurationIndex( 0 );
+         configurationIndex < fieldConfigurations.size();
+         ++configurationIndex )
+    {
+      potentialValues[ configurationIndex ]
+      += JustThermalCorrections(
+                          scalarMassesSquaredWithFactors[ configurationIndex ],
+                         fermionMassesSquaredWithFactors[ configurationIndex ],
+                          vectorMassesSquaredWithFactors[ configurationIndex ],
+                                            inverseRenormalizationScaleSquared,
+                                                            temperatureValue );
+    }
+  }
+
   void TreeLevelPotential::WriteAsPython(
                                       std::string const& pythonFilename ) const
   {
@@ -65,6 +119,8 @@ namespace VevaciousPlusPlus
   // parameters evaluated at that scale.
   void TreeLevelPotential::RespondToObservedSignal()
   {
+    evaluationCache.Clear();
+    incrementalEvaluation.Clear();
     renormalizationScale
     = lagrangianParameterManager.AppropriateSingleFixedScale();
     inverseRenormalizationScaleSquared
@@ -0,0 +1,464 @@
+/*
+ * FieldSymmetryOrbits.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#include "PotentialMinimization/FieldSymmetryOrbits.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  FieldSymmetryOrbits::FieldSymmetryOrbits(
+                  ParametersAndFieldsProductSum const& polynomialApproximation,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                                    PotentialFunction const& potentialFunction,
+                                          double const verificationTolerance ) :
+    polynomialApproximation( polynomialApproximation ),
+    lagrangianParameterManager( lagrangianParameterManager ),
+    potentialFunction( potentialFunction ),
+    numberOfFields( potentialFunction.NumberOfFieldVariables() ),
+    verificationTolerance( verificationTolerance ),
+    signFlipGenerators(),
+    pivotFields(),
+    exchangeClasses(),
+    referenceConfiguration(),
+    testConfigurations()
+  {
+    // This constructor is just an initialization list.
+  }
+
+  FieldSymmetryOrbits::~FieldSymmetryOrbits()
+  {
+    // This does nothing.
+  }
+
+
+  // This finds the symmetries of the potential for the current parameter
+  // point, replacing any found before. It should be called each time that the
+  // potential has been updated for a new parameter point.
+  void FieldSymmetryOrbits::DetectSymmetries()
+  {
+    signFlipGenerators.clear();
+    pivotFields.clear();
+    exchangeClasses.clear();
+    referenceConfiguration = potentialFunction.DsbFieldValues();
+    if( referenceConfiguration.size() != numberOfFields )
+    {
+      referenceConfiguration.assign( numberOfFields,
+                                     0.0 );
+    }
+
+    // The candidate symmetries are checked against the full potential at the
+    // DSB input and at a few configurations of the same size in field space
+    // which are generic enough not to be invariant under any transformation
+    // by accident. The generator is seeded the same way each time so that the
+    // results are reproducible.
+    testConfigurations.assign( 1,
+                               referenceConfiguration );
+    double testScale( sqrt( VectorUtilities::LengthSquared(
+                                                  referenceConfiguration ) ) );
+    if( !( testScale > 0.0 ) )
+    {
+      testScale = lagrangianParameterManager.AppropriateSingleFixedScale();
+    }
+    std::mt19937 randomGenerator( 1 );
+    std::uniform_real_distribution< double > fieldDistribution( -testScale,
+                                                                testScale );
+    for( size_t testIndex( 0 );
+         testIndex < 3;
+         ++testIndex )
+    {
+      std::vector< double > testConfiguration( numberOfFields );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        testConfiguration[ fieldIndex ] = fieldDistribution( randomGenerator );
+      }
+      testConfigurations.push_back( testConfiguration );
+    }
+
+    std::vector< double > parameterValues;
+    lagrangianParameterManager.ParameterValues(
+               log( lagrangianParameterManager.AppropriateSingleFixedScale() ),
+                                                parameterValues );
+    MonomialMap monomialMap;
+    FillMonomialMap( parameterValues,
+                     monomialMap );
+    FindSignFlips( monomialMap );
+    FindExchanges( monomialMap );
+
+    std::cout
+    << std::endl
+    << "Found " << signFlipGenerators.size()
+    << " independent sign flips of the fields and " << exchangeClasses.size()
+    << " sets of exchangeable fields which leave the potential unchanged.";
+    std::cout << std::endl;
+  }
+
+  // This returns the representative of the orbit of fieldConfiguration under
+  // the detected symmetries, which is the image closest to the DSB input as
+  // described above.
+  std::vector< double > FieldSymmetryOrbits::Canonicalize(
+                        std::vector< double > const& fieldConfiguration ) const
+  {
+    std::vector< double > canonicalConfiguration( fieldConfiguration );
+    size_t const numberOfGenerators( signFlipGenerators.size() );
+    if( numberOfGenerators > maximumEnumeratedGenerators )
+    {
+      AlignSignFlipsWithPivots( canonicalConfiguration );
+      AlignExchangeClasses( canonicalConfiguration );
+      return canonicalConfiguration;
+    }
+
+    // The combinations of the independent sign flips are visited in Gray
+    // code order, so that each step only applies the generator given by the
+    // lowest set bit of the step number to the previous combination.
+    AlignExchangeClasses( canonicalConfiguration );
+    double smallestDistanceSquared( DistanceSquaredFromReference(
+                                                    canonicalConfiguration ) );
+    std::vector< double > flippedConfiguration( fieldConfiguration );
+    size_t const numberOfCombinations( static_cast< size_t >( 1 )
+                                       << numberOfGenerators );
+    for( size_t combinationIndex( 1 );
+         combinationIndex < numberOfCombinations;
+         ++combinationIndex )
+    {
+      size_t generatorIndex( 0 );
+      while( ( ( combinationIndex >> generatorIndex ) & 1 ) == 0 )
+      {
+        ++generatorIndex;
+      }
+      ApplySignFlip( signFlipGenerators[ generatorIndex ],
+                     flippedConfiguration );
+      std::vector< double > candidateConfiguration( flippedConfiguration );
+      AlignExchangeClasses( candidateConfiguration );
+      double const distanceSquared( DistanceSquaredFromReference(
+                                                    candidateConfiguration ) );
+      if( ( distanceSquared < smallestDistanceSquared )
+          ||
+          ( ( distanceSquared == smallestDistanceSquared )
+            &&
+            ( candidateConfiguration < canonicalConfiguration ) ) )
+      {
+        canonicalConfiguration = candidateConfiguration;
+        smallestDistanceSquared = distanceSquared;
+      }
+    }
+    return canonicalConfiguration;
+  }
+
+  // This applies each independent sign flip for which the sign of its pivot
+  // field (or, if that is zero, the first non-zero field which it flips)
+  // differs from the sign in referenceConfiguration.
+  void FieldSymmetryOrbits::AlignSignFlipsWithPivots(
+                              std::vector< double >& fieldConfiguration ) const
+  {
+    for( size_t generatorIndex( 0 );
+         generatorIndex < signFlipGenerators.size();
+         ++generatorIndex )
+    {
+      std::vector< bool > const&
+      signFlip( signFlipGenerators[ generatorIndex ] );
+      size_t decidingField( pivotFields[ generatorIndex ] );
+      if( fieldConfiguration[ decidingField ] == 0.0 )
+      {
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          if( signFlip[ fieldIndex ]
+              &&
+              ( fieldConfiguration[ fieldIndex ] != 0.0 ) )
+          {
+            decidingField = fieldIndex;
+            break;
+          }
+        }
+      }
+      if( ( fieldConfiguration[ decidingField ] < 0.0 )
+          !=
+          ( referenceConfiguration[ decidingField ] < 0.0 ) )
+      {
+        ApplySignFlip( signFlip,
+                       fieldConfiguration );
+      }
+    }
+  }
+
+  // This places the values of each set of exchangeable fields in the same
+  // order as the values of those fields in referenceConfiguration. The values
+  // are sorted and then assigned to the fields in the order of their values
+  // in referenceConfiguration, which puts them as close as possible to it.
+  void FieldSymmetryOrbits::AlignExchangeClasses(
+                              std::vector< double >& fieldConfiguration ) const
+  {
+    for( std::vector< std::vector< size_t > >::const_iterator
+         exchangeClass( exchangeClasses.begin() );
+         exchangeClass < exchangeClasses.end();
+         ++exchangeClass )
+    {
+      std::vector< double > classValues;
+      std::vector< std::pair< double, size_t > > referenceOrder;
+      for( std::vector< size_t >::const_iterator
+           fieldIndex( exchangeClass->begin() );
+           fieldIndex < exchangeClass->end();
+           ++fieldIndex )
+      {
+        classValues.push_back( fieldConfiguration[ *fieldIndex ] );
+        referenceOrder.push_back( std::make_pair(
+                                       referenceConfiguration[ *fieldIndex ],
+                                                  *fieldIndex ) );
+      }
+      std::sort( classValues.begin(),
+                 classValues.end() );
+      std::sort( referenceOrder.begin(),
+                 referenceOrder.end() );
+      for( size_t orderIndex( 0 );
+           orderIndex < referenceOrder.size();
+           ++orderIndex )
+      {
+        fieldConfiguration[ referenceOrder[ orderIndex ].second ]
+        = classValues[ orderIndex ];
+      }
+    }
+  }
+
+  // This puts the monomials of polynomialApproximation with the Lagrangian
+  // parameters given by parameterValues into monomialMap, dropping any whose
+  // contributions cancel.
+  void FieldSymmetryOrbits::FillMonomialMap(
+                                  std::vector< double > const& parameterValues,
+                                            MonomialMap& monomialMap ) const
+  {
+    std::vector< ParametersAndFieldsProductTerm > const&
+    polynomialTerms( polynomialApproximation.ParametersAndFieldsProducts() );
+    for( std::vector< ParametersAndFieldsProductTerm >::const_iterator
+         polynomialTerm( polynomialTerms.begin() );
+         polynomialTerm < polynomialTerms.end();
+         ++polynomialTerm )
+    {
+      std::vector< unsigned int > fieldPowers(
+                                         polynomialTerm->FieldPowersByIndex() );
+      fieldPowers.resize( numberOfFields,
+                          0 );
+      double const
+      termCoefficient( polynomialTerm->CoefficientFactor( parameterValues ) );
+      std::pair< double, double >& monomialCoefficient( monomialMap[
+                                                              fieldPowers ] );
+      monomialCoefficient.first += termCoefficient;
+      monomialCoefficient.second += fabs( termCoefficient );
+    }
+    MonomialMap::iterator monomialEntry( monomialMap.begin() );
+    while( monomialEntry != monomialMap.end() )
+    {
+      if( !( fabs( monomialEntry->second.first )
+             > ( 1.0e-12 * monomialEntry->second.second ) ) )
+      {
+        monomialMap.erase( monomialEntry++ );
+      }
+      else
+      {
+        ++monomialEntry;
+      }
+    }
+  }
+
+  // This finds a basis of the sign flips which leave every monomial in
+  // monomialMap unchanged, by Gaussian elimination modulo 2, and keeps those
+  // which also leave the full potential unchanged in signFlipGenerators.
+  void FieldSymmetryOrbits::FindSignFlips( MonomialMap const& monomialMap )
+  {
+    // Each row is the parity of the powers of the fields in a monomial. A
+    // set of fields can be flipped in sign if it has an even overlap with
+    // every row, so the flips are the null space of the matrix of rows.
+    std::vector< std::vector< bool > > parityRows;
+    for( MonomialMap::const_iterator monomialEntry( monomialMap.begin() );
+         monomialEntry != monomialMap.end();
+         ++monomialEntry )
+    {
+      std::vector< bool > parityRow( numberOfFields );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        parityRow[ fieldIndex ]
+        = ( ( monomialEntry->first[ fieldIndex ] % 2 ) == 1 );
+      }
+      parityRows.push_back( parityRow );
+    }
+
+    std::vector< size_t > rowPivotFields;
+    std::vector< bool > isRowPivot( numberOfFields,
+                                    false );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      size_t const reducedRows( rowPivotFields.size() );
+      size_t pivotRow( reducedRows );
+      while( ( pivotRow < parityRows.size() )
+             &&
+             !(parityRows[ pivotRow ][ fieldIndex ]) )
+      {
+        ++pivotRow;
+      }
+      if( pivotRow == parityRows.size() )
+      {
+        continue;
+      }
+      std::swap( parityRows[ pivotRow ],
+                 parityRows[ reducedRows ] );
+      for( size_t rowIndex( 0 );
+           rowIndex < parityRows.size();
+           ++rowIndex )
+      {
+        if( ( rowIndex != reducedRows )
+            &&
+            parityRows[ rowIndex ][ fieldIndex ] )
+        {
+          for( size_t columnIndex( fieldIndex );
+               columnIndex < numberOfFields;
+               ++columnIndex )
+          {
+            parityRows[ rowIndex ][ columnIndex ]
+            = ( parityRows[ rowIndex ][ columnIndex ]
+                != parityRows[ reducedRows ][ columnIndex ] );
+          }
+        }
+      }
+      rowPivotFields.push_back( fieldIndex );
+      isRowPivot[ fieldIndex ] = true;
+    }
+
+    // Each field which is not the pivot of a reduced row gives a basis
+    // vector of the null space which flips it and no other such field, along
+    // with the pivot fields of the rows which have that field.
+    for( size_t freeField( 0 );
+         freeField < numberOfFields;
+         ++freeField )
+    {
+      if( isRowPivot[ freeField ] )
+      {
+        continue;
+      }
+      std::vector< bool > signFlip( numberOfFields,
+                                    false );
+      signFlip[ freeField ] = true;
+      for( size_t rowIndex( 0 );
+           rowIndex < rowPivotFields.size();
+           ++rowIndex )
+      {
+        if( parityRows[ rowIndex ][ freeField ] )
+        {
+          signFlip[ rowPivotFields[ rowIndex ] ] = true;
+        }
+      }
+      if( PotentialIsInvariantUnder( SignFlipTransformation( signFlip ) ) )
+      {
+        signFlipGenerators.push_back( signFlip );
+        pivotFields.push_back( freeField );
+      }
+    }
+  }
+
+  // This finds the pairs of fields which can be exchanged without changing
+  // the coefficient of any monomial in monomialMap or the full potential, and
+  // groups them into exchangeClasses.
+  void FieldSymmetryOrbits::FindExchanges( MonomialMap const& monomialMap )
+  {
+    // Each field starts in its own class, labeled by its lowest field index,
+    // and classes are merged whenever a field of one can be exchanged with a
+    // field of the other, since the exchanges then generate all permutations
+    // of the merged class.
+    std::vector< size_t > classLabels( numberOfFields );
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      classLabels[ fieldIndex ] = fieldIndex;
+    }
+    for( size_t firstField( 0 );
+         firstField < numberOfFields;
+         ++firstField )
+    {
+      for( size_t secondField( firstField + 1 );
+           secondField < numberOfFields;
+           ++secondField )
+      {
+        if( ( classLabels[ firstField ] == classLabels[ secondField ] )
+            ||
+            !(MonomialsAreExchangeSymmetric( monomialMap,
+                                             firstField,
+                                             secondField ))
+            ||
+            !(PotentialIsInvariantUnder( ExchangeTransformation( firstField,
+                                                            secondField ) )) )
+        {
+          continue;
+        }
+        size_t const mergedLabel( classLabels[ secondField ] );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          if( classLabels[ fieldIndex ] == mergedLabel )
+          {
+            classLabels[ fieldIndex ] = classLabels[ firstField ];
+          }
+        }
+      }
+    }
+    for( size_t classLabel( 0 );
+         classLabel < numberOfFields;
+         ++classLabel )
+    {
+      std::vector< size_t > exchangeClass;
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        if( classLabels[ fieldIndex ] == classLabel )
+        {
+          exchangeClass.push_back( fieldIndex );
+        }
+      }
+      if( exchangeClass.size() > 1 )
+      {
+        exchangeClasses.push_back( exchangeClass );
+      }
+    }
+  }
+
+  // This returns true if the powers of the fields with indices firstField and
+  // secondField can be swapped in every monomial in monomialMap without
+  // changing its coefficient.
+  bool FieldSymmetryOrbits::MonomialsAreExchangeSymmetric(
+                                                MonomialMap const& monomialMap,
+                                                      size_t const firstField,
+                                                     size_t const secondField )
+  {
+    for( MonomialMap::const_iterator monomialEntry( monomialMap.begin() );
+         monomialEntry != monomialMap.end();
+         ++monomialEntry )
+    {
+      std::vector< unsigned int > swappedPowers( monomialEntry->first );
+      std::swap( swappedPowers[ firstField ],
+                 swappedPowers[ secondField ] );
+      MonomialMap::const_iterator
+      swappedEntry( monomialMap.find( swappedPowers ) );
+      if( ( swappedEntry == monomialMap.end() )
+          ||
+          ( fabs( swappedEntry->second.first - monomialEntry->second.first )
+            > ( 1.0e-9 * ( swappedEntry->second.second
+                           + monomialEntry->second.second ) ) ) )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -23,11 +23,16 @@ namespace VevaciousPlusPlus
             PotentialMinimizer( potentialFunction ),
             startingPointFinder( std::move(startingPointFinder) ),
             gradientMinimizer( std::move(gradientMinimizer) ),
+            screeningPotential(),
+            screeningMinimizer(),
+            screeningDepthWindow( 0.0 ),
+            symmetryOrbits(),
             startingPoints(),
             extremumSeparationThresholdFraction( extremumSeparationThresholdFraction ),
             nonDsbRollingToDsbScalingFactor( nonDsbRollingToDsbScalingFactor ),
             global_Is_Panic(global_Is_Panic),
-            done_homotopy(false)
+            done_homotopy(false),
+            numberOfMinimizationThreads( 1 )
     {
         // This constructor is just an initialization list.
     }
@@ -67,7 +72,6 @@ namespace VevaciousPlusPlus
                                              * extremumSeparationThresholdFraction
                                              * dsbVacuum.LengthSquared() ) + 1.0 );
 
-        double const thresholdSeparation( sqrt( thresholdSeparationSquared ) );
         PotentialMinimum foundMinimum;
 
         bool DsbRolledToOrigin( dsbVacuum.LengthSquared()
@@ -87,104 +91,86 @@ namespace VevaciousPlusPlus
           (*startingPointFinder)( startingPoints );
           done_homotopy = true;
         }
+
+        // If screening is switched on, only the screening minima which pass
+        // the depth window are rolled with the full potential.
+        std::vector< std::vector< double > > screenedPoints;
+        if( screeningMinimizer )
+        {
+            ScreenStartingPoints( minimizationTemperature,
+                                  screenedPoints );
+        }
+        std::vector< std::vector< double > > const&
+        uncanonicalizedPoints( screeningMinimizer ?
+                               screenedPoints :
+                               startingPoints );
+
+        // If canonicalization is switched on, only one starting point from
+        // each orbit of the symmetries of the potential is rolled.
+        std::vector< std::vector< double > > canonicalPoints;
+        if( symmetryOrbits )
+        {
+            symmetryOrbits->DetectSymmetries();
+            CanonicalizeStartingPoints( uncanonicalizedPoints,
+                                        canonicalPoints );
+        }
+        std::vector< std::vector< double > > const&
+        pointsToRoll( symmetryOrbits ?
+                      canonicalPoints :
+                      uncanonicalizedPoints );
+
+        // Only the minima found in this call are compared for equivalence
+        // under the symmetries.
+        size_t const numberOfEarlierMinima( foundMinima.size() );
+
         std::cout
                 << std::endl
                 << "Gradient-based minimization from a set of starting points:";
 
+        // The starting points are rolled as independent tasks, and then the
+        // minima are processed in the order of the starting points.
+        TaskGroup minimizationTasks( numberOfMinimizationThreads );
+        std::vector< std::future< RolledStartingPoint > > rolledPoints;
         for( std::vector< std::vector< double > >::const_iterator
-                realSolution( startingPoints.begin() );
-                realSolution != startingPoints.end(); ++realSolution )
+                realSolution( pointsToRoll.begin() );
+                realSolution != pointsToRoll.end(); ++realSolution )
         {
-            std::cout
-                    << std::endl
-                    << "Starting point: "
-                    << potentialFunction.FieldConfigurationAsMathematica( *realSolution );
-            std::cout << std::endl;
-            foundMinimum = (*gradientMinimizer)( *realSolution );
-
-            // Here I do some checks so that we know minuit is behaving properly
-            // This can be an issue with pathological parameter points or minima that
-            // are too far away from the DSB, for which it makes no sense to calculate
-            // tunneling without RG running anyway
-
-            while(std::isnan(foundMinimum.FunctionValue()) || std::isnan(foundMinimum.FunctionError()) )
-            {
-//                std::stringstream errorBuilder;
-//                errorBuilder << "Problem with Minuit, NaN given in minimum value/error. ";
-//                throw std::runtime_error( errorBuilder.str() );
-
-                std::cout << "Minuit encountered numerical issues. Trying from a scaled starting point. " << std::endl;
-                std::vector< double > scaledPoint( *realSolution );
-                for( std::vector< double >::iterator
-                             scaledField( scaledPoint.begin() );
-                     scaledField < scaledPoint.end();
-                     ++scaledField )
-                {
-                    *scaledField *= 0.8;
-                }
-
-                foundMinimum = (*gradientMinimizer)( scaledPoint );
-
-            }
+            rolledPoints.push_back( minimizationTasks.Submit( std::bind(
+                                &GradientFromStartingPoints::RollStartingPoint,
+                                                                        this,
+                                                   std::cref( *realSolution ),
+                                               thresholdSeparationSquared ) ) );
+        }
+        minimizationTasks.RunAll();
 
-            std::cout
-                    << "Rolled to: "
-                    << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
-            std::cout << std::endl;
-            bool rolledToDsbOrSignFlip( ( foundMinimum.SquareDistanceTo( dsbVacuum )
-                                          < thresholdSeparationSquared )
-                                        ||
-                                        !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
-                                                                          thresholdSeparation ) ) );
-
-            // We check to see if a starting point that was not the DSB minimum
-            // rolled to the DSB minimum: if so, we scale the starting point's fields
-            // by a factor and pass the scaled set of field values to
-            // gradientMinimizer to roll, and then carry on based on this new
-            // minimum. (We discovered in explorations with Vevacious 1 that
-            // it could happen that the basin of attraction of the DSB minimum at
-            // 1-loop level could grow so large that it would encompass tree-level
-            // minima that belong in some sense to other 1-loop minima, which moved
-            // very far away due to loop corrections, so even though their basins of
-            // attraction also grew very large in the same way that of the DSB
-            // minimum did, they moved enough that their tree-level minima were left
-            // out.)
-            if( rolledToDsbOrSignFlip
-                &&
-                ( dsbVacuum.SquareDistanceTo( *realSolution )
-                  > thresholdSeparationSquared ) )
+        for( std::vector< std::future< RolledStartingPoint > >::iterator
+                rolledPoint( rolledPoints.begin() );
+                rolledPoint != rolledPoints.end(); ++rolledPoint )
+        {
+            RolledStartingPoint const rolledStartingPoint( rolledPoint->get() );
+            std::cout << rolledStartingPoint.progressReport;
+            foundMinimum = rolledStartingPoint.foundMinimum;
+            bool const
+            rolledToDsbOrSignFlip( rolledStartingPoint.rolledToDsbOrSignFlip );
+
+            // Minima which are images of a minimum which has already been
+            // found under the symmetries of the potential are not recorded
+            // again, and the image closest to the DSB input is used for the
+            // others.
+            if( symmetryOrbits )
             {
-                // We don't want to bother re-rolling the field origin, so we keep note
-                // of how far away from the field origin realSolution is.
-                double lengthSquared( 0.0 );
-                std::vector< double > scaledPoint( *realSolution );
-                for( std::vector< double >::iterator
-                             scaledField( scaledPoint.begin() );
-                     scaledField < scaledPoint.end();
-                     ++scaledField )
-                {
-                    lengthSquared += ( (*scaledField) * (*scaledField) );
-                    *scaledField *= nonDsbRollingToDsbScalingFactor;
-                }
-                if( lengthSquared > thresholdSeparationSquared )
+                foundMinimum.MoveTo( symmetryOrbits->Canonicalize(
+                                            foundMinimum.FieldConfiguration() ),
+                                     foundMinimum.FunctionValue(),
+                                     true );
+                if( AlreadyFound( foundMinimum,
+                                  numberOfEarlierMinima ) )
                 {
                     std::cout
-                            << "Non-DSB-minimum starting point rolled to the DSB minimum, or a"
-                            << " phase rotation, using the full potential. Trying a scaled"
-                            << " starting point: "
-                            << potentialFunction.FieldConfigurationAsMathematica( scaledPoint );
-                    std::cout << std::endl;
-
-                    foundMinimum = (*gradientMinimizer)( scaledPoint );
-                    rolledToDsbOrSignFlip = ( foundMinimum.SquareDistanceTo( dsbVacuum )
-                                              < thresholdSeparationSquared )
-                                            ||
-                                            !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
-                                                                              thresholdSeparation ) );
-                    std::cout
-                            << "Rolled to: "
-                            << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
-                    std::cout << std::endl;
+                            << "This minimum is equivalent under the symmetries"
+                            << " of the potential to a minimum already found."
+                            << std::endl;
+                    continue;
                 }
             }
 
@@ -267,6 +253,275 @@ namespace VevaciousPlusPlus
     }
 
 
+    // This rolls startingPoint with gradientMinimizer, retrying from scaled
+    // starting points as described in FindMinima, and returns the minimum
+    // along with whether it is the DSB vacuum or a phase rotation of it. The
+    // progress messages are collected in the returned report rather than
+    // printed, so that rolls running concurrently do not interleave their
+    // output.
+    GradientFromStartingPoints::RolledStartingPoint
+    GradientFromStartingPoints::RollStartingPoint(
+            std::vector< double > const& startingPoint,
+            double const thresholdSeparationSquared ) const
+    {
+        double const thresholdSeparation( sqrt( thresholdSeparationSquared ) );
+        std::stringstream progressStream;
+        PotentialMinimum foundMinimum;
+        progressStream
+                << std::endl
+                << "Starting point: "
+                << potentialFunction.FieldConfigurationAsMathematica( startingPoint );
+        progressStream << std::endl;
+        foundMinimum = (*gradientMinimizer)( startingPoint );
+
+        // Here I do some checks so that we know minuit is behaving properly
+        // This can be an issue with pathological parameter points or minima that
+        // are too far away from the DSB, for which it makes no sense to calculate
+        // tunneling without RG running anyway
+
+        while(std::isnan(foundMinimum.FunctionValue()) || std::isnan(foundMinimum.FunctionError()) )
+        {
+//                std::stringstream errorBuilder;
+//                errorBuilder << "Problem with Minuit, NaN given in minimum value/error. ";
+//                throw std::runtime_error( errorBuilder.str() );
+
+            progressStream << "Minuit encountered numerical issues. Trying from a scaled starting point. " << std::endl;
+            std::vector< double > scaledPoint( startingPoint );
+            for( std::vector< double >::iterator
+                         scaledField( scaledPoint.begin() );
+                 scaledField < scaledPoint.end();
+                 ++scaledField )
+            {
+                *scaledField *= 0.8;
+            }
+
+            foundMinimum = (*gradientMinimizer)( scaledPoint );
+
+        }
+
+        progressStream
+                << "Rolled to: "
+                << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
+        progressStream << std::endl;
+        bool rolledToDsbOrSignFlip( ( foundMinimum.SquareDistanceTo( dsbVacuum )
+                                      < thresholdSeparationSquared )
+                                    ||
+                                    !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
+                                                                      thresholdSeparation ) ) );
+
+        // We check to see if a starting point that was not the DSB minimum
+        // rolled to the DSB minimum: if so, we scale the starting point's fields
+        // by a factor and pass the scaled set of field values to
+        // gradientMinimizer to roll, and then carry on based on this new
+        // minimum. (We discovered in explorations with Vevacious 1 that
+        // it could happen that the basin of attraction of the DSB minimum at
+        // 1-loop level could grow so large that it would encompass tree-level
+        // minima that belong in some sense to other 1-loop minima, which moved
+        // very far away due to loop corrections, so even though their basins of
+        // attraction also grew very large in the same way that of the DSB
+        // minimum did, they moved enough that their tree-level minima were left
+        // out.)
+        if( rolledToDsbOrSignFlip
+            &&
+            ( dsbVacuum.SquareDistanceTo( startingPoint )
+              > thresholdSeparationSquared ) )
+        {
+            // We don't want to bother re-rolling the field origin, so we keep note
+            // of how far away from the field origin startingPoint is.
+            double lengthSquared( 0.0 );
+            std::vector< double > scaledPoint( startingPoint );
+            for( std::vector< double >::iterator
+                         scaledField( scaledPoint.begin() );
+                 scaledField < scaledPoint.end();
+                 ++scaledField )
+            {
+                lengthSquared += ( (*scaledField) * (*scaledField) );
+                *scaledField *= nonDsbRollingToDsbScalingFactor;
+            }
+            if( lengthSquared > thresholdSeparationSquared )
+            {
+                progressStream
+                        << "Non-DSB-minimum starting point rolled to the DSB minimum, or a"
+                        << " phase rotation, using the full potential. Trying a scaled"
+                        << " starting point: "
+                        << potentialFunction.FieldConfigurationAsMathematica( scaledPoint );
+                progressStream << std::endl;
+
+                foundMinimum = (*gradientMinimizer)( scaledPoint );
+                rolledToDsbOrSignFlip = ( foundMinimum.SquareDistanceTo( dsbVacuum )
+                                          < thresholdSeparationSquared )
+                                        ||
+                                        !( IsNotPhaseRotationOfDsbVacuum( foundMinimum,
+                                                                          thresholdSeparation ) );
+                progressStream
+                        << "Rolled to: "
+                        << foundMinimum.AsMathematica( potentialFunction.FieldNames() );
+                progressStream << std::endl;
+            }
+        }
+
+        RolledStartingPoint rolledStartingPoint;
+        rolledStartingPoint.foundMinimum = foundMinimum;
+        rolledStartingPoint.rolledToDsbOrSignFlip = rolledToDsbOrSignFlip;
+        rolledStartingPoint.progressReport = progressStream.str();
+        return rolledStartingPoint;
+    }
+
+
+    // This rolls each of startingPoints with screeningMinimizer at the
+    // temperature minimizationTemperature and puts the configurations of the
+    // screening minima which pass the depth window, as described for
+    // SetScreening, into screenedPoints.
+    void GradientFromStartingPoints::ScreenStartingPoints(
+            double const minimizationTemperature,
+            std::vector< std::vector< double > >& screenedPoints ) const
+    {
+        screeningMinimizer->SetTemperature( minimizationTemperature );
+        PotentialMinimum const
+        screeningDsb( (*screeningMinimizer)( potentialFunction.DsbFieldValues() ) );
+        double const depthThreshold( screeningDsb.FunctionValue()
+                                     + ( screeningDepthWindow
+                                         * fabs( screeningDsb.FunctionValue() ) ) );
+        std::vector< PotentialMinimum > keptMinima( 1,
+                                                    screeningDsb );
+        double const thresholdSeparationFactor(
+                                         extremumSeparationThresholdFraction
+                                         * extremumSeparationThresholdFraction );
+        // The screening minimizations are independent tasks, and then the
+        // screening minima are compared in the order of the starting points.
+        TaskGroup screeningTasks( numberOfMinimizationThreads );
+        std::vector< std::future< PotentialMinimum > > screeningMinima;
+        for( std::vector< std::vector< double > >::const_iterator
+                startingPoint( startingPoints.begin() );
+                startingPoint != startingPoints.end(); ++startingPoint )
+        {
+            screeningMinima.push_back( screeningTasks.Submit( std::bind(
+                                                &GradientMinimizer::operator(),
+                                                     screeningMinimizer.get(),
+                                              std::cref( *startingPoint ) ) ) );
+        }
+        screeningTasks.RunAll();
+        std::vector< std::future< PotentialMinimum > >::iterator
+        screeningFuture( screeningMinima.begin() );
+        for( std::vector< std::vector< double > >::const_iterator
+                startingPoint( startingPoints.begin() );
+                startingPoint != startingPoints.end();
+                ++startingPoint, ++screeningFuture )
+        {
+            PotentialMinimum const screeningMinimum( screeningFuture->get() );
+
+            // If the screening minimization failed, the starting point cannot
+            // be screened out, so it is kept as it is.
+            if( std::isnan( screeningMinimum.FunctionValue() ) )
+            {
+                screenedPoints.push_back( *startingPoint );
+                continue;
+            }
+            if( screeningMinimum.FunctionValue() > depthThreshold )
+            {
+                continue;
+            }
+            bool alreadyKept( false );
+            for( std::vector< PotentialMinimum >::const_iterator
+                    keptMinimum( keptMinima.begin() );
+                    ( keptMinimum != keptMinima.end() ) && !alreadyKept;
+                    ++keptMinimum )
+            {
+                alreadyKept = ( screeningMinimum.SquareDistanceTo( *keptMinimum )
+                                < ( ( thresholdSeparationFactor
+                                      * keptMinimum->LengthSquared() ) + 1.0 ) );
+            }
+            if( !alreadyKept )
+            {
+                keptMinima.push_back( screeningMinimum );
+                screenedPoints.push_back( screeningMinimum.FieldConfiguration() );
+            }
+        }
+        std::cout
+                << std::endl
+                << "Screening kept " << screenedPoints.size() << " of "
+                << startingPoints.size() << " starting points for minimization"
+                << " of the full potential.";
+        if( screenedPoints.empty() )
+        {
+            std::cout
+                    << " The DSB vacuum is clearly stable at the screening level,"
+                    << " so the full potential is only minimized from the DSB"
+                    << " input.";
+        }
+        std::cout << std::endl;
+    }
+
+
+    // This puts the representatives under symmetryOrbits of the orbits of
+    // pointsToCanonicalize into canonicalPoints, leaving out any which are
+    // within the extremum separation threshold of a representative already
+    // there.
+    void GradientFromStartingPoints::CanonicalizeStartingPoints(
+            std::vector< std::vector< double > > const& pointsToCanonicalize,
+            std::vector< std::vector< double > >& canonicalPoints ) const
+    {
+        double const thresholdSeparationFactor(
+                                         extremumSeparationThresholdFraction
+                                         * extremumSeparationThresholdFraction );
+        for( std::vector< std::vector< double > >::const_iterator
+                startingPoint( pointsToCanonicalize.begin() );
+                startingPoint != pointsToCanonicalize.end(); ++startingPoint )
+        {
+            PotentialMinimum const
+            canonicalPoint( symmetryOrbits->Canonicalize( *startingPoint ),
+                            0.0 );
+            bool alreadyKept( false );
+            for( std::vector< std::vector< double > >::const_iterator
+                    keptPoint( canonicalPoints.begin() );
+                    ( keptPoint != canonicalPoints.end() ) && !alreadyKept;
+                    ++keptPoint )
+            {
+                alreadyKept = ( canonicalPoint.SquareDistanceTo( *keptPoint )
+                                < ( ( thresholdSeparationFactor
+                                      * VectorUtilities::LengthSquared(
+                                                          *keptPoint ) )
+                                    + 1.0 ) );
+            }
+            if( !alreadyKept )
+            {
+                canonicalPoints.push_back(
+                                         canonicalPoint.FieldConfiguration() );
+            }
+        }
+        std::cout
+                << std::endl
+                << "Canonicalization under the symmetries of the potential"
+                << " kept " << canonicalPoints.size() << " of "
+                << pointsToCanonicalize.size() << " starting points.";
+        std::cout << std::endl;
+    }
+
+    // This returns true if a minimum in foundMinima from the index
+    // firstComparisonIndex onwards is within the extremum separation threshold
+    // of comparisonMinimum.
+    bool GradientFromStartingPoints::AlreadyFound(
+            PotentialMinimum const& comparisonMinimum,
+            size_t const firstComparisonIndex ) const
+    {
+        double const thresholdSeparationFactor(
+                                         extremumSeparationThresholdFraction
+                                         * extremumSeparationThresholdFraction );
+        for( std::vector< PotentialMinimum >::const_iterator
+                foundMinimum( foundMinima.begin() + firstComparisonIndex );
+                foundMinimum != foundMinima.end(); ++foundMinimum )
+        {
+            if( comparisonMinimum.SquareDistanceTo( *foundMinimum )
+                < ( ( thresholdSeparationFactor
+                      * foundMinimum->LengthSquared() ) + 1.0 ) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
     // This sets whether the nearest minimum is the one chosen for tunneling
     // or if the global minimum is chosen instead. 
 
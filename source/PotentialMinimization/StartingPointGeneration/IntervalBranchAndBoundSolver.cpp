@@ -0,0 +1,285 @@
+/*
+ * IntervalBranchAndBoundSolver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#include "PotentialMinimization/StartingPointGeneration/IntervalBranchAndBoundSolver.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  IntervalBranchAndBoundSolver::IntervalBranchAndBoundSolver(
+                     ParametersAndFieldsProductSum const& polynomialToMinimize,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                                   std::vector< double > const& dsbFieldValues,
+                                                   size_t const numberOfFields,
+                                                       double const fieldRange,
+                                               double const resolutionFraction,
+                                             size_t const maximumNumberOfBoxes,
+                                          bool const stopOnceDsbIsUnstable ) :
+    StartingPointFinder(),
+    polynomialToMinimize( polynomialToMinimize ),
+    lagrangianParameterManager( lagrangianParameterManager ),
+    dsbFieldValues( dsbFieldValues ),
+    numberOfFields( numberOfFields ),
+    fieldRange( fieldRange ),
+    resolutionFraction( resolutionFraction ),
+    maximumNumberOfBoxes( maximumNumberOfBoxes ),
+    stopOnceDsbIsUnstable( stopOnceDsbIsUnstable )
+  {
+    if( !( resolutionFraction > 0.0 ) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder
+      << "IntervalBranchAndBoundSolver needs a positive resolution fraction,"
+      << " not " << resolutionFraction << "!";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+  }
+
+  IntervalBranchAndBoundSolver::~IntervalBranchAndBoundSolver()
+  {
+    // This does nothing.
+  }
+
+
+  // This searches the box where each field lies between -fieldRange and
+  // +fieldRange (or the maximum evaluation scale of lagrangianParameterManager
+  // if fieldRange is not positive) for the global minimum of
+  // polynomialToMinimize with the Lagrangian parameters evaluated at
+  // lagrangianParameterManager.AppropriateSingleFixedScale(), and puts the best
+  // point found and the centers of the smallest boxes which could still
+  // contain the global minimum into startingPoints. If stopOnceDsbIsUnstable
+  // is true, the search stops as soon as a point which is deeper than the DSB
+  // field configuration and not just a small shift of it is found, since then
+  // the DSB vacuum is already known to be unstable at this level of
+  // approximation.
+  void IntervalBranchAndBoundSolver::operator()(
+                   std::vector< std::vector< double > >& startingPoints ) const
+  {
+    std::vector< double > parameterValues;
+    lagrangianParameterManager.ParameterValues(
+               log( lagrangianParameterManager.AppropriateSingleFixedScale() ),
+                                                parameterValues );
+    double const halfWidth( ( fieldRange > 0.0 ) ?
+                            fieldRange :
+                      lagrangianParameterManager.MaximumEvaluationScale() );
+    double const resolutionWidth( 2.0 * resolutionFraction * halfWidth );
+
+    std::vector< double > bestConfiguration( numberOfFields,
+                                             0.0 );
+    double bestValue( UpperBoundAt( parameterValues,
+                                    bestConfiguration ) );
+    bool const checkDsb( stopOnceDsbIsUnstable
+                         &&
+                         ( dsbFieldValues.size() == numberOfFields ) );
+    double dsbValue( bestValue );
+    if( checkDsb )
+    {
+      dsbValue = UpperBoundAt( parameterValues,
+                               dsbFieldValues );
+      if( dsbValue < bestValue )
+      {
+        bestValue = dsbValue;
+        bestConfiguration = dsbFieldValues;
+      }
+    }
+    // A point only counts as deeper than the DSB configuration if it is
+    // deeper by more than the resolution fraction of the depth of the DSB
+    // configuration, as the tree-level minimum near the DSB configuration can
+    // be slightly shifted from it.
+    double const dsbDepthMargin( resolutionFraction * fabs( dsbValue ) );
+
+    std::priority_queue< BoundedBox > boxQueue;
+    BoundedBox initialBox( std::vector< double >( numberOfFields,
+                                                  -halfWidth ),
+                           std::vector< double >( numberOfFields,
+                                                  halfWidth ) );
+    BoundBoxAndTryCenter( parameterValues,
+                          initialBox,
+                          bestValue,
+                          bestConfiguration );
+    boxQueue.push( initialBox );
+    std::vector< BoundedBox > resolvedBoxes;
+    size_t numberOfBoxesExamined( 0 );
+    bool dsbIsUnstable( false );
+    while( !(boxQueue.empty())
+           &&
+           ( numberOfBoxesExamined < maximumNumberOfBoxes )
+           &&
+           !dsbIsUnstable )
+    {
+      // The queue gives the box with the lowest bound first, so if even it
+      // cannot contain a point lower than the best point found so far, none
+      // of the remaining boxes can either.
+      if( boxQueue.top().lowerBound > bestValue )
+      {
+        boxQueue = std::priority_queue< BoundedBox >();
+        break;
+      }
+      BoundedBox const currentBox( boxQueue.top() );
+      boxQueue.pop();
+      ++numberOfBoxesExamined;
+      size_t widestField( 0 );
+      double widestWidth( 0.0 );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        double const fieldWidth( currentBox.upperFieldBounds[ fieldIndex ]
+                                 - currentBox.lowerFieldBounds[ fieldIndex ] );
+        if( fieldWidth > widestWidth )
+        {
+          widestField = fieldIndex;
+          widestWidth = fieldWidth;
+        }
+      }
+      if( widestWidth <= resolutionWidth )
+      {
+        resolvedBoxes.push_back( currentBox );
+        continue;
+      }
+      double const bisectionValue( currentBox.lowerFieldBounds[ widestField ]
+                                   + ( 0.5 * widestWidth ) );
+      BoundedBox lowerHalf( currentBox );
+      lowerHalf.upperFieldBounds[ widestField ] = bisectionValue;
+      BoundedBox upperHalf( currentBox );
+      upperHalf.lowerFieldBounds[ widestField ] = bisectionValue;
+      BoundBoxAndTryCenter( parameterValues,
+                            lowerHalf,
+                            bestValue,
+                            bestConfiguration );
+      BoundBoxAndTryCenter( parameterValues,
+                            upperHalf,
+                            bestValue,
+                            bestConfiguration );
+      if( lowerHalf.lowerBound <= bestValue )
+      {
+        boxQueue.push( lowerHalf );
+      }
+      if( upperHalf.lowerBound <= bestValue )
+      {
+        boxQueue.push( upperHalf );
+      }
+      dsbIsUnstable = ( checkDsb
+                        &&
+                        ( bestValue < ( dsbValue - dsbDepthMargin ) )
+                        &&
+                        !(VectorUtilities::DifferenceIsWithinHypercube(
+                                                             bestConfiguration,
+                                                                dsbFieldValues,
+                                                          resolutionWidth )) );
+    }
+
+    startingPoints.push_back( bestConfiguration );
+    AppendBoxCenters( resolvedBoxes,
+                      bestValue,
+                      startingPoints );
+    if( dsbIsUnstable )
+    {
+      std::cout
+      << std::endl
+      << "IntervalBranchAndBoundSolver found a point deeper than the DSB field"
+      << " configuration after examining " << numberOfBoxesExamined
+      << " boxes, so stopped searching.";
+      std::cout << std::endl;
+      return;
+    }
+    if( !(boxQueue.empty()) )
+    {
+      std::stringstream warningBuilder;
+      warningBuilder
+      << "IntervalBranchAndBoundSolver examined its maximum of "
+      << maximumNumberOfBoxes << " boxes with " << boxQueue.size()
+      << " still unresolved, so the global minimum of the polynomial is not"
+      << " certified. The centers of the unresolved boxes are being used as"
+      << " extra starting points.";
+      WarningLogger::LogWarning( warningBuilder.str() );
+      std::vector< BoundedBox > unresolvedBoxes;
+      while( !(boxQueue.empty()) )
+      {
+        unresolvedBoxes.push_back( boxQueue.top() );
+        boxQueue.pop();
+      }
+      AppendBoxCenters( unresolvedBoxes,
+                        bestValue,
+                        startingPoints );
+    }
+  }
+
+  // This sets the lower bound of boxToBound from the interval bounds of
+  // polynomialToMinimize with the Lagrangian parameters given by
+  // parameterValues, and bounds the polynomial at the center of the box from
+  // above, replacing bestValue and bestConfiguration if the bound there is
+  // lower.
+  void IntervalBranchAndBoundSolver::BoundBoxAndTryCenter(
+                                  std::vector< double > const& parameterValues,
+                                                        BoundedBox& boxToBound,
+                                                             double& bestValue,
+                            std::vector< double >& bestConfiguration ) const
+  {
+    double unusedUpperBound( 0.0 );
+    polynomialToMinimize.IntervalBounds( parameterValues,
+                                         boxToBound.lowerFieldBounds,
+                                         boxToBound.upperFieldBounds,
+                                         boxToBound.lowerBound,
+                                         unusedUpperBound );
+    std::vector< double > const boxCenter( BoxCenter( boxToBound ) );
+    double const centerValue( UpperBoundAt( parameterValues,
+                                            boxCenter ) );
+    if( centerValue < bestValue )
+    {
+      bestValue = centerValue;
+      bestConfiguration = boxCenter;
+    }
+  }
+
+  // This appends the center of each box in candidateBoxes which has a lower
+  // bound no greater than bestValue to startingPoints, unless a point already
+  // in startingPoints lies within the box.
+  void IntervalBranchAndBoundSolver::AppendBoxCenters(
+                               std::vector< BoundedBox > const& candidateBoxes,
+                                                        double const bestValue,
+                         std::vector< std::vector< double > >& startingPoints )
+  {
+    for( std::vector< BoundedBox >::const_iterator
+         candidateBox( candidateBoxes.begin() );
+         candidateBox < candidateBoxes.end();
+         ++candidateBox )
+    {
+      if( candidateBox->lowerBound > bestValue )
+      {
+        continue;
+      }
+      bool alreadyCovered( false );
+      for( std::vector< std::vector< double > >::const_iterator
+           startingPoint( startingPoints.begin() );
+           ( startingPoint < startingPoints.end() ) && !alreadyCovered;
+           ++startingPoint )
+      {
+        alreadyCovered = true;
+        for( size_t fieldIndex( 0 );
+             fieldIndex < startingPoint->size();
+             ++fieldIndex )
+        {
+          if( ( (*startingPoint)[ fieldIndex ]
+                < candidateBox->lowerFieldBounds[ fieldIndex ] )
+              ||
+              ( (*startingPoint)[ fieldIndex ]
+                > candidateBox->upperFieldBounds[ fieldIndex ] ) )
+          {
+            alreadyCovered = false;
+            break;
+          }
+        }
+      }
+      if( !alreadyCovered )
+      {
+        startingPoints.push_back( BoxCenter( *candidateBox ) );
+      }
+    }
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -0,0 +1,205 @@
+/*
+ * QuasiRandomStartingPoints.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#include "PotentialMinimization/StartingPointGeneration/QuasiRandomStartingPoints.hpp"
+
+namespace VevaciousPlusPlus
+{
+
+  QuasiRandomStartingPoints::QuasiRandomStartingPoints(
+                     ParametersAndFieldsProductSum const& polynomialToMinimize,
+                  LagrangianParameterManager const& lagrangianParameterManager,
+                                                   size_t const numberOfFields,
+                                                       double const fieldRange,
+                                                  size_t const numberOfSamples,
+                                                 double const retainedFraction,
+                                                 double const clusteringFactor,
+                                    size_t const maximumNumberOfStartingPoints,
+                                         unsigned int const scramblingSeed ) :
+    StartingPointFinder(),
+    polynomialToMinimize( polynomialToMinimize ),
+    lagrangianParameterManager( lagrangianParameterManager ),
+    numberOfFields( numberOfFields ),
+    fieldRange( fieldRange ),
+    numberOfSamples( numberOfSamples ),
+    retainedFraction( retainedFraction ),
+    clusteringFactor( clusteringFactor ),
+    maximumNumberOfStartingPoints( maximumNumberOfStartingPoints ),
+    haltonBases(),
+    digitPermutations()
+  {
+    if( ( numberOfSamples == 0 )
+        ||
+        !( retainedFraction > 0.0 )
+        ||
+        ( retainedFraction > 1.0 ) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder
+      << "QuasiRandomStartingPoints needs a positive number of samples (not "
+      << numberOfSamples << ") and a retained fraction greater than 0 and no"
+      << " greater than 1 (not " << retainedFraction << ")!";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+
+    // The Halton sequence uses the first prime numbers as the bases for the
+    // dimensions. Each base gets a random permutation of its non-zero digits
+    // (leaving 0 fixed so that the expansions still terminate), which breaks
+    // up the correlations between dimensions with large bases.
+    std::mt19937 randomGenerator( scramblingSeed );
+    unsigned int primeCandidate( 2 );
+    while( haltonBases.size() < numberOfFields )
+    {
+      bool isPrime( true );
+      for( std::vector< unsigned int >::const_iterator
+           smallerPrime( haltonBases.begin() );
+           ( smallerPrime < haltonBases.end() )
+           &&
+           ( ( (*smallerPrime) * (*smallerPrime) ) <= primeCandidate );
+           ++smallerPrime )
+      {
+        if( ( primeCandidate % (*smallerPrime) ) == 0 )
+        {
+          isPrime = false;
+          break;
+        }
+      }
+      if( isPrime )
+      {
+        haltonBases.push_back( primeCandidate );
+        std::vector< unsigned int > digitPermutation( primeCandidate );
+        for( unsigned int digitValue( 0 );
+             digitValue < primeCandidate;
+             ++digitValue )
+        {
+          digitPermutation[ digitValue ] = digitValue;
+        }
+        std::shuffle( ( digitPermutation.begin() + 1 ),
+                      digitPermutation.end(),
+                      randomGenerator );
+        digitPermutations.push_back( digitPermutation );
+      }
+      ++primeCandidate;
+    }
+  }
+
+  QuasiRandomStartingPoints::~QuasiRandomStartingPoints()
+  {
+    // This does nothing.
+  }
+
+
+  // This samples polynomialToMinimize with the Lagrangian parameters
+  // evaluated at lagrangianParameterManager.AppropriateSingleFixedScale() at
+  // the points of the scrambled Halton sequence in the box where each field
+  // lies between -fieldRange and +fieldRange (or the maximum evaluation scale
+  // of lagrangianParameterManager if fieldRange is not positive), and puts
+  // the lowest sample of each cluster into startingPoints, up to
+  // maximumNumberOfStartingPoints of them, lowest first.
+  void QuasiRandomStartingPoints::operator()(
+                   std::vector< std::vector< double > >& startingPoints ) const
+  {
+    std::vector< double > parameterValues;
+    lagrangianParameterManager.ParameterValues(
+               log( lagrangianParameterManager.AppropriateSingleFixedScale() ),
+                                                parameterValues );
+    double const halfWidth( ( fieldRange > 0.0 ) ?
+                            fieldRange :
+                      lagrangianParameterManager.MaximumEvaluationScale() );
+
+    // The samples are the points of the sequence scaled to the box where each
+    // field lies between -halfWidth and +halfWidth, with the field origin
+    // taken as the first sample.
+    std::vector< std::pair< double, std::vector< double > > >
+    valuedSamples( numberOfSamples,
+                   std::make_pair( 0.0,
+                                   std::vector< double >( numberOfFields,
+                                                          0.0 ) ) );
+    for( size_t sampleIndex( 0 );
+         sampleIndex < numberOfSamples;
+         ++sampleIndex )
+    {
+      std::vector< double >& fieldConfiguration( valuedSamples[ sampleIndex
+                                                               ].second );
+      for( size_t fieldIndex( 0 );
+           fieldIndex < numberOfFields;
+           ++fieldIndex )
+      {
+        fieldConfiguration[ fieldIndex ]
+        = ( halfWidth * ( ( 2.0 * ScrambledRadicalInverse( sampleIndex,
+                                                           fieldIndex ) )
+                          - 1.0 ) );
+      }
+      if( sampleIndex == 0 )
+      {
+        fieldConfiguration.assign( numberOfFields,
+                                   0.0 );
+      }
+      valuedSamples[ sampleIndex ].first
+      = polynomialToMinimize( parameterValues,
+                              fieldConfiguration );
+    }
+
+    // Only the lowest fraction of the samples are considered for clustering,
+    // lowest first.
+    size_t const numberOfRetainedSamples( std::max( size_t( 1 ),
+                                  static_cast< size_t >( ceil( retainedFraction
+                                                      * numberOfSamples ) ) ) );
+    std::partial_sort( valuedSamples.begin(),
+                       ( valuedSamples.begin() + numberOfRetainedSamples ),
+                       valuedSamples.end() );
+
+    // The critical distance of multi-level single-linkage clustering shrinks
+    // like ( ln( N ) / N )^(1/n) for N samples in n dimensions, scaled here by
+    // the width of the box and clusteringFactor.
+    double const criticalDistance( clusteringFactor * 2.0 * halfWidth
+                                   * pow( ( log( numberOfSamples + 1.0 )
+                                            / ( numberOfSamples + 1.0 ) ),
+                                          ( 1.0 / numberOfFields ) ) );
+    double const criticalDistanceSquared( criticalDistance
+                                          * criticalDistance );
+    size_t numberOfRepresentatives( 0 );
+    for( size_t retainedIndex( 0 );
+         ( retainedIndex < numberOfRetainedSamples )
+         &&
+         ( numberOfRepresentatives < maximumNumberOfStartingPoints );
+         ++retainedIndex )
+    {
+      std::vector< double > const&
+      candidatePoint( valuedSamples[ retainedIndex ].second );
+      bool hasLowerNeighbor( false );
+      for( size_t lowerIndex( 0 );
+           ( lowerIndex < retainedIndex ) && !hasLowerNeighbor;
+           ++lowerIndex )
+      {
+        std::vector< double > const&
+        lowerPoint( valuedSamples[ lowerIndex ].second );
+        double distanceSquared( 0.0 );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          double const fieldDifference( candidatePoint[ fieldIndex ]
+                                        - lowerPoint[ fieldIndex ] );
+          distanceSquared += ( fieldDifference * fieldDifference );
+        }
+        hasLowerNeighbor = ( distanceSquared < criticalDistanceSquared );
+      }
+      if( !hasLowerNeighbor )
+      {
+        startingPoints.push_back( candidatePoint );
+        ++numberOfRepresentatives;
+      }
+    }
+    std::cout
+    << std::endl
+    << "QuasiRandomStartingPoints kept " << numberOfRepresentatives
+    << " cluster representatives from " << numberOfSamples << " samples.";
+    std::cout << std::endl;
+  }
+
+} /* namespace VevaciousPlusPlus */
@@ -81,7 +81,14 @@ namespace VevaciousPlusPlus
                          survivalProbabilityThreshold ),
     temperatureAccuracy( temperatureAccuracy ),
     vacuumSeparationFractionSquared( vacuumSeparationFraction
-                                     * vacuumSeparationFraction )
+                                     * vacuumSeparationFraction ),
+    cancellationFlag( NULL ),
+    resultIsUnneeded( false ),
+    concurrentThermalTunneler(),
+    numberOfAccuracyRefinements( 0 ),
+    coarsestUncertaintyMargin( 0.0 ),
+    accuracyTimeBudgetInSeconds( 0.0 ),
+    accuracyCoarsening( 0 )
   {
     // This constructor is just an initialization list.
   }
@@ -120,18 +127,50 @@ namespace VevaciousPlusPlus
     thermalSurvivalProbability = -1.0;
     partialThermalDecayWidth = -1.0;
     dominantTemperatureInGigaElectronVolts = -1.0;
+    logOfMinusLogUncertainty = -1.0;
 
     if( tunnelingStrategy == NoTunneling )
     {
-      std::cout
+      ProgressStream()
       << std::endl
       << "Not tunneling as tunneling strategy is \"NoTunneling\"";
-      std::cout << std::endl;
+      ProgressStream() << std::endl;
 
       return;
     }
     PrepareCommonExtras( potentialFunction );
-    if( tunnelingStrategy == JustQuantum )
+    if( numberOfAccuracyRefinements > 0 )
+    {
+      CalculateWithAdaptiveAccuracy( potentialFunction,
+                                     falseVacuum,
+                                     trueVacuum );
+    }
+    else
+    {
+      CalculateForStrategy( potentialFunction,
+                            falseVacuum,
+                            trueVacuum );
+    }
+  }
+
+  // This calls the virtual tunneling calculation functions based on
+  // tunnelingStrategy, with the resolutions given by accuracyCoarsening.
+  void BounceActionTunneler::CalculateForStrategy(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum )
+  {
+    if( ( concurrentThermalTunneler != nullptr )
+        &&
+        ( ( tunnelingStrategy == QuantumThenThermal )
+          ||
+          ( tunnelingStrategy == ThermalThenQuantum ) ) )
+    {
+      CalculateQuantumAndThermalConcurrently( potentialFunction,
+                                              falseVacuum,
+                                              trueVacuum );
+    }
+    else if( tunnelingStrategy == JustQuantum )
     {
       CalculateQuantumTunneling( potentialFunction,
                                  falseVacuum,
@@ -148,7 +187,9 @@ namespace VevaciousPlusPlus
       CalculateQuantumTunneling( potentialFunction,
                                  falseVacuum,
                                  trueVacuum );
-      if( quantumSurvivalProbability > survivalProbabilityThreshold )
+      if( ( quantumSurvivalProbability > survivalProbabilityThreshold )
+          &&
+          !(CalculationIsCancelled()) )
       {
         CalculateThermalTunneling( potentialFunction,
                                    falseVacuum,
@@ -160,7 +201,9 @@ namespace VevaciousPlusPlus
       CalculateThermalTunneling( potentialFunction,
                                  falseVacuum,
                                  trueVacuum );
-      if( thermalSurvivalProbability > survivalProbabilityThreshold )
+      if( ( thermalSurvivalProbability > survivalProbabilityThreshold )
+          &&
+          !(CalculationIsCancelled()) )
       {
         CalculateQuantumTunneling( potentialFunction,
                                    falseVacuum,
@@ -169,11 +212,216 @@ namespace VevaciousPlusPlus
     }
     else
     {
-      std::cout
+      ProgressStream()
       << std::endl
       << "No valid tunneling strategy was set, so treating it as"
       << " \"NoTunneling\"!";
-      std::cout << std::endl;
+      ProgressStream() << std::endl;
+    }
+  }
+
+  // This repeats CalculateForStrategy with accuracyCoarsening going down from
+  // numberOfAccuracyRefinements for as long as the result is within the
+  // uncertainty margin of the threshold and the time budget allows, and then
+  // records the uncertainty margin of the last calculation in
+  // logOfMinusLogUncertainty.
+  void BounceActionTunneler::CalculateWithAdaptiveAccuracy(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum )
+  {
+    double const
+    thresholdLogOfMinusLog( log( -log( survivalProbabilityThreshold ) ) );
+    // Only the actions from the last calculation are kept.
+    size_t const numberOfQuantumActions( thresholdAndActions.size() );
+    size_t const numberOfThermalActions( thermalThresholdAndActions.size() );
+    double uncertaintyMargin( coarsestUncertaintyMargin );
+    std::chrono::steady_clock::time_point const
+    calculationStartTime( std::chrono::steady_clock::now() );
+    accuracyCoarsening = numberOfAccuracyRefinements;
+    while( true )
+    {
+      quantumSurvivalProbability = -1.0;
+      quantumLifetimeInSeconds = -1.0;
+      thermalSurvivalProbability = -1.0;
+      partialThermalDecayWidth = -1.0;
+      dominantTemperatureInGigaElectronVolts = -1.0;
+      thresholdAndActions.resize( numberOfQuantumActions );
+      thermalThresholdAndActions.resize( numberOfThermalActions );
+      ProgressStream()
+      << std::endl
+      << "Calculating tunneling with resolutions reduced by a factor of "
+      << ( 1u << accuracyCoarsening ) << ".";
+      ProgressStream() << std::endl;
+      std::chrono::steady_clock::time_point const
+      passStartTime( std::chrono::steady_clock::now() );
+      CalculateForStrategy( potentialFunction,
+                            falseVacuum,
+                            trueVacuum );
+      std::chrono::steady_clock::time_point const
+      passEndTime( std::chrono::steady_clock::now() );
+      double const secondsSoFar( std::chrono::duration< double >(
+                                 passEndTime - calculationStartTime ).count() );
+      double const secondsForPass( std::chrono::duration< double >(
+                                        passEndTime - passStartTime ).count() );
+      double const distanceFromThreshold( fabs( LogOfMinusLogOfSurvival()
+                                                - thresholdLogOfMinusLog ) );
+      if( ( accuracyCoarsening == 0 )
+          ||
+          ( distanceFromThreshold > uncertaintyMargin )
+          ||
+          CalculationIsCancelled() )
+      {
+        break;
+      }
+      // Doubling the resolutions is assumed to double the time taken.
+      if( ( accuracyTimeBudgetInSeconds > 0.0 )
+          &&
+          ( ( secondsSoFar + ( 2.0 * secondsForPass ) )
+            > accuracyTimeBudgetInSeconds ) )
+      {
+        ProgressStream()
+        << std::endl
+        << "Refining the tunneling calculation would exceed the time budget"
+        << " of " << accuracyTimeBudgetInSeconds << " seconds.";
+        ProgressStream() << std::endl;
+        break;
+      }
+      ProgressStream()
+      << std::endl
+      << "ln(-ln(P)) is within " << uncertaintyMargin << " of its threshold"
+      << " value, so refining the tunneling calculation.";
+      ProgressStream() << std::endl;
+      --accuracyCoarsening;
+      uncertaintyMargin *= 0.5;
+    }
+    logOfMinusLogUncertainty = uncertaintyMargin;
+    ProgressStream()
+    << std::endl
+    << "Tunneling calculated with resolutions reduced by a factor of "
+    << ( 1u << accuracyCoarsening ) << ", estimated uncertainty on ln(-ln(P))"
+    << " is " << logOfMinusLogUncertainty << ".";
+    ProgressStream() << std::endl;
+    accuracyCoarsening = 0;
+  }
+
+  // This calculates quantum tunneling on one thread while
+  // concurrentThermalTunneler calculates thermal tunneling on another, and
+  // then copies the thermal results from concurrentThermalTunneler. As soon as
+  // the calculation which comes first in tunnelingStrategy gives a survival
+  // probability no greater than survivalProbabilityThreshold, the other is
+  // abandoned and its results are left as not calculated, just as if it had
+  // never been started. The progress messages of the thermal calculation are
+  // collected while it runs and then written after those of the quantum
+  // calculation, so that the two do not interleave.
+  void BounceActionTunneler::CalculateQuantumAndThermalConcurrently(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum )
+  {
+    BounceActionTunneler& thermalTunneler( *concurrentThermalTunneler );
+    thermalTunneler.cancellationFlag = cancellationFlag;
+    thermalTunneler.accuracyCoarsening = accuracyCoarsening;
+    thermalTunneler.resultIsUnneeded.store( false );
+    resultIsUnneeded.store( false );
+    std::stringstream thermalProgress;
+    thermalTunneler.SetProgressStream( thermalProgress );
+    // Any exception thrown by either calculation is carried by its future.
+    TaskGroup tunnelingTasks( 2 );
+    std::future< void >
+    quantumCalculation( tunnelingTasks.Submit( std::bind(
+                                    &BounceActionTunneler::QuantumTunnelingTask,
+                                                          this,
+                                               std::cref( potentialFunction ),
+                                                     std::cref( falseVacuum ),
+                                                 std::cref( trueVacuum ) ) ) );
+    std::future< void >
+    thermalCalculation( tunnelingTasks.Submit( std::bind(
+                                    &BounceActionTunneler::ThermalTunnelingTask,
+                                                          this,
+                                               std::cref( potentialFunction ),
+                                                     std::cref( falseVacuum ),
+                                                 std::cref( trueVacuum ) ) ) );
+    tunnelingTasks.RunAll();
+    bool const quantumWasNeeded( !(resultIsUnneeded.load()) );
+    bool const thermalWasNeeded( !(thermalTunneler.resultIsUnneeded.load()) );
+    resultIsUnneeded.store( false );
+    thermalTunneler.cancellationFlag = NULL;
+    thermalTunneler.SetProgressStream( ProgressStream() );
+    ProgressStream() << thermalProgress.str();
+
+    // An error is only reported if the sequential calculation would have
+    // reached it.
+    if( quantumWasNeeded )
+    {
+      quantumCalculation.get();
+    }
+    if( thermalWasNeeded )
+    {
+      thermalCalculation.get();
+    }
+
+    if( !quantumWasNeeded )
+    {
+      quantumSurvivalProbability = -1.0;
+      quantumLifetimeInSeconds = -1.0;
+      logOfMinusLogOfQuantumProbability = -1.0E+100;
+    }
+    if( thermalWasNeeded )
+    {
+      thermalSurvivalProbability = thermalTunneler.thermalSurvivalProbability;
+      logOfMinusLogOfThermalProbability
+      = thermalTunneler.logOfMinusLogOfThermalProbability;
+      dominantTemperatureInGigaElectronVolts
+      = thermalTunneler.dominantTemperatureInGigaElectronVolts;
+      partialThermalDecayWidth = thermalTunneler.partialThermalDecayWidth;
+      thermalThresholdAndActions.insert( thermalThresholdAndActions.end(),
+                           thermalTunneler.thermalThresholdAndActions.begin(),
+                           thermalTunneler.thermalThresholdAndActions.end() );
+    }
+    thermalTunneler.thermalThresholdAndActions.clear();
+  }
+
+  // This calculates quantum tunneling and, if tunnelingStrategy is
+  // QuantumThenThermal and the survival probability is no greater than
+  // survivalProbabilityThreshold, marks the result of
+  // concurrentThermalTunneler as unneeded.
+  void BounceActionTunneler::QuantumTunnelingTask(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum )
+  {
+    CalculateQuantumTunneling( potentialFunction,
+                               falseVacuum,
+                               trueVacuum );
+    if( ( tunnelingStrategy == QuantumThenThermal )
+        &&
+        !( quantumSurvivalProbability > survivalProbabilityThreshold ) )
+    {
+      concurrentThermalTunneler->resultIsUnneeded.store( true );
+    }
+  }
+
+  // This calculates thermal tunneling with concurrentThermalTunneler and, if
+  // tunnelingStrategy is ThermalThenQuantum and the survival probability is
+  // no greater than survivalProbabilityThreshold, marks the quantum result of
+  // this instance as unneeded.
+  void BounceActionTunneler::ThermalTunnelingTask(
+                                    PotentialFunction const& potentialFunction,
+                                           PotentialMinimum const& falseVacuum,
+                                           PotentialMinimum const& trueVacuum )
+  {
+    // The thermal tunneler is given the JustThermal strategy, so this resets
+    // its results and just calculates thermal tunneling.
+    concurrentThermalTunneler->CalculateTunneling( potentialFunction,
+                                                   falseVacuum,
+                                                   trueVacuum );
+    if( ( tunnelingStrategy == ThermalThenQuantum )
+        &&
+        !( concurrentThermalTunneler->thermalSurvivalProbability
+           > survivalProbabilityThreshold ) )
+    {
+      resultIsUnneeded.store( true );
     }
   }
 
@@ -329,8 +577,8 @@ namespace VevaciousPlusPlus
     // we start doubling the temperature, recording the previous temperature
     // each time. If it was above, we start halving the temperature, recording
     // the previous temperature each time.
-    std::cout << "Trying " << temperatureGuess << " GeV.";
-    std::cout << std::endl;
+    ProgressStream() << "Trying " << temperatureGuess << " GeV.";
+    ProgressStream() << std::endl;
 
     while( BelowCriticalTemperature( potentialFunction,
                                      temperatureGuess,
@@ -340,26 +588,28 @@ namespace VevaciousPlusPlus
       if( temperatureGuess >= maximumAllowedTemperature )
       {
         temperatureGuess = maximumAllowedTemperature;
-        std::cout << "... too low. Trying the Planck scale:"
+        ProgressStream() << "... too low. Trying the Planck scale:"
         << temperatureGuess << " GeV.";
-        std::cout << std::endl;
+        ProgressStream() << std::endl;
         if( BelowCriticalTemperature( potentialFunction,
                                       temperatureGuess,
                                       zeroTemperatureVacuum ) )
         {
           rangeOfMaxTemperature.first = maximumAllowedTemperature;
           rangeOfMaxTemperature.second = maximumAllowedTemperature;
-          std::cout << "... too low. Apparently this vacuum persists up to"
+          ProgressStream()
+          << "... too low. Apparently this vacuum persists up to"
           << " the Planck temperature.";
-          std::cout << std::endl;
+          ProgressStream() << std::endl;
           return;
         }
         break;
       }
       else
       {
-        std::cout << "... too low. Trying " << temperatureGuess << " GeV.";
-        std::cout << std::endl;
+        ProgressStream()
+        << "... too low. Trying " << temperatureGuess << " GeV.";
+        ProgressStream() << std::endl;
       }
     }
     // Now temperatureGuess is definitely about the sought temperature, so we
@@ -371,8 +621,9 @@ namespace VevaciousPlusPlus
                                        zeroTemperatureVacuum )) )
     {
       temperatureGuess = ( 0.5 * temperatureGuess );
-      std::cout << "... too high. Trying " << temperatureGuess << " GeV.";
-      std::cout << std::endl;
+      ProgressStream()
+      << "... too high. Trying " << temperatureGuess << " GeV.";
+      ProgressStream() << std::endl;
     }
     // At this point, temperatureGuess should be between 0.5 and 1.0 times the
     // critical temperature.
@@ -380,15 +631,19 @@ namespace VevaciousPlusPlus
     rangeOfMaxTemperature.second = ( temperatureGuess + temperatureGuess );
     // We aim to be within a factor of 2^( -temperatureAccuracy ) of the
     // critical temperature,
-    // hence temperatureAccuracy iterations of this loop.
+    // hence temperatureAccuracy iterations of this loop (fewer if the
+    // accuracy is coarsened).
+    unsigned int const
+    numberOfNarrowingSteps( CoarsenedResolution( temperatureAccuracy,
+                                                 3 ) );
     for( unsigned int narrowingStep( 0 );
-         narrowingStep < temperatureAccuracy;
+         narrowingStep < numberOfNarrowingSteps;
          ++narrowingStep )
     {
       temperatureGuess = sqrt( rangeOfMaxTemperature.first
                                * rangeOfMaxTemperature.second );
-      std::cout << "Trying " << temperatureGuess << " GeV.";
-      std::cout << std::endl;
+      ProgressStream() << "Trying " << temperatureGuess << " GeV.";
+      ProgressStream() << std::endl;
       if( BelowCriticalTemperature( potentialFunction,
                                     temperatureGuess,
                                     zeroTemperatureVacuum ) )
@@ -401,11 +656,11 @@ namespace VevaciousPlusPlus
       }
     }
 
-    std::cout
+    ProgressStream()
     << std::endl
     << "Temperature lies between " << rangeOfMaxTemperature.first
     << " GeV and " << rangeOfMaxTemperature.second << " GeV.";
-    std::cout << std::endl;
+    ProgressStream() << std::endl;
   }
 
   // This ensures that thermalSurvivalProbability is set correctly from
@@ -20,7 +20,8 @@ namespace VevaciousPlusPlus
                                         unsigned int const temperatureAccuracy,
                                     unsigned int const pathPotentialResolution,
                                     unsigned int const pathFindingTimeout,
-                                      double const vacuumSeparationFraction ) :
+                                       double const vacuumSeparationFraction,
+                                            bool const smoothPathPotential ) :
     BounceActionTunneler( tunnelingStrategy,
                           survivalProbabilityThreshold,
                           temperatureAccuracy,
@@ -29,7 +30,8 @@ namespace VevaciousPlusPlus
     actionCalculator( std::move(actionCalculator) ),
     thermalIntegrationResolution( thermalIntegrationResolution ),
     pathPotentialResolution( pathPotentialResolution ),
-    pathFindingTimeout( pathFindingTimeout )
+    pathFindingTimeout( pathFindingTimeout ),
+    smoothPathPotential( smoothPathPotential )
   {
     // This constructor is just an initialization list.
   }
@@ -62,8 +64,11 @@ namespace VevaciousPlusPlus
     // is recorded in partialDecayWidth so that the bounce action threshold for
     // each temperature can be calculated taking into account the contributions
     // from higher temperatures.
+    unsigned int const
+    integrationResolution( CoarsenedResolution( thermalIntegrationResolution,
+                                                1 ) );
     double const temperatureStep( rangeOfMaxTemperatureForOriginToTrue.first
-                 / static_cast< double >( thermalIntegrationResolution + 1 ) );
+                        / static_cast< double >( integrationResolution + 1 ) );
     double currentTemperature( 0.0 );
     MinuitPotentialMinimizer thermalPotentialMinimizer( potentialFunction );
     thermalPotentialMinimizer.SetTemperature( currentTemperature );
@@ -76,7 +81,9 @@ namespace VevaciousPlusPlus
     dominantTemperatureInGigaElectronVolts = 0.0;
 
     for( unsigned int whichStep( 0 );
-         whichStep < thermalIntegrationResolution;
+         ( whichStep < integrationResolution )
+         &&
+         !(CalculationIsCancelled());
          ++whichStep )
     {
       currentTemperature += temperatureStep;
@@ -210,13 +217,17 @@ namespace VevaciousPlusPlus
                                   falseVacuum,
                                   trueVacuum,
                                   tunnelingTemperature );
+    // Bounce actions which are clearly far from the threshold may only be
+    // calculated roughly, with bounds which are then used for the comparisons
+    // with the threshold.
+    actionCalculator->SetActionThreshold( actionThreshold );
 
-    SplinePotential pathPotential( potentialFunction,
-                                   *bestPath,
-                                   pathPotentialResolution,
-                                   requiredVacuumSeparationSquared );
+    std::unique_ptr<SplinePotential>
+    pathPotential( CreatePathPotential( potentialFunction,
+                                        *bestPath,
+                                        requiredVacuumSeparationSquared ) );
 
-    if( !(pathPotential.EnergyBarrierWasResolved()) )
+    if( !(pathPotential->EnergyBarrierWasResolved()) )
     {
       std::stringstream warningBuilder;
       warningBuilder << "Unable to resolve an energy barrier between false"
@@ -227,15 +238,15 @@ namespace VevaciousPlusPlus
     }
 
     BubbleProfile const* bestBubble( (*actionCalculator)( *bestPath,
-                                                          pathPotential ) );
+                                                          *pathPotential ) );
 
 
-    std::cout << std::endl
+    ProgressStream() << std::endl
     << "Initial path bounce action = " << bestBubble->BounceAction();
 
     if( bestPath->NonZeroTemperature() )
     {
-      std::cout << " GeV";
+      ProgressStream() << " GeV";
 
       thermalThresholdAndActions.push_back(actionThreshold);
       thermalThresholdAndActions.push_back(bestBubble->BounceAction());
@@ -246,23 +257,23 @@ namespace VevaciousPlusPlus
       thresholdAndActions.push_back(bestBubble->BounceAction());
     }
 
-    std::cout << ", threshold is " << actionThreshold;
+    ProgressStream() << ", threshold is " << actionThreshold;
     if( bestPath->NonZeroTemperature() )
     {
-      std::cout << " GeV";
+      ProgressStream() << " GeV";
     }
-    std::cout << ".";
-    std::cout << std::endl;
+    ProgressStream() << ".";
+    ProgressStream() << std::endl;
 
     // Checking if initial path already has a very low action
 
-    if( bestBubble->BounceAction() < actionThreshold )
+    if( bestBubble->BounceActionUpperBound() < actionThreshold )
     {
-      std::cout
+      ProgressStream()
               << std::endl
               << "Bounce action dropped below threshold, breaking off from looking"
               << " for further path improvements.";
-      std::cout << std::endl;
+      ProgressStream() << std::endl;
       double const bounceAction( bestBubble->BounceAction() );
       delete bestBubble;
       delete bestPath;
@@ -275,8 +286,14 @@ namespace VevaciousPlusPlus
     // Setting the starting time of the path finding
     time( &pathFindingStartTime );
 
+    // Coarser calculations only use the first path finders, as the later
+    // ones are generally refinements of the paths of the earlier ones.
+    auto const endOfPathFinders( pathFinders.begin()
+                                 + CoarsenedResolution(
+                           static_cast< unsigned int >( pathFinders.size() ),
+                                                        1 ) );
     for( auto pathFinder( pathFinders.begin() );
-         pathFinder < pathFinders.end();
+         pathFinder < endOfPathFinders;
          ++pathFinder )
     {
       time(&currentTime);
@@ -289,9 +306,21 @@ namespace VevaciousPlusPlus
           break;
       };
 
-      std::cout << std::endl
+      // If the calculation has been abandoned, the best action so far is
+      // returned as an upper bound without trying any further path finders.
+      if( CalculationIsCancelled() )
+      {
+        ProgressStream() << std::endl
+        << "Tunneling calculation was cancelled, breaking off from looking"
+        << " for further path improvements.";
+        ProgressStream() << std::endl;
+
+        break;
+      }
+
+      ProgressStream() << std::endl
       << "Passing best path so far to next path finder.";
-      std::cout << std::endl;
+      ProgressStream() << std::endl;
 
       (*pathFinder)->SetPotentialAndVacuaAndTemperature( potentialFunction,
                                                          falseVacuum,
@@ -342,13 +371,13 @@ namespace VevaciousPlusPlus
         nextPath( (*pathFinder)->TryToImprovePath( *currentPath,
                                                    *currentBubble ) );
 
-        SplinePotential potentialApproximation( potentialFunction,
-                                                *nextPath,
-                                                pathPotentialResolution,
-                                             requiredVacuumSeparationSquared );
+        std::unique_ptr<SplinePotential>
+        potentialApproximation( CreatePathPotential( potentialFunction,
+                                                     *nextPath,
+                                            requiredVacuumSeparationSquared ) );
 
         BubbleProfile const* nextBubble( (*actionCalculator)( *nextPath,
-                                                    potentialApproximation ) );
+                                                   *potentialApproximation ) );
 
         // On the first iteration of the loop, these pointers are NULL, so
         // it's no problem to delete them. On subsequent iterations, they point
@@ -381,26 +410,28 @@ namespace VevaciousPlusPlus
         currentBubble = nextBubble;
         currentPath = nextPath;
 
-        std::cout << std::endl
+        ProgressStream() << std::endl
         << "bounce action for new path = " << currentBubble->BounceAction();
         if( currentPath->NonZeroTemperature() )
         {
-          std::cout << " GeV";
+          ProgressStream() << " GeV";
         }
-        std::cout << ", lowest bounce action so far = "
+        ProgressStream() << ", lowest bounce action so far = "
         << bestBubble->BounceAction();
         if( currentPath->NonZeroTemperature() )
         {
-          std::cout << " GeV";
+          ProgressStream() << " GeV";
         }
-        std::cout << ", threshold is " << actionThreshold;
+        ProgressStream() << ", threshold is " << actionThreshold;
         if( currentPath->NonZeroTemperature() )
         {
-          std::cout << " GeV";
+          ProgressStream() << " GeV";
         }
-        std::cout << ".";
-        std::cout << std::endl;
-      } while( ( bestBubble->BounceAction() > actionThreshold )
+        ProgressStream() << ".";
+        ProgressStream() << std::endl;
+      } while( ( bestBubble->BounceActionLowerBound() > actionThreshold )
+               &&
+               !(CalculationIsCancelled())
                &&
                (*pathFinder)->PathCanBeImproved( *currentBubble ) );
       // At the end of the loop, these point at the last tried path and bubble
@@ -421,32 +452,39 @@ namespace VevaciousPlusPlus
 
       // We don't bother with the rest of the path finders if the action has
       // already dropped below the threshold.
-      if( bestBubble->BounceAction() < actionThreshold )
+      if( bestBubble->BounceActionUpperBound() < actionThreshold )
       {
-        std::cout
+        ProgressStream()
         << std::endl
         << "Bounce action dropped below threshold, breaking off from looking"
         << " for further path improvements.";
-        std::cout << std::endl;
+        ProgressStream() << std::endl;
 
         break;
       }
     }
 
-    std::cout << std::endl
+    ProgressStream() << std::endl
     << "Lowest path bounce action at " << tunnelingTemperature << " GeV was "
     << bestBubble->BounceAction();
     if( bestPath->NonZeroTemperature() )
     {
-      std::cout << " GeV";
+      ProgressStream() << " GeV";
+    }
+    if( bestBubble->BounceActionUpperBound()
+        > bestBubble->BounceActionLowerBound() )
+    {
+      ProgressStream() << " (only calculated roughly, as between "
+      << bestBubble->BounceActionLowerBound() << " and "
+      << bestBubble->BounceActionUpperBound() << ")";
     }
-    std::cout << ", threshold is " << actionThreshold;
+    ProgressStream() << ", threshold is " << actionThreshold;
     if( bestPath->NonZeroTemperature() )
     {
-      std::cout << " GeV";
+      ProgressStream() << " GeV";
     }
-    std::cout << ".";
-    std::cout << std::endl;
+    ProgressStream() << ".";
+    ProgressStream() << std::endl;
 
     double const bounceAction( bestBubble->BounceAction() );
     delete bestBubble;
@@ -24,6 +24,12 @@ namespace VevaciousPlusPlus
                                           ).GetLagrangianParameterManager()) ),
     potentialMinimizer( &potentialMinimizer ),
     tunnelingCalculator( &tunnelingCalculator ),
+    tunnelingCalculatorInitializationFilename( "" ),
+    tunnelToEveryPanicVacuum( false ),
+    numberOfTunnelingThreads( 0 ),
+    panicVacuumCalculators(),
+    panicVacuumResults( NULL ),
+    tunnelingPanicVacuum(),
     warningMessagesFromConstructor(),
     resultsFromLastRunAsXml( "<!-- No results yet. -->" ),
     warningMessagesFromLastRun()
@@ -38,7 +44,12 @@ namespace VevaciousPlusPlus
   // creating new instances of components.
   VevaciousPlusPlus::VevaciousPlusPlus(
                                   std::string const& initializationFileName ) :
-
+    tunnelingCalculatorInitializationFilename( "error" ),
+    tunnelToEveryPanicVacuum( false ),
+    numberOfTunnelingThreads( 0 ),
+    panicVacuumCalculators(),
+    panicVacuumResults( NULL ),
+    tunnelingPanicVacuum(),
     warningMessagesFromConstructor(),
     resultsFromLastRunAsXml( "<!-- No results yet. -->" ),
     warningMessagesFromLastRun()
@@ -46,7 +57,6 @@ namespace VevaciousPlusPlus
     WarningLogger::SetWarningRecord( &warningMessagesFromConstructor );
     std::string potentialFunctionInitializationFilename( "error" );
     std::string potentialMinimizerInitializationFilename( "error" );
-    std::string tunnelingCalculatorInitializationFilename( "error" );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.OpenRootElementOfFile( initializationFileName );
     while( xmlParser.ReadNextElement() )
@@ -68,6 +78,12 @@ namespace VevaciousPlusPlus
         tunnelingCalculatorInitializationFilename
         = xmlParser.TrimmedCurrentBody();
       }
+      InterpretElementIfNameMatches( xmlParser,
+                                     "TunnelToEveryPanicVacuum",
+                                     tunnelToEveryPanicVacuum );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfTunnelingThreads",
+                                     numberOfTunnelingThreads );
     }
     FullPotentialDescription
     fullPotentialDescription(std::move( CreateFullPotentialDescription(
@@ -76,7 +92,8 @@ namespace VevaciousPlusPlus
     ownedPotentialFunction = std::move(fullPotentialDescription.second);
     potentialMinimizer =  std::move(CreatePotentialMinimizer( *ownedPotentialFunction,
                                 potentialMinimizerInitializationFilename ));
-    tunnelingCalculator = std::move(CreateTunnelingCalculator( tunnelingCalculatorInitializationFilename ));
+    // The TunnelingCalculator is only created by GetTunnelingCalculator once
+    // it is first needed.
     WarningLogger::SetWarningRecord( NULL );
   }
   VevaciousPlusPlus::~VevaciousPlusPlus()
@@ -139,6 +156,15 @@ namespace VevaciousPlusPlus
 
   //  }
 
+  // This sets the parameter point given by newInput, as RunPoint does, but
+  // without finding the minima or calculating tunneling, so that the potential
+  // can then be evaluated for that point through GetPotentialFunction.
+  void VevaciousPlusPlus::NewParameterPoint( std::string const& newInput )
+  {
+    PrepareLoopCorrections();
+    lagrangianParameterManager->NewParameterPoint( newInput );
+  }
+
   // This returns a pair of vectors where the first vector are the field values for the global
   // minimum and the second are the field values for the nearest minimum to the DSB. 
 
@@ -166,6 +192,7 @@ namespace VevaciousPlusPlus
    void VevaciousPlusPlus::RunPoint( std::string const& newInput )
   {
     warningMessagesFromLastRun.clear();
+    panicVacuumResults = NULL;
     WarningLogger::SetWarningRecord( &warningMessagesFromLastRun );
     time_t runStartTime;
     time_t runEndTime;
@@ -179,6 +206,7 @@ namespace VevaciousPlusPlus
     std::cout << std::endl;
 
     time( &stageStartTime );
+    PrepareLoopCorrections();
     lagrangianParameterManager->NewParameterPoint( newInput );
 
     // Here we check whether Vevacious is being used as a library
@@ -206,10 +234,16 @@ namespace VevaciousPlusPlus
     if( potentialMinimizer->DsbVacuumIsMetastable() )
     {
       time( &stageStartTime );
-      tunnelingCalculator->CalculateTunneling(
+      if( !( tunnelToEveryPanicVacuum
+             &&
+             CalculateTunnelingToEveryPanicVacuum() ) )
+      {
+        tunnelingPanicVacuum = potentialMinimizer->PanicVacuum();
+        GetTunnelingCalculator().CalculateTunneling(
                                     potentialMinimizer->GetPotentialFunction(),
                                                potentialMinimizer->DsbVacuum(),
-                                           potentialMinimizer->PanicVacuum() );
+                                                        tunnelingPanicVacuum );
+      }
       time( &stageEndTime );
       std::cout << std::endl
       << "Tunneling calculation took " << difftime( stageEndTime,
@@ -219,6 +253,16 @@ namespace VevaciousPlusPlus
       std::cout << std::endl;
     }
 
+    if( potentialMinimizer->GetPotentialFunction(
+                                           ).EvaluationCache().IsEnabled() )
+    {
+      std::cout
+      << potentialMinimizer->GetPotentialFunction(
+                                       ).EvaluationCache().StatisticsAsString()
+      << std::endl;
+      std::cout << std::endl;
+    }
+
     WarningLogger::SetWarningRecord( NULL );
     PrepareResultsAsXml();
     std::cout
@@ -251,6 +295,7 @@ namespace VevaciousPlusPlus
     std::cout << std::endl;
 
     time( &stageStartTime );
+    PrepareLoopCorrections();
     lagrangianParameterManager->NewParameterPoint( newInput );
 
     // Here we check whether Vevacious is being used as a library
@@ -328,54 +373,55 @@ namespace VevaciousPlusPlus
     }
     outputFile << "BLOCK VEVACIOUSZEROTEMPERATURE # Results at T = 0\n"
     "# [index] [verdict float]\n";
-    if( tunnelingCalculator->QuantumSurvivalProbability() >= 0.0 )
+    TunnelingCalculator& tunnelingResults( TunnelingResults() );
+    if( tunnelingResults.QuantumSurvivalProbability() >= 0.0 )
     {
       outputFile <<  "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->QuantumSurvivalProbability() )
+                            tunnelingResults.QuantumSurvivalProbability() )
       << "  # Probability of DSB vacuum surviving 4.3E17 seconds\n";
       outputFile << "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                              tunnelingCalculator->QuantumLifetimeInSeconds() )
+                              tunnelingResults.QuantumLifetimeInSeconds() )
       << "  # Tunneling time out of DSB vacuum in seconds\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfQuantumProbability() )
+                     tunnelingResults.LogOfMinusLogOfQuantumProbability() )
       << "  # L = ln(-ln(P)), => P = e^(-e^L)\n";
     }
     else
     {
       outputFile << "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-          tunnelingCalculator->QuantumSurvivalProbability() )
+          tunnelingResults.QuantumSurvivalProbability() )
       << "  # Not calculated: ignore this number\n"
       "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                              tunnelingCalculator->QuantumLifetimeInSeconds() )
+                              tunnelingResults.QuantumLifetimeInSeconds() )
       << "  # Not calculated: ignore this number\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfQuantumProbability() )
+                     tunnelingResults.LogOfMinusLogOfQuantumProbability() )
       << "  # Not calculated: ignore this number\n";
     }
     outputFile << "BLOCK VEVACIOUSNONZEROTEMPERATURE # Results at T != 0\n"
     "# [index] [verdict float]\n";
-    if( tunnelingCalculator->ThermalSurvivalProbability() >= 0.0 )
+    if( tunnelingResults.ThermalSurvivalProbability() >= 0.0 )
     {
       outputFile <<  "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->ThermalSurvivalProbability() )
+                            tunnelingResults.ThermalSurvivalProbability() )
       << "  # Probability of DSB vacuum surviving thermal tunneling\n";
       outputFile << "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                tunnelingCalculator->DominantTemperatureInGigaElectronVolts() )
+                tunnelingResults.DominantTemperatureInGigaElectronVolts() )
       << "  # Dominant tunneling temperature in GeV\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfThermalProbability() )
+                     tunnelingResults.LogOfMinusLogOfThermalProbability() )
       << "  # L = ln(-ln(P)), => P = e^(-e^L)\n";
     }
     else
     {
       outputFile << "  1  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                            tunnelingCalculator->ThermalSurvivalProbability() )
+                            tunnelingResults.ThermalSurvivalProbability() )
       << "  # Not calculated: ignore this number\n"
       "  2  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                 tunnelingCalculator->DominantTemperatureInGigaElectronVolts() )
+                 tunnelingResults.DominantTemperatureInGigaElectronVolts() )
       << "  # Not calculated: ignore this number\n"
       "  3  " << LHPC::ParsingUtilities::FormatNumberForSlha(
-                     tunnelingCalculator->LogOfMinusLogOfThermalProbability() )
+                     tunnelingResults.LogOfMinusLogOfThermalProbability() )
       << "  # Not calculated: ignore this number\n";
     }
     outputFile
@@ -416,7 +462,7 @@ namespace VevaciousPlusPlus
     panicFields( &(potentialMinimizer->DsbVacuum().FieldConfiguration()) );
     if( potentialMinimizer->DsbVacuumIsMetastable() )
     {
-      panicFields = &(potentialMinimizer->PanicVacuum().FieldConfiguration());
+      panicFields = &(tunnelingPanicVacuum.FieldConfiguration());
     }
     for( size_t fieldIndex( 0 );
          fieldIndex < fieldNames.size();
@@ -540,6 +586,8 @@ namespace VevaciousPlusPlus
     xmlParser.LoadString( constructorArguments );
     std::string modelFilename( "error" );
     double assumedPositiveOrNegativeTolerance( 1.0 );
+    unsigned int evaluationCacheSize( 0 );
+    bool incrementalEvaluation( false );
     while( xmlParser.ReadNextElement() )
     {
       InterpretElementIfNameMatches( xmlParser,
@@ -548,24 +596,39 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "AssumedPositiveOrNegativeTolerance",
                                      assumedPositiveOrNegativeTolerance );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "EvaluationCacheSize",
+                                     evaluationCacheSize );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "IncrementalEvaluation",
+                                     incrementalEvaluation );
     }
+    // The mass-squared matrices are only parsed by PrepareLoopCorrections
+    // just before the first parameter point is read.
+    std::unique_ptr<PotentialFromPolynomialWithMasses> createdPotential;
     if( classChoice == "FixedScaleOneLoopPotential" )
     {
-      return Utils::make_unique<FixedScaleOneLoopPotential>( modelFilename,
+      createdPotential
+      = Utils::make_unique<FixedScaleOneLoopPotential>( modelFilename,
                                             assumedPositiveOrNegativeTolerance,
-                                             lagrangianParameterManager );
+                                                    lagrangianParameterManager,
+                                                                        true );
     }
     else if( classChoice == "RgeImprovedOneLoopPotential" )
     {
-      return Utils::make_unique<RgeImprovedOneLoopPotential> ( modelFilename,
+      createdPotential
+      = Utils::make_unique<RgeImprovedOneLoopPotential>( modelFilename,
                                             assumedPositiveOrNegativeTolerance,
-                                              lagrangianParameterManager );
+                                                    lagrangianParameterManager,
+                                                                        true );
     }
     else if( classChoice == "TreeLevelPotential" )
     {
-      return Utils::make_unique<TreeLevelPotential> ( modelFilename,
+      createdPotential
+      = Utils::make_unique<TreeLevelPotential>( modelFilename,
                                             assumedPositiveOrNegativeTolerance,
-                                              lagrangianParameterManager );
+                                                    lagrangianParameterManager,
+                                                                        true );
     }
     else
     {
@@ -576,6 +639,13 @@ namespace VevaciousPlusPlus
       << " \"RgeImprovedOneLoopPotential\".";
       throw std::runtime_error( errorStream.str() );
     }
+    // An evaluation cache size of 0 (the default) leaves the cache disabled.
+    createdPotential->SetEvaluationCacheSize( evaluationCacheSize );
+    // Only FixedScaleOneLoopPotential and TreeLevelPotential use incremental
+    // evaluation, as the scale of RgeImprovedOneLoopPotential depends on the
+    // fields.
+    createdPotential->SetIncrementalEvaluation( incrementalEvaluation );
+    return createdPotential;
   }
 
   // This creates a new GradientFromStartingPoints based on the given
@@ -594,10 +664,17 @@ namespace VevaciousPlusPlus
     double extremumSeparationThresholdFraction( 0.05 );
     double nonDsbRollingToDsbScalingFactor( 4.0 );
     bool global_Is_Panic = false;
+    bool treeLevelScreening( false );
+    double treeLevelScreeningDepthWindow( 0.5 );
+    bool symmetryCanonicalization( false );
+    double symmetryVerificationTolerance( 1.0e-6 );
+    unsigned int numberOfMinimizationThreads( 1 );
     // The <ConstructorArguments> for this class should have child elements
     // <StartingPointFinderClass> and <GradientMinimizerClass>, and
-    // optionally <ExtremumSeparationThresholdFraction> and
-    // <NonDsbRollingToDsbScalingFactor>.
+    // optionally <ExtremumSeparationThresholdFraction>,
+    // <NonDsbRollingToDsbScalingFactor>, <TreeLevelScreening>,
+    // <TreeLevelScreeningDepthWindow>, <SymmetryCanonicalization>,
+    // <SymmetryVerificationTolerance>, and <NumberOfMinimizationThreads>.
     while( xmlParser.ReadNextElement() )
     {
       ReadClassAndArguments( xmlParser,
@@ -617,6 +694,21 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "GlobalIsPanic",
                                      global_Is_Panic );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "TreeLevelScreening",
+                                     treeLevelScreening );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "TreeLevelScreeningDepthWindow",
+                                     treeLevelScreeningDepthWindow );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "SymmetryCanonicalization",
+                                     symmetryCanonicalization );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "SymmetryVerificationTolerance",
+                                     symmetryVerificationTolerance );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfMinimizationThreads",
+                                     numberOfMinimizationThreads );
     }
     std::unique_ptr<StartingPointFinder>
     startingPointFinder(std::move( CreateStartingPointFinder( potentialFunction,
@@ -626,11 +718,43 @@ namespace VevaciousPlusPlus
     gradientMinimizer(std::move( CreateGradientMinimizer( potentialFunction,
                                                 gradientMinimizerClass,
                                                 gradientMinimizerArguments ) ));
-    return Utils::make_unique<GradientFromStartingPoints>( potentialFunction,
-                                           std::move(startingPointFinder),
-                                           std::move(gradientMinimizer),
+    std::unique_ptr<GradientFromStartingPoints>
+    gradientFromStartingPoints( Utils::make_unique<GradientFromStartingPoints>(
+                                                             potentialFunction,
+                                                std::move(startingPointFinder),
+                                                  std::move(gradientMinimizer),
                                            extremumSeparationThresholdFraction,
-                                           nonDsbRollingToDsbScalingFactor, global_Is_Panic );
+                                               nonDsbRollingToDsbScalingFactor,
+                                                           global_Is_Panic ) );
+    gradientFromStartingPoints->SetNumberOfMinimizationThreads(
+                                                 numberOfMinimizationThreads );
+    // Screening with the tree-level potential would be pointless if the
+    // potential is already just the tree-level potential.
+    if( treeLevelScreening
+        &&
+        ( dynamic_cast< TreeLevelPotential* >( &potentialFunction ) == NULL ) )
+    {
+      std::unique_ptr<TreeLevelPotential>
+      treeLevelPotential( Utils::make_unique<TreeLevelPotential>(
+                                                         potentialFunction ) );
+      std::unique_ptr<GradientMinimizer>
+      screeningMinimizer( CreateGradientMinimizer( *treeLevelPotential,
+                                                   gradientMinimizerClass,
+                                                gradientMinimizerArguments ) );
+      gradientFromStartingPoints->SetScreening( std::move(treeLevelPotential),
+                                                std::move(screeningMinimizer),
+                                               treeLevelScreeningDepthWindow );
+    }
+    if( symmetryCanonicalization )
+    {
+      gradientFromStartingPoints->SetSymmetryOrbits(
+                                     Utils::make_unique<FieldSymmetryOrbits>(
+                                   potentialFunction.PolynomialApproximation(),
+                             potentialFunction.GetLagrangianParameterManager(),
+                                                             potentialFunction,
+                                             symmetryVerificationTolerance ) );
+    }
+    return gradientFromStartingPoints;
   }
 
   // This creates a new PolynomialAtFixedScalesSolver based on the given
@@ -672,6 +796,93 @@ namespace VevaciousPlusPlus
                                   potentialFunction.NumberOfFieldVariables() );
   }
 
+  // This creates a new IntervalBranchAndBoundSolver based on the given
+  // arguments and returns a pointer to it.
+  std::unique_ptr<IntervalBranchAndBoundSolver>
+  VevaciousPlusPlus::CreateIntervalBranchAndBoundSolver(
+                    PotentialFromPolynomialWithMasses const& potentialFunction,
+                                      std::string const& constructorArguments )
+  {
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.LoadString( constructorArguments );
+    double fieldRange( -1.0 );
+    double resolutionFraction( 0.01 );
+    unsigned int maximumNumberOfBoxes( 100000 );
+    bool stopOnceDsbIsUnstable( true );
+    while( xmlParser.ReadNextElement() )
+    {
+      InterpretElementIfNameMatches( xmlParser,
+                                     "FieldRange",
+                                     fieldRange );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ResolutionFraction",
+                                     resolutionFraction );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MaximumNumberOfBoxes",
+                                     maximumNumberOfBoxes );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "StopOnceDsbIsUnstable",
+                                     stopOnceDsbIsUnstable );
+    }
+    return Utils::make_unique<IntervalBranchAndBoundSolver>(
+                                   potentialFunction.PolynomialApproximation(),
+                             potentialFunction.GetLagrangianParameterManager(),
+                                            potentialFunction.DsbFieldValues(),
+                                    potentialFunction.NumberOfFieldVariables(),
+                                                     fieldRange,
+                                                     resolutionFraction,
+                                                     maximumNumberOfBoxes,
+                                                     stopOnceDsbIsUnstable );
+  }
+
+  // This creates a new QuasiRandomStartingPoints based on the given arguments
+  // and returns a pointer to it.
+  std::unique_ptr<QuasiRandomStartingPoints>
+  VevaciousPlusPlus::CreateQuasiRandomStartingPoints(
+                    PotentialFromPolynomialWithMasses const& potentialFunction,
+                                      std::string const& constructorArguments )
+  {
+    LHPC::RestrictedXmlParser xmlParser;
+    xmlParser.LoadString( constructorArguments );
+    double fieldRange( -1.0 );
+    unsigned int numberOfSamples( 1000 );
+    double retainedFraction( 0.1 );
+    double clusteringFactor( 2.0 );
+    unsigned int maximumNumberOfStartingPoints( 50 );
+    unsigned int scramblingSeed( 1 );
+    while( xmlParser.ReadNextElement() )
+    {
+      InterpretElementIfNameMatches( xmlParser,
+                                     "FieldRange",
+                                     fieldRange );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NumberOfSamples",
+                                     numberOfSamples );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "RetainedFraction",
+                                     retainedFraction );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ClusteringFactor",
+                                     clusteringFactor );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "MaximumNumberOfStartingPoints",
+                                     maximumNumberOfStartingPoints );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ScramblingSeed",
+                                     scramblingSeed );
+    }
+    return Utils::make_unique<QuasiRandomStartingPoints>(
+                                   potentialFunction.PolynomialApproximation(),
+                             potentialFunction.GetLagrangianParameterManager(),
+                                    potentialFunction.NumberOfFieldVariables(),
+                                                  fieldRange,
+                                                  numberOfSamples,
+                                                  retainedFraction,
+                                                  clusteringFactor,
+                                                 maximumNumberOfStartingPoints,
+                                                  scramblingSeed );
+  }
+
   // This puts the content of the current element of xmlParser into
   // contentDestination, interpreted as a bool represented by
   // case-insensitive "yes/no" or "y/n" or "true/false" or "t/f" or "0/1",
@@ -722,6 +933,7 @@ namespace VevaciousPlusPlus
     double errorFraction( 0.1 );
     double errorMinimum( 1.0 );
     unsigned int minuitStrategy( 1 );
+    unsigned int newtonRefinementSteps( 0 );
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
     while( xmlParser.ReadNextElement() )
@@ -735,11 +947,15 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "MinuitStrategy",
                                      minuitStrategy );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "NewtonRefinementSteps",
+                                     newtonRefinementSteps );
     }
     return Utils::make_unique<MinuitPotentialMinimizer>( potentialFunction,
                                          errorFraction,
                                          errorMinimum,
-                                         minuitStrategy );
+                                         minuitStrategy,
+                                         newtonRefinementSteps );
   }
 
   // This creates a new CosmoTransitionsRunner based on the given arguments
@@ -858,6 +1074,11 @@ namespace VevaciousPlusPlus
     unsigned int resolutionOfPathPotential( 100 );
     unsigned int pathFindingTimeout( 10000000 );
     double vacuumSeparationFraction( 0.2 );
+    bool smoothPathPotential( false );
+    bool concurrentQuantumAndThermal( false );
+    unsigned int adaptiveAccuracyRefinements( 0 );
+    double adaptiveAccuracyMargin( 5.0 );
+    double adaptiveAccuracyTimeBudget( 0.0 );
 
     LHPC::RestrictedXmlParser xmlParser;
     xmlParser.LoadString( constructorArguments );
@@ -884,6 +1105,21 @@ namespace VevaciousPlusPlus
       InterpretElementIfNameMatches( xmlParser,
                                      "MinimumVacuumSeparationFraction",
                                      vacuumSeparationFraction );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "SmoothPathPotential",
+                                     smoothPathPotential );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "ConcurrentQuantumAndThermal",
+                                     concurrentQuantumAndThermal );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "AdaptiveAccuracyRefinements",
+                                     adaptiveAccuracyRefinements );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "AdaptiveAccuracyMargin",
+                                     adaptiveAccuracyMargin );
+      InterpretElementIfNameMatches( xmlParser,
+                                     "AdaptiveAccuracyTimeBudget",
+                                     adaptiveAccuracyTimeBudget );
       ReadClassAndArguments( xmlParser,
                              "BouncePotentialFit",
                              bouncePotentialFitClass,
@@ -910,15 +1146,49 @@ namespace VevaciousPlusPlus
                        CreateBounceActionCalculator( bouncePotentialFitClass,
                                                bouncePotentialFitArguments ) ) );
 
-    return Utils::make_unique<BounceAlongPathWithThreshold>( std::move(pathFinders),
+    TunnelingCalculator::TunnelingStrategy const
+    strategyEnum( InterpretTunnelingStrategy( tunnelingStrategy ) );
+    std::unique_ptr<BounceAlongPathWithThreshold>
+    bounceAlongPath( Utils::make_unique<BounceAlongPathWithThreshold>(
+                                                      std::move(pathFinders),
                                              std::move(bounceActionCalculator),
-                               InterpretTunnelingStrategy( tunnelingStrategy ),
-                                             survivalProbabilityThreshold,
-                                             thermalIntegrationResolution,
-                                             temperatureAccuracy,
-                                             resolutionOfPathPotential,
-                                             pathFindingTimeout,
-                                             vacuumSeparationFraction );
+                                                                 strategyEnum,
+                                                  survivalProbabilityThreshold,
+                                                  thermalIntegrationResolution,
+                                                           temperatureAccuracy,
+                                                     resolutionOfPathPotential,
+                                                            pathFindingTimeout,
+                                                      vacuumSeparationFraction,
+                                                       smoothPathPotential ) );
+    bounceAlongPath->SetAdaptiveAccuracy( adaptiveAccuracyRefinements,
+                                          adaptiveAccuracyMargin,
+                                          adaptiveAccuracyTimeBudget );
+
+    // The thermal tunneling calculation which runs alongside the quantum one
+    // gets its own path finders and bounce action calculator, so that the two
+    // share nothing but the potential and the vacua.
+    if( concurrentQuantumAndThermal
+        &&
+        ( ( strategyEnum == TunnelingCalculator::QuantumThenThermal )
+          ||
+          ( strategyEnum == TunnelingCalculator::ThermalThenQuantum ) ) )
+    {
+      bounceAlongPath->SetConcurrentThermalTunneler(
+                            Utils::make_unique<BounceAlongPathWithThreshold>(
+                                   CreateBouncePathFinders( tunnelPathFinders ),
+                                 CreateBounceActionCalculator(
+                                                       bouncePotentialFitClass,
+                                               bouncePotentialFitArguments ),
+                                             TunnelingCalculator::JustThermal,
+                                                  survivalProbabilityThreshold,
+                                                  thermalIntegrationResolution,
+                                                           temperatureAccuracy,
+                                                     resolutionOfPathPotential,
+                                                            pathFindingTimeout,
+                                                      vacuumSeparationFraction,
+                                                       smoothPathPotential ) );
+    }
+    return bounceAlongPath;
   }
 
   // This parses the XMl of tunnelPathFinders to construct a set of
@@ -1052,23 +1322,23 @@ namespace VevaciousPlusPlus
     if( potentialMinimizer->DsbVacuumIsMetastable() )
     {
       xmlBuilder
-      << potentialMinimizer->PanicVacuum().AsVevaciousXmlElement(
-                                                                 "PanicVacuum",
-                                                                  fieldNames )
+      << tunnelingPanicVacuum.AsVevaciousXmlElement( "PanicVacuum",
+                                                     fieldNames )
       << "\n";
-      if( tunnelingCalculator->QuantumSurvivalProbability() >= 0.0 )
+      TunnelingCalculator& tunnelingResults( TunnelingResults() );
+      if( tunnelingResults.QuantumSurvivalProbability() >= 0.0 )
       {
         xmlBuilder << "  <ZeroTemperatureDsbSurvival>\n"
         << "    <DsbSurvivalProbability>\n"
-        << "      " << tunnelingCalculator->QuantumSurvivalProbability()
+        << "      " << tunnelingResults.QuantumSurvivalProbability()
         << "\n"
         << "    </DsbSurvivalProbability>\n"
         << "    <LogOfMinusLogOfDsbSurvival>\n"
-        << "      " << tunnelingCalculator->LogOfMinusLogOfQuantumProbability()
+        << "      " << tunnelingResults.LogOfMinusLogOfQuantumProbability()
         << " <!-- this = ln(-ln(P)), so P = e^(-e^this)) -->\n"
         << "    </LogOfMinusLogOfDsbSurvival>\n"
         << "    <DsbLifetime>\n"
-        << "      " << tunnelingCalculator->QuantumLifetimeInSeconds()
+        << "      " << tunnelingResults.QuantumLifetimeInSeconds()
         << " <!-- in seconds; age of observed Universe is 4.3E+17s -->\n"
         << "    </DsbLifetime>\n"
         "  </ZeroTemperatureDsbSurvival>\n";
@@ -1078,20 +1348,20 @@ namespace VevaciousPlusPlus
         xmlBuilder << "  <!-- Survival probability at zero temperature not"
         << " calculated. -->\n";
       }
-      if( tunnelingCalculator->ThermalSurvivalProbability() >= 0.0 )
+      if( tunnelingResults.ThermalSurvivalProbability() >= 0.0 )
       {
         xmlBuilder << "  <NonZeroTemperatureDsbSurvival>\n"
         << "    <DsbSurvivalProbability>\n"
-        << "      " << tunnelingCalculator->ThermalSurvivalProbability()
+        << "      " << tunnelingResults.ThermalSurvivalProbability()
         << "\n"
         << "    </DsbSurvivalProbability>\n"
         << "    <LogOfMinusLogOfDsbSurvival>\n"
-        << "      " << tunnelingCalculator->LogOfMinusLogOfThermalProbability()
+        << "      " << tunnelingResults.LogOfMinusLogOfThermalProbability()
         << " <!-- this = ln(-ln(P)), so P = e^(-e^this)) --> \n"
         << "    </LogOfMinusLogOfDsbSurvival>\n"
         << "    <DominantTunnelingTemperature>\n"
         << "      "
-        << tunnelingCalculator->DominantTemperatureInGigaElectronVolts()
+        << tunnelingResults.DominantTemperatureInGigaElectronVolts()
         << " <!-- in GeV -->\n"
         << "    </DominantTunnelingTemperature>\n"
         << "  </NonZeroTemperatureDsbSurvival>\n";
@@ -1101,6 +1371,14 @@ namespace VevaciousPlusPlus
         xmlBuilder << "  <!-- Survival probability at non-zero temperatures"
         << " not calculated. -->\n";
       }
+      if( tunnelingResults.LogOfMinusLogOfSurvivalUncertainty() >= 0.0 )
+      {
+        xmlBuilder << "  <LogOfMinusLogOfDsbSurvivalUncertainty>\n"
+        << "    "
+        << tunnelingResults.LogOfMinusLogOfSurvivalUncertainty()
+        << " <!-- estimated from the resolutions which were used -->\n"
+        << "  </LogOfMinusLogOfDsbSurvivalUncertainty>\n";
+      }
     }
     xmlBuilder << "  <WarningMessages>";
     std::vector< std::string > const
@@ -1127,4 +1405,176 @@ namespace VevaciousPlusPlus
     resultsFromLastRunAsXml.assign( xmlBuilder.str() );
   }
 
+  // This calculates tunneling from the DSB vacuum to each deeper minimum
+  // found by potentialMinimizer concurrently, each with its own element of
+  // panicVacuumCalculators, which are created from
+  // tunnelingCalculatorInitializationFilename the first time that they are
+  // needed and then kept for later parameter points. As soon as one of them
+  // gives a survival probability below the threshold, the point is excluded,
+  // so the calculations which are still running are abandoned and those
+  // which have not yet started are skipped. The progress messages of each
+  // calculation are collected while it runs and then printed in the order of
+  // the deeper minima. The deeper minimum with the lowest survival
+  // probability is put into tunnelingPanicVacuum and panicVacuumResults is
+  // pointed at its TunnelingCalculator, leaving tunnelingCalculator as it
+  // was. It returns false without calculating anything if there are no
+  // deeper minima or if the TunnelingCalculator cannot be duplicated for
+  // concurrent calculations.
+  bool VevaciousPlusPlus::CalculateTunnelingToEveryPanicVacuum()
+  {
+    std::vector< PotentialMinimum > const&
+    panicVacua( potentialMinimizer->PanicVacua() );
+    size_t const numberOfPanicVacua( panicVacua.size() );
+    if( numberOfPanicVacua == 0 )
+    {
+      return false;
+    }
+
+    // CosmoTransitionsRunner communicates with its Python process through
+    // fixed file names, so only BounceAlongPathWithThreshold instances are
+    // run concurrently.
+    if( tunnelingCalculatorInitializationFilename.empty()
+        ||
+        ( dynamic_cast< BounceAlongPathWithThreshold* >(
+                                       &(GetTunnelingCalculator()) ) == NULL ) )
+    {
+      WarningLogger::LogWarning( "Tunneling to every panic vacuum needs a"
+      " BounceAlongPathWithThreshold created from an initialization file, so"
+      " only tunneling to the single chosen panic vacuum is calculated." );
+      return false;
+    }
+
+    // Reading the initialization file and building the path finders and
+    // bounce action calculators is only done for panic vacua beyond the
+    // number that earlier parameter points had.
+    while( panicVacuumCalculators.size() < numberOfPanicVacua )
+    {
+      panicVacuumCalculators.push_back( CreateTunnelingCalculator(
+                                 tunnelingCalculatorInitializationFilename ) );
+    }
+
+    std::atomic< bool > pointIsExcluded( false );
+    std::vector< std::stringstream > progressStreams( numberOfPanicVacua );
+    for( size_t vacuumIndex( 0 );
+         vacuumIndex < numberOfPanicVacua;
+         ++vacuumIndex )
+    {
+      TunnelingCalculator&
+      vacuumCalculator( *(panicVacuumCalculators[ vacuumIndex ]) );
+      dynamic_cast< BounceActionTunneler& >( vacuumCalculator
+                                      ).SetCancellationFlag( &pointIsExcluded );
+      vacuumCalculator.SetProgressStream( progressStreams[ vacuumIndex ] );
+    }
+
+    size_t numberOfThreads( numberOfPanicVacua );
+    if( ( numberOfTunnelingThreads > 0 )
+        &&
+        ( numberOfTunnelingThreads < numberOfPanicVacua ) )
+    {
+      numberOfThreads = numberOfTunnelingThreads;
+    }
+    std::cout
+    << std::endl
+    << "Calculating tunneling to " << numberOfPanicVacua
+    << " panic vacua on " << numberOfThreads << " threads.";
+    std::cout << std::endl;
+
+    TaskGroup
+    tunnelingTasks( static_cast< unsigned int >( numberOfThreads ) );
+    std::vector< std::future< bool > > tunnelingResults;
+    for( size_t vacuumIndex( 0 );
+         vacuumIndex < numberOfPanicVacua;
+         ++vacuumIndex )
+    {
+      tunnelingResults.push_back( tunnelingTasks.Submit( std::bind(
+                                       &VevaciousPlusPlus::TunnelToPanicVacuum,
+                                                                        this,
+                          std::ref( *(panicVacuumCalculators[ vacuumIndex ]) ),
+                                        std::cref( panicVacua[ vacuumIndex ] ),
+                                              std::ref( pointIsExcluded ) ) ) );
+    }
+    tunnelingTasks.RunAll();
+
+    // The calculators are set back to their defaults before any exception
+    // from a calculation is thrown again, as pointIsExcluded and
+    // progressStreams do not outlive this function.
+    for( size_t vacuumIndex( 0 );
+         vacuumIndex < numberOfPanicVacua;
+         ++vacuumIndex )
+    {
+      TunnelingCalculator&
+      vacuumCalculator( *(panicVacuumCalculators[ vacuumIndex ]) );
+      dynamic_cast< BounceActionTunneler& >( vacuumCalculator
+                                                 ).SetCancellationFlag( NULL );
+      vacuumCalculator.SetProgressStream( std::cout );
+    }
+
+    // The deeper minimum with the fastest decay is reported. Calculations
+    // which were skipped still hold the results of an earlier parameter
+    // point, so they are never chosen. Any exception thrown by a calculation
+    // is thrown again by its future, after the progress messages up to that
+    // calculation have been printed.
+    size_t fastestDecayIndex( 0 );
+    bool decayWasCalculated( false );
+    for( size_t vacuumIndex( 0 );
+         vacuumIndex < numberOfPanicVacua;
+         ++vacuumIndex )
+    {
+      std::cout << progressStreams[ vacuumIndex ].str();
+      if( tunnelingResults[ vacuumIndex ].get()
+          &&
+          ( !decayWasCalculated
+            ||
+            ( panicVacuumCalculators[ vacuumIndex ]->LogOfMinusLogOfSurvival()
+              > panicVacuumCalculators[ fastestDecayIndex
+                                       ]->LogOfMinusLogOfSurvival() ) ) )
+      {
+        fastestDecayIndex = vacuumIndex;
+        decayWasCalculated = true;
+      }
+    }
+    panicVacuumResults = panicVacuumCalculators[ fastestDecayIndex ].get();
+    tunnelingPanicVacuum = panicVacua[ fastestDecayIndex ];
+    std::cout
+    << std::endl
+    << "Fastest decay of the DSB vacuum was to panic vacuum "
+    << ( fastestDecayIndex + 1 ) << " of " << numberOfPanicVacua;
+    if( pointIsExcluded.load() )
+    {
+      std::cout << ", which excluded the point";
+    }
+    std::cout << ".";
+    std::cout << std::endl;
+    return true;
+  }
+
+  // This calculates tunneling from the DSB vacuum to panicVacuum with
+  // vacuumCalculator unless pointIsExcluded is already true, and sets
+  // pointIsExcluded to true if the survival probability is below the
+  // threshold. It returns false if the calculation was skipped. The cache of
+  // potential values bypasses itself within the concurrent tasks, as it is
+  // not safe to share between threads.
+  bool VevaciousPlusPlus::TunnelToPanicVacuum(
+                                        TunnelingCalculator& vacuumCalculator,
+                                          PotentialMinimum const& panicVacuum,
+                                  std::atomic< bool >& pointIsExcluded ) const
+  {
+    if( pointIsExcluded.load() )
+    {
+      return false;
+    }
+    vacuumCalculator.CalculateTunneling(
+                                   potentialMinimizer->GetPotentialFunction(),
+                                         potentialMinimizer->DsbVacuum(),
+                                         panicVacuum );
+    // A survival probability P below the threshold P_t is equivalent to
+    // ln(-ln(P)) being above ln(-ln(P_t)).
+    if( vacuumCalculator.LogOfMinusLogOfSurvival()
+        > log( -log( vacuumCalculator.SurvivalProbabilityThreshold() ) ) )
+    {
+      pointIsExcluded.store( true );
+    }
+    return true;
+  }
+
 } /* namespace VevaciousPlusPlus */
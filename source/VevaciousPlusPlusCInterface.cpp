@@ -0,0 +1,514 @@
+/*
+ * VevaciousPlusPlusCInterface.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent (agent@local)
+ */
+
+#include "VevaciousPlusPlusCInterface.h"
+#include "VevaciousPlusPlus.hpp"
+#include "PotentialEvaluation/PotentialFunction.hpp"
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <limits>
+#include <exception>
+#include <stdexcept>
+#include <sstream>
+
+// This holds a VevaciousPlusPlus instance along with the buffers used to pass
+// arrays to and from its potential, which are kept between calls so that
+// repeated batch evaluations do not have to allocate them again.
+struct VevaciousPlusPlusHandle
+{
+  VevaciousPlusPlusHandle( std::string const& initializationFilename ) :
+    vevaciousPlusPlus( initializationFilename ),
+    fieldConfigurations(),
+    potentialValues(),
+    gradientVector(),
+    differenceConfigurations(),
+    differenceIndices() {}
+
+  VevaciousPlusPlus::VevaciousPlusPlus vevaciousPlusPlus;
+  std::vector< std::vector< double > > fieldConfigurations;
+  std::vector< double > potentialValues;
+  std::vector< double > gradientVector;
+  std::vector< std::vector< double > > differenceConfigurations;
+  std::vector< size_t > differenceIndices;
+};
+
+namespace
+{
+  // This is the message of the last failure on each thread.
+  thread_local std::string lastErrorMessage( "" );
+
+  // This is the message recorded for anything thrown which was not derived
+  // from std::exception.
+  char const* const unknownExceptionMessage( "Unknown exception thrown." );
+
+  // This is the step in GeV for the central differences of the gradient if
+  // the potential does not provide it exactly.
+  double const numericalStepSize( 1.0 );
+
+  // This records failureMessage as the message of the last failure and
+  // returns -1 to be returned in turn by the interface function.
+  int RecordFailure( std::string const& failureMessage )
+  {
+    lastErrorMessage.assign( failureMessage );
+    return -1;
+  }
+
+  // This throws an exception if vevaciousHandle is NULL.
+  void CheckHandle( VevaciousPlusPlusHandle const* vevaciousHandle )
+  {
+    if( vevaciousHandle == NULL )
+    {
+      throw std::runtime_error( "The VevaciousPlusPlus handle was NULL." );
+    }
+  }
+
+  // This copies the numberOfConfigurations consecutive blocks of field values
+  // in fieldConfigurations into the fieldConfigurations buffer of
+  // vevaciousHandle.
+  void FillFieldConfigurations( VevaciousPlusPlusHandle& vevaciousHandle,
+                                double const* fieldConfigurations,
+                                int const numberOfConfigurations )
+  {
+    if( ( numberOfConfigurations < 0 )
+        ||
+        ( ( numberOfConfigurations > 0 )
+          &&
+          ( fieldConfigurations == NULL ) ) )
+    {
+      std::stringstream errorBuilder;
+      errorBuilder << "Invalid array of " << numberOfConfigurations
+      << " field configurations.";
+      throw std::runtime_error( errorBuilder.str() );
+    }
+    size_t const numberOfFields( vevaciousHandle.vevaciousPlusPlus.
+                              GetPotentialFunction().NumberOfFieldVariables() );
+    vevaciousHandle.fieldConfigurations.resize( numberOfConfigurations );
+    for( int configurationIndex( 0 );
+         configurationIndex < numberOfConfigurations;
+         ++configurationIndex )
+    {
+      double const* const
+      configurationStart( fieldConfigurations
+                          + ( configurationIndex * numberOfFields ) );
+      vevaciousHandle.fieldConfigurations[ configurationIndex ].assign(
+                                                            configurationStart,
+                                   ( configurationStart + numberOfFields ) );
+    }
+  }
+
+  // This copies fieldValues into fieldArray, which must have space for the
+  // number of fields of the potential, or fills fieldArray with NaN if
+  // fieldValues does not have that many elements.
+  void CopyFieldValues( std::vector< double > const& fieldValues,
+                        size_t const numberOfFields,
+                        double* fieldArray )
+  {
+    for( size_t fieldIndex( 0 );
+         fieldIndex < numberOfFields;
+         ++fieldIndex )
+    {
+      fieldArray[ fieldIndex ] = ( ( fieldValues.size() == numberOfFields ) ?
+                                   fieldValues[ fieldIndex ] :
+                              std::numeric_limits< double >::quiet_NaN() );
+    }
+  }
+}
+
+extern "C"
+{
+
+  // This returns the version of this interface.
+  int VevaciousPlusPlus_InterfaceVersion( void )
+  {
+    return 1;
+  }
+
+  // This returns the message of the last failure on the calling thread, or an
+  // empty string if there has not been one.
+  char const* VevaciousPlusPlus_LastErrorMessage( void )
+  {
+    return lastErrorMessage.c_str();
+  }
+
+  // This creates a VevaciousPlusPlus instance from the initialization file
+  // with name initializationFilename and returns a handle to it, or NULL on
+  // failure.
+  VevaciousPlusPlusHandle*
+  VevaciousPlusPlus_Create( char const* initializationFilename )
+  {
+    try
+    {
+      if( initializationFilename == NULL )
+      {
+        throw std::runtime_error( "The initialization file name was NULL." );
+      }
+      return new VevaciousPlusPlusHandle( initializationFilename );
+    }
+    catch( std::exception const& thrownException )
+    {
+      RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      RecordFailure( unknownExceptionMessage );
+    }
+    return NULL;
+  }
+
+  // This deletes the instance created by VevaciousPlusPlus_Create.
+  void VevaciousPlusPlus_Destroy( VevaciousPlusPlusHandle* vevaciousHandle )
+  {
+    delete vevaciousHandle;
+  }
+
+  // This returns the number of field variables of the potential, or -1 on
+  // failure.
+  int
+  VevaciousPlusPlus_NumberOfFields( VevaciousPlusPlusHandle* vevaciousHandle )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      return static_cast< int >( vevaciousHandle->vevaciousPlusPlus.
+                              GetPotentialFunction().NumberOfFieldVariables() );
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This returns the name of the field with index fieldIndex, or NULL on
+  // failure.
+  char const*
+  VevaciousPlusPlus_FieldName( VevaciousPlusPlusHandle* vevaciousHandle,
+                               int fieldIndex )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      std::vector< std::string > const& fieldNames(
+           vevaciousHandle->vevaciousPlusPlus.GetPotentialFunction(
+                                                              ).FieldNames() );
+      if( ( fieldIndex < 0 )
+          ||
+          ( static_cast< size_t >( fieldIndex ) >= fieldNames.size() ) )
+      {
+        std::stringstream errorBuilder;
+        errorBuilder << "There is no field with index " << fieldIndex << ".";
+        throw std::runtime_error( errorBuilder.str() );
+      }
+      return fieldNames[ fieldIndex ].c_str();
+    }
+    catch( std::exception const& thrownException )
+    {
+      RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      RecordFailure( unknownExceptionMessage );
+    }
+    return NULL;
+  }
+
+  // This gives an SLHA block to the Lagrangian parameter manager from memory,
+  // as VevaciousPlusPlus::ReadLhaBlock does.
+  int VevaciousPlusPlus_ReadLhaBlock( VevaciousPlusPlusHandle* vevaciousHandle,
+                                      char const* uppercaseBlockName,
+                                      double scale,
+                                      int const* entryIndices,
+                                      double const* entryValues,
+                                      int numberOfEntries,
+                                      int dimension )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      if( ( uppercaseBlockName == NULL )
+          ||
+          ( numberOfEntries < 0 )
+          ||
+          ( ( numberOfEntries > 0 )
+            &&
+            ( ( entryIndices == NULL )
+              ||
+              ( entryValues == NULL ) ) ) )
+      {
+        throw std::runtime_error( "Invalid block given to ReadLhaBlock." );
+      }
+      std::vector< std::pair< int, double > > blockEntries;
+      blockEntries.reserve( numberOfEntries );
+      for( int entryIndex( 0 );
+           entryIndex < numberOfEntries;
+           ++entryIndex )
+      {
+        blockEntries.push_back( std::make_pair( entryIndices[ entryIndex ],
+                                              entryValues[ entryIndex ] ) );
+      }
+      vevaciousHandle->vevaciousPlusPlus.ReadLhaBlock( uppercaseBlockName,
+                                                       scale,
+                                                       blockEntries,
+                                                       dimension );
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This sets the parameter point given by newInput without finding minima
+  // or calculating tunneling.
+  int
+  VevaciousPlusPlus_NewParameterPoint( VevaciousPlusPlusHandle* vevaciousHandle,
+                                       char const* newInput )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      if( newInput == NULL )
+      {
+        throw std::runtime_error( "The parameter point input was NULL." );
+      }
+      vevaciousHandle->vevaciousPlusPlus.NewParameterPoint( newInput );
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This clears the blocks given by VevaciousPlusPlus_ReadLhaBlock.
+  int VevaciousPlusPlus_ClearParameterPoint(
+                                     VevaciousPlusPlusHandle* vevaciousHandle )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      vevaciousHandle->vevaciousPlusPlus.ClearParameterPoint();
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This puts the value of the potential at temperatureValue for each of the
+  // numberOfConfigurations field configurations in fieldConfigurations into
+  // the corresponding element of potentialValues, through a single call of
+  // PotentialFunction::EvaluateBatch.
+  int VevaciousPlusPlus_EvaluatePotential(
+                                      VevaciousPlusPlusHandle* vevaciousHandle,
+                                         double const* fieldConfigurations,
+                                         int numberOfConfigurations,
+                                         double temperatureValue,
+                                         double* potentialValues )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      if( ( numberOfConfigurations > 0 )
+          &&
+          ( potentialValues == NULL ) )
+      {
+        throw std::runtime_error( "The array for the potential values was"
+                                  " NULL." );
+      }
+      FillFieldConfigurations( *vevaciousHandle,
+                               fieldConfigurations,
+                               numberOfConfigurations );
+      vevaciousHandle->vevaciousPlusPlus.GetPotentialFunction().EvaluateBatch(
+                                          vevaciousHandle->fieldConfigurations,
+                                              vevaciousHandle->potentialValues,
+                                                            temperatureValue );
+      for( int configurationIndex( 0 );
+           configurationIndex < numberOfConfigurations;
+           ++configurationIndex )
+      {
+        potentialValues[ configurationIndex ]
+        = vevaciousHandle->potentialValues[ configurationIndex ];
+      }
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This puts the gradient of the potential at temperatureValue for each of
+  // the numberOfConfigurations field configurations in fieldConfigurations
+  // into gradientVectors. The gradient is exact where the potential provides
+  // it, and otherwise the displaced configurations for the central
+  // differences of all the configurations which need them are evaluated
+  // through a single call of PotentialFunction::EvaluateBatch.
+  int VevaciousPlusPlus_EvaluateGradients(
+                                      VevaciousPlusPlusHandle* vevaciousHandle,
+                                         double const* fieldConfigurations,
+                                         int numberOfConfigurations,
+                                         double temperatureValue,
+                                         double* gradientVectors )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      if( ( numberOfConfigurations > 0 )
+          &&
+          ( gradientVectors == NULL ) )
+      {
+        throw std::runtime_error( "The array for the gradients was NULL." );
+      }
+      FillFieldConfigurations( *vevaciousHandle,
+                               fieldConfigurations,
+                               numberOfConfigurations );
+      VevaciousPlusPlus::PotentialFunction const&
+      potentialFunction( vevaciousHandle->vevaciousPlusPlus.
+                                                      GetPotentialFunction() );
+      size_t const numberOfFields( potentialFunction.NumberOfFieldVariables() );
+      std::vector< double >& gradientVector( vevaciousHandle->gradientVector );
+      std::vector< std::vector< double > >&
+      differenceConfigurations( vevaciousHandle->differenceConfigurations );
+      std::vector< size_t >&
+      differenceIndices( vevaciousHandle->differenceIndices );
+      differenceConfigurations.clear();
+      differenceIndices.clear();
+      for( int configurationIndex( 0 );
+           configurationIndex < numberOfConfigurations;
+           ++configurationIndex )
+      {
+        std::vector< double > const& fieldConfiguration(
+                  vevaciousHandle->fieldConfigurations[ configurationIndex ] );
+        if( potentialFunction.SetAsExactGradientAt( gradientVector,
+                                                    fieldConfiguration,
+                                                    temperatureValue ) )
+        {
+          CopyFieldValues( gradientVector,
+                           numberOfFields,
+                           ( gradientVectors
+                             + ( configurationIndex * numberOfFields ) ) );
+          continue;
+        }
+        differenceIndices.push_back( configurationIndex );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          differenceConfigurations.push_back( fieldConfiguration );
+          differenceConfigurations.back()[ fieldIndex ] += numericalStepSize;
+          differenceConfigurations.push_back( fieldConfiguration );
+          differenceConfigurations.back()[ fieldIndex ] -= numericalStepSize;
+        }
+      }
+      if( differenceIndices.empty() )
+      {
+        return 0;
+      }
+
+      std::vector< double >&
+      differenceValues( vevaciousHandle->potentialValues );
+      potentialFunction.EvaluateBatch( differenceConfigurations,
+                                       differenceValues,
+                                       temperatureValue );
+      for( size_t differenceIndex( 0 );
+           differenceIndex < differenceIndices.size();
+           ++differenceIndex )
+      {
+        double* const
+        gradientStart( gradientVectors
+                       + ( differenceIndices[ differenceIndex ]
+                           * numberOfFields ) );
+        for( size_t fieldIndex( 0 );
+             fieldIndex < numberOfFields;
+             ++fieldIndex )
+        {
+          size_t const valueIndex( 2 * ( ( differenceIndex * numberOfFields )
+                                         + fieldIndex ) );
+          gradientStart[ fieldIndex ]
+          = ( ( differenceValues[ valueIndex ]
+                - differenceValues[ valueIndex + 1 ] )
+              / ( 2.0 * numericalStepSize ) );
+        }
+      }
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+  // This finds the minima of the potential for the parameter point given by
+  // newInput, as VevaciousPlusPlus::RunVacua does, and puts the field values
+  // of the global minimum into globalMinimum and those of the deeper minimum
+  // nearest to the DSB minimum into nearestMinimum.
+  int VevaciousPlusPlus_FindMinima( VevaciousPlusPlusHandle* vevaciousHandle,
+                                    char const* newInput,
+                                    double* globalMinimum,
+                                    double* nearestMinimum )
+  {
+    try
+    {
+      CheckHandle( vevaciousHandle );
+      if( ( newInput == NULL )
+          ||
+          ( globalMinimum == NULL )
+          ||
+          ( nearestMinimum == NULL ) )
+      {
+        throw std::runtime_error( "NULL argument given to FindMinima." );
+      }
+      std::pair< std::vector< double >, std::vector< double > > const
+      panicVacua( vevaciousHandle->vevaciousPlusPlus.RunVacua( newInput ) );
+      size_t const numberOfFields( vevaciousHandle->vevaciousPlusPlus.
+                              GetPotentialFunction().NumberOfFieldVariables() );
+      CopyFieldValues( panicVacua.first,
+                       numberOfFields,
+                       globalMinimum );
+      CopyFieldValues( panicVacua.second,
+                       numberOfFields,
+                       nearestMinimum );
+      return 0;
+    }
+    catch( std::exception const& thrownException )
+    {
+      return RecordFailure( thrownException.what() );
+    }
+    catch( ... )
+    {
+      return RecordFailure( unknownExceptionMessage );
+    }
+  }
+
+}